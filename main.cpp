@@ -1,21 +1,59 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <map>
+#include <set>
+#include <deque>
+#include <list>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <chrono>
-#include <regex>
 #include <iomanip>
 #include <functional>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <array>
 #include <thread>
+#include <condition_variable>
+#include <ctime>
 #include <exception>
 #include <optional>
+#include <tuple>
 #include <limits>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <charconv>
+#include <iterator>
+#include <numeric>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
 
 // ==================== UTILITIES & EXCEPTIONS ====================
 
@@ -28,1842 +66,10295 @@ public:
 };
 
 class Logger {
-private:
-    static std::mutex log_mutex;
-    static std::ofstream log_file;
-
 public:
     enum Level { DEBUG, INFO, WARNING, ERROR, CRITICAL };
+    enum Mode { SYNCHRONOUS, ASYNCHRONOUS };
 
-    static void init(const std::string& filename = "employee_system.log") {
-        std::lock_guard<std::mutex> lock(log_mutex);
-        if (!log_file.is_open()) {
-            log_file.open(filename, std::ios::app);
+private:
+    struct Entry {
+        Level level = INFO;
+        std::time_t time = 0;
+        std::string message;
+    };
+
+    // Bounded lock-free multi-producer/single-consumer queue (Vyukov). Each cell's
+    // sequence number says whether it is free for the producer at that position or
+    // holds an entry for the consumer.
+    class EntryRing {
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            Entry entry;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        std::atomic<size_t> enqueue_pos{0};
+        size_t dequeue_pos = 0;  // consumer only
+
+    public:
+        explicit EntryRing(size_t capacity) : cells(new Cell[capacity]), mask(capacity - 1) {
+            for (size_t i = 0; i < capacity; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
         }
-    }
 
-    static void log(Level level, const std::string& message) {
-        std::lock_guard<std::mutex> lock(log_mutex);
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
+        // Leaves entry untouched and returns false when the ring is full
+        bool push(Entry& entry) {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[pos & mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->entry = std::move(entry);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
 
-        std::string level_str[] = {"DEBUG", "INFO", "WARN", "ERROR", "CRITICAL"};
+        bool pop(Entry& entry) {
+            Cell& cell = cells[dequeue_pos & mask];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) return false;
+            entry = std::move(cell.entry);
+            cell.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+            ++dequeue_pos;
+            return true;
+        }
+    };
 
-        if (log_file.is_open()) {
-            log_file << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S")
-                     << " [" << level_str[level] << "] " << message << std::endl;
+    // localtime formatting is only redone when the second changes
+    class TimestampCache {
+    private:
+        std::time_t cached = -1;
+        char text[20] = {};
+
+    public:
+        const char* format(std::time_t time) {
+            if (time != cached) {
+                std::tm tm_info{};
+#ifdef _WIN32
+                localtime_s(&tm_info, &time);
+#else
+                localtime_r(&time, &tm_info);
+#endif
+                std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &tm_info);
+                cached = time;
+            }
+            return text;
+        }
+    };
+
+    // Producers only enqueue; the writer thread formats, batches and flushes once
+    // per batch, so callers never wait on the disk
+    class AsyncWriter {
+    private:
+        static constexpr size_t RING_CAPACITY = 8192;
+        static constexpr size_t MAX_BATCH = 1024;
+
+        EntryRing ring{RING_CAPACITY};
+        std::atomic<bool> running{true};
+        std::atomic<bool> sleeping{false};
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> written{0};
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        std::thread thread;
+
+        void run() {
+            TimestampCache clock;
+            std::string batch;
+            Entry entry;
+
+            while (true) {
+                bool stopping = !running.load(std::memory_order_acquire);
+                size_t drained = 0;
+                while (drained < MAX_BATCH && ring.pop(entry)) {
+                    batch.append(clock.format(entry.time)).append(" [")
+                         .append(level_name(entry.level)).append("] ")
+                         .append(entry.message).push_back('\n');
+                    ++drained;
+                }
+
+                if (drained > 0) {
+                    {
+                        std::lock_guard<std::mutex> lock(log_mutex);
+                        if (log_file.is_open()) {
+                            log_file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                            log_file.flush();
+                        }
+                    }
+                    batch.clear();
+                    written.fetch_add(drained, std::memory_order_release);
+                    continue;
+                }
+
+                if (stopping) break;
+
+                // A notify that races with going to sleep costs at most one timeout
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                sleeping.store(true, std::memory_order_relaxed);
+                wake.wait_for(lock, std::chrono::milliseconds(50));
+                sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        AsyncWriter() : thread([this] { run(); }) {}
+
+        ~AsyncWriter() {
+            running.store(false, std::memory_order_release);
+            wake.notify_one();
+            thread.join();
+        }
+
+        void push(Entry entry) {
+            while (!ring.push(entry)) {
+                // Full: let the writer catch up rather than drop audit lines
+                wake.notify_one();
+                std::this_thread::yield();
+            }
+            enqueued.fetch_add(1, std::memory_order_relaxed);
+            if (sleeping.load(std::memory_order_relaxed)) wake.notify_one();
+        }
+
+        void flush() {
+            uint64_t target = enqueued.load(std::memory_order_relaxed);
+            while (written.load(std::memory_order_acquire) < target) {
+                wake.notify_one();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
         }
+    };
+
+    static std::mutex log_mutex;
+    static std::ofstream log_file;
+    static std::atomic<int> min_level;
+    static TimestampCache sync_clock;
+    static std::unique_ptr<AsyncWriter> async_writer;
+    static std::atomic<AsyncWriter*> active_writer;
+
+    static const char* level_name(Level level) {
+        static const char* const names[] = {"DEBUG", "INFO", "WARN", "ERROR", "CRITICAL"};
+        return names[level];
+    }
+
+    static void write(Level level, std::string&& message) {
+        std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
         // Also output to console for errors and critical
         if (level >= ERROR) {
-            std::cerr << "[" << level_str[level] << "] " << message << std::endl;
+            std::lock_guard<std::mutex> lock(log_mutex);
+            std::cerr << "[" << level_name(level) << "] " << message << std::endl;
         }
+
+        if (AsyncWriter* writer = active_writer.load(std::memory_order_acquire)) {
+            writer->push(Entry{level, now, std::move(message)});
+            if (level == CRITICAL) writer->flush();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(log_mutex);
+        if (log_file.is_open()) {
+            log_file << sync_clock.format(now) << " [" << level_name(level) << "] " << message << '\n';
+            log_file.flush();
+        }
+    }
+
+public:
+    // ASYNCHRONOUS starts the background writer; init() and shutdown() must not race
+    // with log() calls from other threads
+    static void init(const std::string& filename = "employee_system.log", Mode mode = SYNCHRONOUS) {
+        {
+            std::lock_guard<std::mutex> lock(log_mutex);
+            if (!log_file.is_open()) {
+                log_file.open(filename, std::ios::app);
+            }
+        }
+        if (mode == ASYNCHRONOUS && !async_writer) {
+            async_writer = std::make_unique<AsyncWriter>();
+            active_writer.store(async_writer.get(), std::memory_order_release);
+        }
+    }
+
+    // Drains pending entries and stops the background writer, if any
+    static void shutdown() {
+        active_writer.store(nullptr, std::memory_order_release);
+        async_writer.reset();
+    }
+
+    static void flush() {
+        if (AsyncWriter* writer = active_writer.load(std::memory_order_acquire)) writer->flush();
+    }
+
+    static void set_level(Level level) { min_level.store(level, std::memory_order_relaxed); }
+
+    static bool enabled(Level level) { return level >= min_level.load(std::memory_order_relaxed); }
+
+    // Message parts are only concatenated once the level has passed the filter
+    template <typename... Parts>
+    static void log(Level level, const Parts&... parts) {
+        if (!enabled(level)) return;
+        std::string message;
+        (message.append(std::string_view(parts)), ...);
+        write(level, std::move(message));
     }
 };
 
 std::mutex Logger::log_mutex;
 std::ofstream Logger::log_file;
-
+std::atomic<int> Logger::min_level{Logger::DEBUG};
+Logger::TimestampCache Logger::sync_clock;
+// Defined after log_file so the writer drains into it during static destruction
+std::unique_ptr<Logger::AsyncWriter> Logger::async_writer;
+std::atomic<Logger::AsyncWriter*> Logger::active_writer{nullptr};
+
+// Hand-written checkers for the fixed field formats. Each one accepts exactly what
+// the regex in its comment accepts, without constructing a std::regex per call.
 class Validator {
-public:
-    static bool isValidID(const std::string& id) {
-        return std::regex_match(id, std::regex(R"([A-Z]{2}\d{4})"));  // Format: AB1234
+private:
+    static constexpr bool is_upper(char c) { return c >= 'A' && c <= 'Z'; }
+    static constexpr bool is_letter(char c) { return is_upper(c) || (c >= 'a' && c <= 'z'); }
+    static constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+    static constexpr bool is_alnum(char c) { return is_letter(c) || is_digit(c); }
+    static constexpr bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
     }
 
-    static bool isValidName(const std::string& name) {
-        return std::regex_match(name, std::regex(R"([A-Za-z\s'-]{2,50})"));
+    template <typename Predicate>
+    static constexpr bool all_of(std::string_view text, Predicate accept) {
+        for (char c : text) {
+            if (!accept(c)) return false;
+        }
+        return true;
     }
 
-    static bool isValidPosition(const std::string& position) {
-        return std::regex_match(position, std::regex(R"([A-Za-z\s-]{2,30})"));
+    static constexpr bool is_name_char(char c) { return is_letter(c) || is_space(c) || c == '\'' || c == '-'; }
+    static constexpr bool is_position_char(char c) { return is_letter(c) || is_space(c) || c == '-'; }
+    static constexpr bool is_local_char(char c) {
+        return is_alnum(c) || c == '.' || c == '_' || c == '%' || c == '+' || c == '-';
     }
+    static constexpr bool is_domain_char(char c) { return is_alnum(c) || c == '.' || c == '-'; }
 
-    static bool isValidSalary(double salary) {
-        return salary >= 0 && salary <= 10000000;  // Max 10M
+public:
+    static constexpr bool isValidID(std::string_view id) {
+        // [A-Z]{2}\d{4}  Format: AB1234
+        return id.size() == 6 && is_upper(id[0]) && is_upper(id[1]) &&
+               all_of(id.substr(2), is_digit);
     }
 
-    static bool isValidEmail(const std::string& email) {
-        return std::regex_match(email,
-            std::regex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})"));
+    static constexpr bool isValidName(std::string_view name) {
+        // [A-Za-z\s'-]{2,50}
+        return name.size() >= 2 && name.size() <= 50 && all_of(name, is_name_char);
     }
 
-    static bool isValidPhone(const std::string& phone) {
-        return std::regex_match(phone, std::regex(R"(\+?\d{10,15})"));
+    static constexpr bool isValidPosition(std::string_view position) {
+        // [A-Za-z\s-]{2,30}
+        return position.size() >= 2 && position.size() <= 30 && all_of(position, is_position_char);
     }
-};
 
-// ==================== ENHANCED EMPLOYEE STRUCTURE ====================
+    static constexpr bool isValidSalary(double salary) {
+        return salary >= 0 && salary <= 10000000;  // Max 10M
+    }
 
-enum class Department {
-    ENGINEERING, HR, FINANCE, MARKETING, OPERATIONS, SALES, UNKNOWN
-};
+    static constexpr bool isValidEmail(std::string_view email) {
+        // [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+        // '@' is outside both character classes, so it must be the only one; the
+        // letters-only suffix cannot contain '.', so it follows the last '.'
+        size_t at = email.find('@');
+        if (at == std::string_view::npos || at == 0) return false;
+        std::string_view local = email.substr(0, at);
+        std::string_view domain = email.substr(at + 1);
 
-enum class EmployeeStatus {
-    ACTIVE, INACTIVE, ON_LEAVE, TERMINATED
-};
+        size_t dot = domain.rfind('.');
+        if (dot == std::string_view::npos || dot == 0 || domain.size() - dot - 1 < 2) return false;
 
-enum class AccessLevel {
-    BASIC, ADMIN
+        return all_of(local, is_local_char) && all_of(domain, is_domain_char) &&
+               all_of(domain.substr(dot + 1), is_letter);
+    }
+
+    static constexpr bool isValidPhone(std::string_view phone) {
+        // \+?\d{10,15}
+        std::string_view digits = (!phone.empty() && phone[0] == '+') ? phone.substr(1) : phone;
+        return digits.size() >= 10 && digits.size() <= 15 && all_of(digits, is_digit);
+    }
 };
 
-struct Employee {
-    std::string id;
-    std::string firstName;
-    std::string lastName;
-    std::string position;
-    Department department;
-    double salary;
-    std::string email;
-    std::string phone;
-    std::chrono::system_clock::time_point hireDate;
-    EmployeeStatus status;
-    std::vector<std::string> skills;
-    std::string managerId;  // References another employee
-    AccessLevel accessLevel;
+static_assert(Validator::isValidID("XX0069") && !Validator::isValidID("xx0069"), "ID format");
+static_assert(Validator::isValidEmail("admin@example.com") && !Validator::isValidEmail("a@b.c"), "email format");
 
-    // Constructors
-    Employee() : salary(0), department(Department::UNKNOWN),
-                status(EmployeeStatus::ACTIVE),
-                hireDate(std::chrono::system_clock::now()),
-                accessLevel(AccessLevel::BASIC) {}
+// ASCII case folding and substring search that work on the caller's buffers; the
+// "C" locale tolower() the search used before folds exactly the same characters
+class TextMatcher {
+public:
+    static constexpr char fold(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+    }
 
-    Employee(const std::string& id, const std::string& firstName,
-             const std::string& lastName, const std::string& position,
-             Department dept, double salary, const std::string& email = "",
-             const std::string& phone = "", AccessLevel access = AccessLevel::BASIC)
-        : id(id), firstName(firstName), lastName(lastName), position(position),
-          department(dept), salary(salary), email(email), phone(phone),
-          status(EmployeeStatus::ACTIVE), hireDate(std::chrono::system_clock::now()),
-          accessLevel(access) {
+    static std::string fold_copy(std::string_view text) {
+        std::string folded(text);
+        for (char& c : folded) c = fold(c);
+        return folded;
+    }
 
-        validate();
+    // needle must already be folded
+    static bool contains_folded(std::string_view haystack, std::string_view needle) {
+        if (needle.empty()) return true;
+        if (needle.size() > haystack.size()) return false;
+
+        const char first = needle[0];
+        const size_t last_start = haystack.size() - needle.size();
+        for (size_t i = 0; i <= last_start; ++i) {
+            if (fold(haystack[i]) != first) continue;
+            size_t j = 1;
+            while (j < needle.size() && fold(haystack[i + j]) == needle[j]) ++j;
+            if (j == needle.size()) return true;
+        }
+        return false;
     }
 
-    void validate() const {
-        if (!Validator::isValidID(id))
-            throw EmployeeException("Invalid employee ID format");
-        if (!Validator::isValidName(firstName) || !Validator::isValidName(lastName))
-            throw EmployeeException("Invalid name format");
-        if (!Validator::isValidPosition(position))
-            throw EmployeeException("Invalid position format");
-        if (!Validator::isValidSalary(salary))
-            throw EmployeeException("Invalid salary range");
-        if (!email.empty() && !Validator::isValidEmail(email))
-            throw EmployeeException("Invalid email format");
-        if (!phone.empty() && !Validator::isValidPhone(phone))
-            throw EmployeeException("Invalid phone format");
+    // For case-insensitive matching the needle must already be folded
+    static bool contains(std::string_view haystack, std::string_view needle, bool case_sensitive) {
+        return case_sensitive ? haystack.find(needle) != std::string_view::npos
+                              : contains_folded(haystack, needle);
     }
 
-    std::string getFullName() const {
-        return firstName + " " + lastName;
+    // Optimal string alignment distance: Levenshtein plus adjacent transpositions,
+    // the typos people actually make. Returns limit + 1 as soon as the distance
+    // is known to exceed limit.
+    static size_t edit_distance(std::string_view a, std::string_view b, size_t limit) {
+        if (a.size() > b.size()) std::swap(a, b);
+        if (b.size() - a.size() > limit) return limit + 1;
+
+        // Three rolling rows over the shorter string, on the stack for anything name-sized
+        constexpr size_t STACK_COLUMNS = 64;
+        const size_t columns = a.size() + 1;
+        size_t stack_rows[3 * STACK_COLUMNS];
+        std::vector<size_t> heap_rows;
+        size_t* rows = stack_rows;
+        if (columns > STACK_COLUMNS) {
+            heap_rows.resize(3 * columns);
+            rows = heap_rows.data();
+        }
+        size_t* before = rows;
+        size_t* previous = rows + columns;
+        size_t* current = rows + 2 * columns;
+
+        for (size_t i = 0; i < columns; ++i) previous[i] = i;
+        for (size_t j = 1; j <= b.size(); ++j) {
+            current[0] = j;
+            size_t row_min = j;
+            for (size_t i = 1; i < columns; ++i) {
+                size_t substitute = previous[i - 1] + (a[i - 1] != b[j - 1]);
+                current[i] = std::min({previous[i] + 1, current[i - 1] + 1, substitute});
+                if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                    current[i] = std::min(current[i], before[i - 2] + 1);
+                }
+                row_min = std::min(row_min, current[i]);
+            }
+            if (row_min > limit) return limit + 1;
+            std::swap(before, previous);
+            std::swap(previous, current);
+        }
+        return std::min(previous[columns - 1], limit + 1);
     }
+};
 
-    std::string getDepartmentString() const {
-        const char* depts[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
-        return depts[static_cast<int>(department)];
+// Splits [0, count) into one contiguous range per worker thread. Callers size
+// per-worker partial results with workers_for() and merge them after run().
+class ParallelRange {
+public:
+    // Never hands a worker fewer than min_per_worker items, so small inputs stay
+    // on the calling thread
+    static size_t workers_for(size_t count, size_t min_per_worker) {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        return std::max<size_t>(1, std::min(hardware, count / std::max<size_t>(1, min_per_worker)));
     }
 
-    std::string getStatusString() const {
-        const char* statuses[] = {"Active", "Inactive", "On Leave", "Terminated"};
-        return statuses[static_cast<int>(status)];
+    // Calls body(worker, begin, end) for every worker; worker 0 runs on the
+    // calling thread
+    template <typename Body>
+    static void run(size_t count, size_t workers, Body&& body) {
+        auto range = [&](size_t worker) {
+            body(worker, count * worker / workers, count * (worker + 1) / workers);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (size_t worker = 1; worker < workers; ++worker) threads.emplace_back(range, worker);
+        range(0);
+        for (auto& thread : threads) thread.join();
     }
+};
 
-    std::string getAccessLevelString() const {
-        return (accessLevel == AccessLevel::ADMIN) ? "Admin" : "Basic";
+// ==================== METRICS ====================
+
+// Build with -DEMPLOYEE_METRICS=0 to compile every counter, histogram and lock
+// timer below down to empty inline calls
+#ifndef EMPLOYEE_METRICS
+#define EMPLOYEE_METRICS 1
+#endif
+
+// Process-wide hot-path counters and latency histograms. Updates are relaxed
+// atomics spread over per-thread stripes, so concurrent readers do not contend
+// on one cache line; exports sum the stripes and are only approximately
+// consistent while writers run.
+class Metrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t nanoseconds_since(Clock::time_point start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
     }
 
-    // Serialization for file I/O
-    std::string serialize() const {
-        std::ostringstream oss;
-        auto time_t = std::chrono::system_clock::to_time_t(hireDate);
+#if EMPLOYEE_METRICS
+    static constexpr bool ENABLED = true;
 
-        oss << id << "|" << firstName << "|" << lastName << "|" << position << "|"
-            << static_cast<int>(department) << "|" << salary << "|" << email << "|"
-            << phone << "|" << time_t << "|" << static_cast<int>(status) << "|"
-            << managerId << "|" << static_cast<int>(accessLevel) << "|";
+    class Counter {
+    private:
+        struct alignas(64) Stripe {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Stripe, 8> stripes;
 
-        // Serialize skills
-        for (size_t i = 0; i < skills.size(); ++i) {
-            oss << skills[i];
-            if (i < skills.size() - 1) oss << ",";
+    public:
+        void add(uint64_t amount = 1) {
+            stripes[stripe_index() % stripes.size()].value.fetch_add(amount, std::memory_order_relaxed);
         }
 
-        return oss.str();
-    }
+        uint64_t value() const {
+            uint64_t total = 0;
+            for (const auto& stripe : stripes) total += stripe.value.load(std::memory_order_relaxed);
+            return total;
+        }
+    };
 
-    static Employee deserialize(const std::string& data) {
-        std::istringstream iss(data);
-        std::string token;
-        std::vector<std::string> tokens;
+    // Log-linear buckets: four per power of two, so any quantile read back is
+    // within 19% of the true value. Values are nanoseconds.
+    class Histogram {
+    public:
+        static constexpr size_t SUB_BUCKETS = 4;
+        static constexpr size_t BUCKETS = 63 * SUB_BUCKETS;
+
+        struct Summary {
+            uint64_t count = 0;
+            uint64_t sum = 0;
+            uint64_t max = 0;
+            std::array<uint64_t, BUCKETS> buckets{};
+
+            // Upper bound of the bucket holding the q-th quantile
+            uint64_t quantile(double q) const {
+                if (count == 0) return 0;
+                uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * count)));
+                uint64_t seen = 0;
+                for (size_t i = 0; i < BUCKETS; ++i) {
+                    seen += buckets[i];
+                    if (seen >= rank) return std::min(max, upper_bound(i));
+                }
+                return max;
+            }
+        };
+
+        void record(uint64_t value) {
+            Stripe& stripe = stripes[stripe_index() % stripes.size()];
+            stripe.buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+            if (value == 0) return;
+            stripe.sum.fetch_add(value, std::memory_order_relaxed);
+            uint64_t seen = stripe.max.load(std::memory_order_relaxed);
+            while (value > seen && !stripe.max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+        }
 
-        while (std::getline(iss, token, '|')) {
-            tokens.push_back(token);
+        Summary summary() const {
+            Summary result;
+            for (const auto& stripe : stripes) {
+                for (size_t i = 0; i < BUCKETS; ++i) {
+                    uint64_t n = stripe.buckets[i].load(std::memory_order_relaxed);
+                    result.buckets[i] += n;
+                    result.count += n;
+                }
+                result.sum += stripe.sum.load(std::memory_order_relaxed);
+                result.max = std::max(result.max, stripe.max.load(std::memory_order_relaxed));
+            }
+            return result;
         }
 
-        if (tokens.size() < 12) {
-            throw EmployeeException("Invalid serialized employee data");
+        static size_t bucket_of(uint64_t value) {
+            if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+            unsigned top = highest_bit(value);
+            size_t sub = static_cast<size_t>(value >> (top - 2)) & (SUB_BUCKETS - 1);
+            return (top - 1) * SUB_BUCKETS + sub;
         }
 
-        Employee emp;
-        emp.id = tokens[0];
-        emp.firstName = tokens[1];
-        emp.lastName = tokens[2];
-        emp.position = tokens[3];
-        emp.department = static_cast<Department>(std::stoi(tokens[4]));
-        emp.salary = std::stod(tokens[5]);
-        emp.email = tokens[6];
-        emp.phone = tokens[7];
-        emp.hireDate = std::chrono::system_clock::from_time_t(std::stoll(tokens[8]));
-        emp.status = static_cast<EmployeeStatus>(std::stoi(tokens[9]));
-        emp.managerId = tokens[10];
-        emp.accessLevel = static_cast<AccessLevel>(std::stoi(tokens[11]));
-
-        // Deserialize skills
-        if (tokens.size() > 12 && !tokens[12].empty()) {
-            std::istringstream skillsStream(tokens[12]);
-            std::string skill;
-            while (std::getline(skillsStream, skill, ',')) {
-                emp.skills.push_back(skill);
+        // Smallest value that falls in a later bucket; the last bucket is open
+        static uint64_t upper_bound(size_t bucket) {
+            if (bucket + 1 < SUB_BUCKETS) return bucket + 1;
+            size_t next = bucket + 1;
+            unsigned top = static_cast<unsigned>(next / SUB_BUCKETS + 1);
+            if (top >= 64) return std::numeric_limits<uint64_t>::max();
+            return static_cast<uint64_t>(SUB_BUCKETS + next % SUB_BUCKETS) << (top - 2);
+        }
+
+    private:
+        struct alignas(64) Stripe {
+            std::array<std::atomic<uint64_t>, BUCKETS> buckets{};
+            std::atomic<uint64_t> sum{0};
+            std::atomic<uint64_t> max{0};
+        };
+        std::array<Stripe, 4> stripes;
+
+        static unsigned highest_bit(uint64_t value) {
+            unsigned bit = 0;
+            for (unsigned step = 32; step > 0; step /= 2) {
+                if (value >> step) {
+                    value >>= step;
+                    bit += step;
+                }
             }
+            return bit;
         }
+    };
 
-        return emp;
+    class Timer {
+    private:
+        Histogram& histogram;
+        Clock::time_point start = Clock::now();
+
+    public:
+        explicit Timer(Histogram& h) : histogram(h) {}
+        ~Timer() { histogram.record(nanoseconds_since(start)); }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+    };
+#else
+    static constexpr bool ENABLED = false;
+
+    class Counter {
+    public:
+        void add(uint64_t = 1) {}
+        uint64_t value() const { return 0; }
+    };
+
+    class Histogram {
+    public:
+        void record(uint64_t) {}
+    };
+
+    class Timer {
+    public:
+        explicit Timer(Histogram&) {}
+    };
+#endif
+
+    static Histogram lookup_latency;
+    static Histogram search_latency;
+    static Histogram rehash_latency;
+    static Histogram save_latency;
+    static Histogram checkpoint_pause;
+    static Histogram load_latency;
+    static Histogram lock_wait_shared;
+    static Histogram lock_wait_exclusive;
+    static Histogram lock_hold_shared;
+    static Histogram lock_hold_exclusive;
+    static Histogram server_request_latency;
+
+    static Counter search_rows_scanned;
+    static Counter search_rows_matched;
+    static Counter save_bytes;
+    static Counter load_bytes;
+    static Counter wal_bytes;
+    static Counter server_requests;
+    static Counter server_batches;
+    static Counter lazy_record_faults;
+    static Counter lazy_cache_hits;
+
+    static void write_prometheus(std::ostream& os);
+    static void write_json(std::ostream& os);
+    static void write_text(std::ostream& os);
+
+private:
+    static size_t stripe_index() {
+        static std::atomic<size_t> next_stripe{0};
+        thread_local size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed);
+        return stripe;
     }
 };
 
-// ==================== ADVANCED SEARCH CRITERIA ====================
+Metrics::Histogram Metrics::lookup_latency;
+Metrics::Histogram Metrics::search_latency;
+Metrics::Histogram Metrics::rehash_latency;
+Metrics::Histogram Metrics::save_latency;
+Metrics::Histogram Metrics::checkpoint_pause;
+Metrics::Histogram Metrics::load_latency;
+Metrics::Histogram Metrics::lock_wait_shared;
+Metrics::Histogram Metrics::lock_wait_exclusive;
+Metrics::Histogram Metrics::lock_hold_shared;
+Metrics::Histogram Metrics::lock_hold_exclusive;
+Metrics::Histogram Metrics::server_request_latency;
+Metrics::Counter Metrics::search_rows_scanned;
+Metrics::Counter Metrics::search_rows_matched;
+Metrics::Counter Metrics::save_bytes;
+Metrics::Counter Metrics::load_bytes;
+Metrics::Counter Metrics::wal_bytes;
+Metrics::Counter Metrics::server_requests;
+Metrics::Counter Metrics::server_batches;
+Metrics::Counter Metrics::lazy_record_faults;
+Metrics::Counter Metrics::lazy_cache_hits;
+
+#if EMPLOYEE_METRICS
+namespace metrics_export {
+
+struct HistogramEntry {
+    const char* name;
+    const char* help;
+    const char* labels;  // Prometheus label set without braces, or ""
+    const Metrics::Histogram& histogram;
+};
 
-struct SearchCriteria {
-    std::optional<std::string> id;
-    std::optional<std::string> firstName;
-    std::optional<std::string> lastName;
-    std::optional<std::string> position;
-    std::optional<Department> department;
-    std::optional<double> minSalary;
-    std::optional<double> maxSalary;
-    std::optional<EmployeeStatus> status;
-    std::optional<std::string> skill;
-    bool caseSensitive = false;
+struct CounterEntry {
+    const char* name;
+    const char* help;
+    const Metrics::Counter& counter;
 };
 
-// ==================== HIGH-PERFORMANCE HASH TABLE ====================
+inline std::vector<HistogramEntry> histograms() {
+    return {
+        {"employee_lookup_seconds", "find() and snapshot() calls", "", Metrics::lookup_latency},
+        {"employee_search_seconds", "search() calls", "", Metrics::search_latency},
+        {"employee_rehash_seconds", "Table rehashes", "", Metrics::rehash_latency},
+        {"employee_save_seconds", "Data file writes, including checkpoints", "", Metrics::save_latency},
+        {"employee_checkpoint_pause_seconds", "Time data file writes block write-ahead log appends", "",
+         Metrics::checkpoint_pause},
+        {"employee_load_seconds", "Data file loads, including log replay", "", Metrics::load_latency},
+        {"employee_table_lock_wait_seconds", "Time spent acquiring table_mutex", "mode=\"shared\"",
+         Metrics::lock_wait_shared},
+        {"employee_table_lock_wait_seconds", "Time spent acquiring table_mutex", "mode=\"exclusive\"",
+         Metrics::lock_wait_exclusive},
+        {"employee_table_lock_hold_seconds", "Time table_mutex was held", "mode=\"shared\"",
+         Metrics::lock_hold_shared},
+        {"employee_table_lock_hold_seconds", "Time table_mutex was held", "mode=\"exclusive\"",
+         Metrics::lock_hold_exclusive},
+        {"employee_server_request_seconds", "Protocol requests served in headless mode", "",
+         Metrics::server_request_latency},
+    };
+}
+
+inline std::vector<CounterEntry> counters() {
+    return {
+        {"employee_search_rows_scanned_total", "Records examined by search()", Metrics::search_rows_scanned},
+        {"employee_search_rows_matched_total", "Records returned by search()", Metrics::search_rows_matched},
+        {"employee_save_bytes_total", "Bytes written to data files", Metrics::save_bytes},
+        {"employee_load_bytes_total", "Bytes read from data files", Metrics::load_bytes},
+        {"employee_wal_bytes_total", "Bytes appended to write-ahead logs", Metrics::wal_bytes},
+        {"employee_server_requests_total", "Protocol requests served in headless mode", Metrics::server_requests},
+        {"employee_server_batches_total", "Request batches read from protocol clients", Metrics::server_batches},
+        {"employee_lazy_record_faults_total", "Records decoded on demand before the table finished loading",
+         Metrics::lazy_record_faults},
+        {"employee_lazy_cache_hits_total", "Lazy lookups answered from the record cache", Metrics::lazy_cache_hits},
+    };
+}
 
-class EmployeeHashTable {
+inline double seconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1e9; }
+
+}  // namespace metrics_export
+
+void Metrics::write_prometheus(std::ostream& os) {
+    using namespace metrics_export;
+    os << std::setprecision(9);
+    for (const auto& entry : counters()) {
+        os << "# HELP " << entry.name << " " << entry.help << "\n"
+           << "# TYPE " << entry.name << " counter\n"
+           << entry.name << " " << entry.counter.value() << "\n";
+    }
+
+    std::string previous;
+    for (const auto& entry : histograms()) {
+        if (previous != entry.name) {
+            os << "# HELP " << entry.name << " " << entry.help << "\n"
+               << "# TYPE " << entry.name << " histogram\n";
+            previous = entry.name;
+        }
+        std::string labels = entry.labels;
+        std::string prefix = labels.empty() ? "" : labels + ",";
+        Histogram::Summary summary = entry.histogram.summary();
+
+        // One cumulative bucket per power of two up to the largest value seen
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < Histogram::BUCKETS; ++i) {
+            cumulative += summary.buckets[i];
+            bool octave_end = (i + 1) % Histogram::SUB_BUCKETS == 0;
+            if (!octave_end) continue;
+            os << entry.name << "_bucket{" << prefix << "le=\"" << seconds(Histogram::upper_bound(i)) << "\"} "
+               << cumulative << "\n";
+            if (cumulative == summary.count) break;
+        }
+        os << entry.name << "_bucket{" << prefix << "le=\"+Inf\"} " << summary.count << "\n";
+        std::string braces = labels.empty() ? "" : "{" + labels + "}";
+        os << entry.name << "_sum" << braces << " " << seconds(summary.sum) << "\n"
+           << entry.name << "_count" << braces << " " << summary.count << "\n";
+    }
+}
+
+void Metrics::write_json(std::ostream& os) {
+    using namespace metrics_export;
+    os << std::setprecision(9) << "{\n  \"enabled\": true,\n  \"counters\": {";
+    auto counter_list = counters();
+    for (size_t i = 0; i < counter_list.size(); ++i) {
+        os << (i ? "," : "") << "\n    \"" << counter_list[i].name << "\": " << counter_list[i].counter.value();
+    }
+    os << "\n  },\n  \"histograms\": [";
+
+    auto histogram_list = histograms();
+    for (size_t i = 0; i < histogram_list.size(); ++i) {
+        const auto& entry = histogram_list[i];
+        Histogram::Summary summary = entry.histogram.summary();
+        std::string labels = entry.labels;
+        std::string mode = labels.empty() ? "" : labels.substr(labels.find('"') + 1, labels.rfind('"') - labels.find('"') - 1);
+        os << (i ? "," : "") << "\n    {\"name\": \"" << entry.name << "\"";
+        if (!mode.empty()) os << ", \"mode\": \"" << mode << "\"";
+        os << ", \"count\": " << summary.count << ", \"sum_seconds\": " << seconds(summary.sum)
+           << ", \"p50_seconds\": " << seconds(summary.quantile(0.50))
+           << ", \"p90_seconds\": " << seconds(summary.quantile(0.90))
+           << ", \"p99_seconds\": " << seconds(summary.quantile(0.99))
+           << ", \"p999_seconds\": " << seconds(summary.quantile(0.999))
+           << ", \"max_seconds\": " << seconds(summary.max) << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void Metrics::write_text(std::ostream& os) {
+    using namespace metrics_export;
+    for (const auto& entry : histograms()) {
+        Histogram::Summary summary = entry.histogram.summary();
+        if (summary.count == 0) continue;
+        std::string name = entry.name;
+        if (*entry.labels) name += std::string("{") + entry.labels + "}";
+        os << "  " << std::left << std::setw(52) << name << std::right << " n=" << summary.count
+           << std::fixed << std::setprecision(1)
+           << "  p50=" << summary.quantile(0.50) / 1000.0 << "us"
+           << "  p99=" << summary.quantile(0.99) / 1000.0 << "us"
+           << "  max=" << summary.max / 1000.0 << "us\n";
+    }
+    for (const auto& entry : counters()) {
+        os << "  " << std::left << std::setw(52) << entry.name << std::right << " " << entry.counter.value() << "\n";
+    }
+}
+#else
+void Metrics::write_prometheus(std::ostream& os) { os << "# metrics disabled at build time\n"; }
+void Metrics::write_json(std::ostream& os) { os << "{\"enabled\": false}\n"; }
+void Metrics::write_text(std::ostream& os) { os << "  (metrics disabled at build time)\n"; }
+#endif
+
+// Drop-in for std::shared_mutex that records how long each acquisition waited
+// and how long the lock was then held. Nested shared acquisitions by one thread
+// are timed as a single hold.
+#if EMPLOYEE_METRICS
+class MeteredSharedMutex {
 private:
-    struct HashNode {
-        std::unique_ptr<Employee> employee;
-        std::unique_ptr<HashNode> next;
+    std::shared_mutex mutex;
+    Metrics::Clock::time_point exclusive_since;
 
-        HashNode(std::unique_ptr<Employee> emp) : employee(std::move(emp)) {}
+    struct SharedHold {
+        unsigned depth = 0;
+        Metrics::Clock::time_point since;
     };
+    static thread_local SharedHold shared_hold;
 
-    std::vector<std::unique_ptr<HashNode>> table;
-    size_t bucket_count;
-    size_t element_count;
-    mutable std::mutex table_mutex;
-
-    // High-quality hash function (FNV-1a)
-    size_t hash(const std::string& key) const {
-        const size_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
-        const size_t FNV_PRIME = 1099511628211ULL;
+    static Metrics::Clock::time_point acquired(Metrics::Histogram& wait, Metrics::Clock::time_point start) {
+        auto now = Metrics::Clock::now();
+        wait.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()));
+        return now;
+    }
 
-        size_t hash_value = FNV_OFFSET_BASIS;
-        for (char c : key) {
-            hash_value ^= static_cast<size_t>(c);
-            hash_value *= FNV_PRIME;
+public:
+    // Uncontended acquisitions are recorded as zero wait without reading the
+    // clock twice; only a failed try pays for timing the wait
+    void lock() {
+        if (mutex.try_lock()) {
+            Metrics::lock_wait_exclusive.record(0);
+            exclusive_since = Metrics::Clock::now();
+            return;
         }
-        return hash_value % bucket_count;
+        auto start = Metrics::Clock::now();
+        mutex.lock();
+        exclusive_since = acquired(Metrics::lock_wait_exclusive, start);
     }
 
-    bool is_prime(size_t n) const {
-        if (n < 2) return false;
-        if (n == 2) return true;
-        if (n % 2 == 0) return false;
+    bool try_lock() {
+        if (!mutex.try_lock()) return false;
+        exclusive_since = Metrics::Clock::now();
+        return true;
+    }
+
+    void unlock() {
+        uint64_t held = Metrics::nanoseconds_since(exclusive_since);
+        mutex.unlock();
+        Metrics::lock_hold_exclusive.record(held);
+    }
 
-        for (size_t i = 3; i * i <= n; i += 2) {
-            if (n % i == 0) return false;
+    void lock_shared() {
+        if (mutex.try_lock_shared()) {
+            Metrics::lock_wait_shared.record(0);
+            if (shared_hold.depth++ == 0) shared_hold.since = Metrics::Clock::now();
+            return;
         }
-        return true;
+        auto start = Metrics::Clock::now();
+        mutex.lock_shared();
+        auto now = acquired(Metrics::lock_wait_shared, start);
+        if (shared_hold.depth++ == 0) shared_hold.since = now;
     }
 
-    size_t next_prime(size_t n) const {
-        while (!is_prime(n)) ++n;
-        return n;
+    bool try_lock_shared() {
+        if (!mutex.try_lock_shared()) return false;
+        if (shared_hold.depth++ == 0) shared_hold.since = Metrics::Clock::now();
+        return true;
     }
 
-    void rehash() {
-        Logger::log(Logger::INFO, "Rehashing hash table, current load factor: " +
-                   std::to_string(load_factor()));
+    void unlock_shared() {
+        bool outermost = --shared_hold.depth == 0;
+        uint64_t held = outermost ? Metrics::nanoseconds_since(shared_hold.since) : 0;
+        mutex.unlock_shared();
+        if (outermost) Metrics::lock_hold_shared.record(held);
+    }
+};
 
-        size_t old_bucket_count = bucket_count;
-        bucket_count = next_prime(bucket_count * 2);
+thread_local MeteredSharedMutex::SharedHold MeteredSharedMutex::shared_hold;
+#else
+using MeteredSharedMutex = std::shared_mutex;
+#endif
+
+// ==================== COMPACT RECORD FIELDS ====================
+
+// Bytes a string owns outside itself: zero while it fits the small-string buffer
+template <typename String>
+size_t string_heap_bytes(const String& value) {
+    const char* self = reinterpret_cast<const char*>(&value);
+    std::less<const char*> before;
+    bool in_place = !before(value.data(), self) && before(value.data(), self + sizeof(value));
+    return in_place ? 0 : value.capacity() + 1;
+}
+
+// Estimated footprint of a node-based hash container: the bucket array plus one
+// node per entry holding the value, a next pointer and the cached hash
+template <typename HashContainer>
+size_t hash_container_bytes(const HashContainer& container) {
+    return container.bucket_count() * sizeof(void*) +
+           container.size() * (sizeof(typename HashContainer::value_type) + 2 * sizeof(void*));
+}
+
+// Process-wide dictionary for the strings many records share, positions and
+// skills. Each distinct value is stored once and never freed, so a handle is a
+// plain pointer that stays valid for the life of the process and compares by
+// address. Interning locks one of SHARDS mutexes; reading a handle never locks.
+class StringPool {
+public:
+    struct Usage {
+        size_t strings = 0;
+        size_t bytes = 0;
+    };
 
-        auto old_table = std::move(table);
-        table.clear();
-        table.resize(bucket_count);
-        element_count = 0;
+    // nullptr stands for the empty string
+    static const std::string* intern(std::string_view value) {
+        if (value.empty()) return nullptr;
+        Shard& shard = shards[std::hash<std::string_view>{}(value) % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.lookup.find(value);
+        if (it != shard.lookup.end()) return it->second;
+
+        const std::string* stored = &shard.values.emplace_back(value);
+        shard.lookup.emplace(*stored, stored);
+        return stored;
+    }
 
-        // Reinsert all elements
-        for (auto& head : old_table) {
-            auto current = std::move(head);
-            while (current) {
-                auto next = std::move(current->next);
-                insert_internal(std::move(current->employee));
-                current = std::move(next);
-            }
+    static Usage usage() {
+        Usage total;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.strings += shard.values.size();
+            total.bytes += shard.values.size() * sizeof(std::string);
+            for (const auto& value : shard.values) total.bytes += string_heap_bytes(value);
+            total.bytes += hash_container_bytes(shard.lookup);
         }
-
-        Logger::log(Logger::INFO, "Rehashing completed, new bucket count: " +
-                   std::to_string(bucket_count));
+        return total;
     }
 
-    bool insert_internal(std::unique_ptr<Employee> emp) {
-        size_t index = hash(emp->id);
+private:
+    static constexpr size_t SHARDS = 16;
 
-        // Check for duplicates
-        auto current = table[index].get();
-        while (current) {
-            if (current->employee->id == emp->id) {
-                return false;  // Duplicate found
-            }
-            current = current->next.get();
-        }
+    struct Shard {
+        std::mutex mutex;
+        std::deque<std::string> values;  // deque never moves its elements
+        std::unordered_map<std::string_view, const std::string*> lookup;
+    };
+    static std::array<Shard, SHARDS> shards;
+};
 
-        // Insert at head
-        auto new_node = std::make_unique<HashNode>(std::move(emp));
-        new_node->next = std::move(table[index]);
-        table[index] = std::move(new_node);
-        ++element_count;
+std::array<StringPool::Shard, StringPool::SHARDS> StringPool::shards;
 
-        return true;
+// Eight-byte handle to a StringPool entry. Converts to const std::string&
+// wherever a string is expected; assigning text interns it.
+class InternedString {
+private:
+    friend class SkillSet;
+    const std::string* value = nullptr;
+
+    explicit InternedString(const std::string* handle) : value(handle) {}
+
+    static const std::string& empty_value() {
+        static const std::string empty;
+        return empty;
     }
 
 public:
-    static constexpr double MAX_LOAD_FACTOR = 0.75;
+    InternedString() = default;
+    explicit InternedString(std::string_view text) : value(StringPool::intern(text)) {}
 
-    explicit EmployeeHashTable(size_t initial_bucket_count = 17)
-        : bucket_count(next_prime(initial_bucket_count)), element_count(0) {
-        table.resize(bucket_count);
-        Logger::log(Logger::INFO, "Hash table initialized with " +
-                   std::to_string(bucket_count) + " buckets");
+    InternedString& operator=(std::string_view text) {
+        value = StringPool::intern(text);
+        return *this;
     }
 
-    // Move Constructor
-    EmployeeHashTable(EmployeeHashTable&& other) noexcept
-        : bucket_count(other.bucket_count),
-          element_count(other.element_count),
-          table(std::move(other.table)) {
-        other.bucket_count = 0;
-        other.element_count = 0;
-    }
+    const std::string& str() const { return value ? *value : empty_value(); }
+    operator const std::string&() const { return str(); }
+    operator std::string_view() const { return str(); }
+    bool empty() const { return value == nullptr; }
+    size_t size() const { return str().size(); }
+
+    friend bool operator==(const InternedString& a, const InternedString& b) { return a.value == b.value; }
+    friend bool operator!=(const InternedString& a, const InternedString& b) { return a.value != b.value; }
+    friend bool operator==(const InternedString& a, std::string_view b) { return std::string_view(a.str()) == b; }
+    friend bool operator!=(const InternedString& a, std::string_view b) { return !(a == b); }
+    friend std::ostream& operator<<(std::ostream& os, const InternedString& s) { return os << s.str(); }
+
+    // Equal strings share one handle, so hashing the address is enough
+    struct Hash {
+        size_t operator()(const InternedString& s) const { return std::hash<const std::string*>{}(s.value); }
+    };
+};
 
-    // Move Assignment Operator
-    EmployeeHashTable& operator=(EmployeeHashTable&& other) noexcept {
-        if (this != &other) {
-            std::lock(table_mutex, other.table_mutex);
-            std::lock_guard<std::mutex> self_lock(table_mutex, std::adopt_lock);
-            std::lock_guard<std::mutex> other_lock(other.table_mutex, std::adopt_lock);
+// Ordered list of interned skills. Up to INLINE_CAPACITY handles live inside
+// the record; longer lists spill to one heap array. Elements read back as
+// InternedString values.
+class SkillSet {
+public:
+    static constexpr uint32_t INLINE_CAPACITY = 3;
+
+    class const_iterator {
+    private:
+        const std::string* const* at = nullptr;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = InternedString;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = InternedString;
+
+        const_iterator() = default;
+        explicit const_iterator(const std::string* const* position) : at(position) {}
+
+        InternedString operator*() const { return InternedString(*at); }
+        InternedString operator[](difference_type n) const { return InternedString(at[n]); }
+        const_iterator& operator++() { ++at; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++at; return old; }
+        const_iterator& operator--() { --at; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --at; return old; }
+        const_iterator& operator+=(difference_type n) { at += n; return *this; }
+        const_iterator& operator-=(difference_type n) { at -= n; return *this; }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const_iterator a, const_iterator b) { return a.at - b.at; }
+        friend bool operator==(const_iterator a, const_iterator b) { return a.at == b.at; }
+        friend bool operator!=(const_iterator a, const_iterator b) { return a.at != b.at; }
+        friend bool operator<(const_iterator a, const_iterator b) { return a.at < b.at; }
+    };
+    using value_type = InternedString;
 
-            table = std::move(other.table);
-            bucket_count = other.bucket_count;
-            element_count = other.element_count;
+    SkillSet() = default;
+    SkillSet(const std::vector<std::string>& skills) {
+        reserve(skills.size());
+        for (const auto& skill : skills) push_back(skill);
+    }
+    SkillSet(std::initializer_list<std::string_view> skills) {
+        reserve(skills.size());
+        for (std::string_view skill : skills) push_back(skill);
+    }
+    SkillSet(const SkillSet& other) { append(other); }
+    SkillSet(SkillSet&& other) noexcept { take(other); }
+    ~SkillSet() { release(); }
 
-            other.bucket_count = 0;
-            other.element_count = 0;
+    SkillSet& operator=(const SkillSet& other) {
+        if (this != &other) {
+            count = 0;
+            append(other);
         }
         return *this;
     }
-    
-    // Disable copy operations
-    EmployeeHashTable(const EmployeeHashTable&) = delete;
-    EmployeeHashTable& operator=(const EmployeeHashTable&) = delete;
 
-    bool insert(const Employee& emp) {
-        std::lock_guard<std::mutex> lock(table_mutex);
-
-        try {
-            emp.validate();
-        } catch (const EmployeeException& e) {
-            Logger::log(Logger::ERROR, "Employee validation failed: " + std::string(e.what()));
-            throw;
+    SkillSet& operator=(SkillSet&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
         }
+        return *this;
+    }
 
-        auto emp_copy = std::make_unique<Employee>(emp);
-        bool inserted = insert_internal(std::move(emp_copy));
-
-        if (inserted) {
-            Logger::log(Logger::INFO, "Employee inserted: " + emp.id);
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const_iterator begin() const { return const_iterator(handles()); }
+    const_iterator end() const { return const_iterator(handles() + count); }
+    InternedString operator[](size_t i) const { return InternedString(handles()[i]); }
 
-            if (load_factor() > MAX_LOAD_FACTOR) {
-                rehash();
-            }
-        } else {
-            Logger::log(Logger::WARNING, "Duplicate employee ID attempted: " + emp.id);
-        }
+    InternedString at(size_t i) const {
+        if (i >= count) throw std::out_of_range("SkillSet::at");
+        return (*this)[i];
+    }
 
-        return inserted;
+    void push_back(const InternedString& skill) {
+        if (count == capacity) grow(static_cast<size_t>(capacity) * 2);
+        handles()[count++] = skill.value;
     }
+    void push_back(std::string_view skill) { push_back(InternedString(skill)); }
+    void emplace_back(std::string_view skill) { push_back(InternedString(skill)); }
 
-    bool remove(const std::string& id) {
-        std::lock_guard<std::mutex> lock(table_mutex);
+    void reserve(size_t n) {
+        if (n > capacity) grow(n);
+    }
 
-        size_t index = hash(id);
-        auto current = table[index].get();
-        HashNode* prev = nullptr;
+    void clear() { count = 0; }
 
-        while (current) {
-            if (current->employee->id == id) {
-                if (prev) {
-                    prev->next = std::move(current->next);
-                } else {
-                    table[index] = std::move(current->next);
-                }
-                --element_count;
-                Logger::log(Logger::INFO, "Employee removed: " + id);
-                return true;
-            }
-            prev = current;
-            current = current->next.get();
-        }
+    size_t heap_bytes() const { return spilled() ? capacity * sizeof(const std::string*) : 0; }
 
-        Logger::log(Logger::WARNING, "Employee not found for removal: " + id);
-        return false;
+    friend bool operator==(const SkillSet& a, const SkillSet& b) {
+        return a.count == b.count && std::equal(a.handles(), a.handles() + a.count, b.handles());
     }
+    friend bool operator!=(const SkillSet& a, const SkillSet& b) { return !(a == b); }
 
-    Employee* find(const std::string& id) const {
-        std::lock_guard<std::mutex> lock(table_mutex);
+private:
+    uint32_t count = 0;
+    uint32_t capacity = INLINE_CAPACITY;
+    union {
+        const std::string* inline_handles[INLINE_CAPACITY] = {};
+        const std::string** heap;
+    };
 
-        size_t index = hash(id);
-        auto current = table[index].get();
+    bool spilled() const { return capacity > INLINE_CAPACITY; }
+    const std::string** handles() { return spilled() ? heap : inline_handles; }
+    const std::string* const* handles() const { return spilled() ? heap : inline_handles; }
+
+    void grow(size_t n) {
+        if (n > std::numeric_limits<uint32_t>::max()) throw EmployeeException("Too many skills");
+        auto bigger = new const std::string*[n];
+        std::copy(handles(), handles() + count, bigger);
+        if (spilled()) delete[] heap;
+        heap = bigger;
+        capacity = static_cast<uint32_t>(n);
+    }
 
-        while (current) {
-            if (current->employee->id == id) {
-                return current->employee.get();
-            }
-            current = current->next.get();
+    void append(const SkillSet& other) {
+        reserve(count + other.count);
+        std::copy(other.handles(), other.handles() + other.count, handles() + count);
+        count += other.count;
+    }
+
+    void take(SkillSet& other) {
+        count = other.count;
+        capacity = other.capacity;
+        if (other.spilled()) {
+            heap = other.heap;
+        } else {
+            std::copy(other.inline_handles, other.inline_handles + INLINE_CAPACITY, inline_handles);
         }
+        other.count = 0;
+        other.capacity = INLINE_CAPACITY;
+    }
 
-        return nullptr;
+    void release() {
+        if (spilled()) delete[] heap;
+        capacity = INLINE_CAPACITY;
+        count = 0;
     }
+};
 
-    bool update(const std::string& id, const Employee& updated_emp) {
-        std::lock_guard<std::mutex> lock(table_mutex);
+// Employee and manager IDs are six characters (AB1234), so they live inside
+// the record instead of in a std::string. A longer value keeps its first six
+// characters and is flagged, so validate() still rejects it.
+class EmployeeId {
+public:
+    static constexpr size_t CAPACITY = 6;
 
-        size_t index = hash(id);
-        auto current = table[index].get();
+    EmployeeId() = default;
+    explicit EmployeeId(std::string_view text) { assign(text); }
 
-        while (current) {
-            if (current->employee->id == id) {
-                try {
-                    updated_emp.validate();
-                    *current->employee = updated_emp;
-                    Logger::log(Logger::INFO, "Employee updated: " + id);
-                    return true;
-                } catch (const EmployeeException& e) {
-                    Logger::log(Logger::ERROR, "Employee update validation failed: " + std::string(e.what()));
-                    throw;
-                }
-            }
-            current = current->next.get();
-        }
+    EmployeeId& operator=(std::string_view text) {
+        assign(text);
+        return *this;
+    }
 
-        Logger::log(Logger::WARNING, "Employee not found for update: " + id);
-        return false;
+    std::string_view view() const { return std::string_view(chars.data(), length); }
+    std::string str() const { return std::string(view()); }
+    operator std::string() const { return str(); }
+    operator std::string_view() const { return view(); }
+    bool empty() const { return length == 0; }
+    size_t size() const { return length; }
+    bool truncated() const { return overflow; }
+
+    friend bool operator==(const EmployeeId& a, const EmployeeId& b) { return a.view() == b.view(); }
+    friend bool operator!=(const EmployeeId& a, const EmployeeId& b) { return !(a == b); }
+    friend bool operator<(const EmployeeId& a, const EmployeeId& b) { return a.view() < b.view(); }
+    friend bool operator==(const EmployeeId& a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(const EmployeeId& a, std::string_view b) { return a.view() != b; }
+    friend std::ostream& operator<<(std::ostream& os, const EmployeeId& id) { return os << id.view(); }
+
+    struct Hash {
+        size_t operator()(const EmployeeId& id) const { return std::hash<std::string_view>{}(id.view()); }
+    };
+
+private:
+    std::array<char, CAPACITY> chars{};
+    uint8_t length = 0;
+    bool overflow = false;
+
+    void assign(std::string_view text) {
+        overflow = text.size() > CAPACITY;
+        length = static_cast<uint8_t>(std::min(text.size(), CAPACITY));
+        std::copy(text.begin(), text.begin() + length, chars.begin());
     }
+};
 
-    std::vector<Employee> search(const SearchCriteria& criteria) const {
-        std::lock_guard<std::mutex> lock(table_mutex);
-        std::vector<Employee> results;
+// ==================== ENHANCED EMPLOYEE STRUCTURE ====================
 
-        for (const auto& head : table) {
-            auto current = head.get();
-            while (current) {
-                const Employee& emp = *current->employee;
-                bool matches = true;
-
-                if (criteria.id && emp.id != *criteria.id) matches = false;
-                if (criteria.firstName) {
-                    std::string empFirstName = criteria.caseSensitive ? emp.firstName :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(emp.firstName);
-                    std::string searchFirstName = criteria.caseSensitive ? *criteria.firstName :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(*criteria.firstName);
-                    if (empFirstName.find(searchFirstName) == std::string::npos) matches = false;
-                }
-                if (criteria.lastName) {
-                    std::string empLastName = criteria.caseSensitive ? emp.lastName :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(emp.lastName);
-                    std::string searchLastName = criteria.caseSensitive ? *criteria.lastName :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(*criteria.lastName);
-                    if (empLastName.find(searchLastName) == std::string::npos) matches = false;
-                }
-                if (criteria.position) {
-                    std::string empPosition = criteria.caseSensitive ? emp.position :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(emp.position);
-                    std::string searchPosition = criteria.caseSensitive ? *criteria.position :
-                        [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; }(*criteria.position);
-                    if (empPosition.find(searchPosition) == std::string::npos) matches = false;
-                }
-                if (criteria.department && emp.department != *criteria.department) matches = false;
-                if (criteria.minSalary && emp.salary < *criteria.minSalary) matches = false;
-                if (criteria.maxSalary && emp.salary > *criteria.maxSalary) matches = false;
-                if (criteria.status && emp.status != *criteria.status) matches = false;
-                if (criteria.skill) {
-                    bool hasSkill = std::find_if(emp.skills.begin(), emp.skills.end(),
-                        [&](const std::string& skill) {
-                            if (criteria.caseSensitive) {
-                                return skill.find(*criteria.skill) != std::string::npos;
-                            } else {
-                                std::string lowerSkill = skill;
-                                std::string lowerSearch = *criteria.skill;
-                                std::transform(lowerSkill.begin(), lowerSkill.end(), lowerSkill.begin(), ::tolower);
-                                std::transform(lowerSearch.begin(), lowerSearch.end(), lowerSearch.begin(), ::tolower);
-                                return lowerSkill.find(lowerSearch) != std::string::npos;
-                            }
-                        }) != emp.skills.end();
-                    if (!hasSkill) matches = false;
-                }
+enum class Department : uint8_t {
+    ENGINEERING, HR, FINANCE, MARKETING, OPERATIONS, SALES, UNKNOWN
+};
 
-                if (matches) {
-                    results.push_back(emp);
-                }
+enum class EmployeeStatus : uint8_t {
+    ACTIVE, INACTIVE, ON_LEAVE, TERMINATED
+};
 
-                current = current->next.get();
-            }
-        }
+enum class AccessLevel : uint8_t {
+    BASIC, ADMIN
+};
 
-        Logger::log(Logger::INFO, "Search completed, found " + std::to_string(results.size()) + " results");
-        return results;
+// Members are ordered largest first so the enums pack into the tail padding
+struct Employee {
+    std::string firstName;
+    std::string lastName;
+    std::string email;
+    std::string phone;
+    SkillSet skills;
+    double salary;
+    std::chrono::system_clock::time_point hireDate;
+    InternedString position;
+    EmployeeId id;
+    EmployeeId managerId;  // References another employee
+    Department department;
+    EmployeeStatus status;
+    AccessLevel accessLevel;
+
+    // Largest hire date, in seconds either side of the epoch, that the clock can
+    // hold; decoders reject stored values beyond it before converting
+    static constexpr int64_t MAX_HIRE_SECONDS = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::duration::max()).count();
+
+    // Constructors
+    Employee() : salary(0), hireDate(std::chrono::system_clock::now()),
+                department(Department::UNKNOWN), status(EmployeeStatus::ACTIVE),
+                accessLevel(AccessLevel::BASIC) {}
+
+    Employee(const std::string& id, const std::string& firstName,
+             const std::string& lastName, const std::string& position,
+             Department dept, double salary, const std::string& email = "",
+             const std::string& phone = "", AccessLevel access = AccessLevel::BASIC)
+        : firstName(firstName), lastName(lastName), email(email), phone(phone),
+          salary(salary), hireDate(std::chrono::system_clock::now()), position(position),
+          id(id), department(dept), status(EmployeeStatus::ACTIVE), accessLevel(access) {
+
+        validate();
     }
 
-    std::vector<Employee> get_all() const {
-        SearchCriteria empty_criteria;
-        return search(empty_criteria);
+    void validate() const {
+        if (id.truncated() || !Validator::isValidID(id))
+            throw EmployeeException("Invalid employee ID format");
+        if (managerId.truncated())
+            throw EmployeeException("Invalid manager ID format");
+        if (!Validator::isValidName(firstName) || !Validator::isValidName(lastName))
+            throw EmployeeException("Invalid name format");
+        if (!Validator::isValidPosition(position))
+            throw EmployeeException("Invalid position format");
+        if (!Validator::isValidSalary(salary))
+            throw EmployeeException("Invalid salary range");
+        if (!email.empty() && !Validator::isValidEmail(email))
+            throw EmployeeException("Invalid email format");
+        if (!phone.empty() && !Validator::isValidPhone(phone))
+            throw EmployeeException("Invalid phone format");
+        // Enums index per-value arrays in the secondary index and aggregates
+        if (department > Department::UNKNOWN || status > EmployeeStatus::TERMINATED ||
+            accessLevel > AccessLevel::ADMIN)
+            throw EmployeeException("Invalid department, status or access level");
     }
 
-    double load_factor() const {
-        return static_cast<double>(element_count) / bucket_count;
+    // Bytes this record owns outside sizeof(Employee). Interned positions and
+    // skills are shared and counted once in StringPool::usage() instead.
+    size_t heap_bytes() const {
+        return string_heap_bytes(firstName) + string_heap_bytes(lastName) + string_heap_bytes(email) +
+               string_heap_bytes(phone) + skills.heap_bytes();
     }
 
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(table_mutex);
-        return element_count;
+    std::string getFullName() const {
+        return firstName + " " + lastName;
     }
 
-    void get_statistics(std::ostream& os) const {
-        std::lock_guard<std::mutex> lock(table_mutex);
+    std::string getDepartmentString() const {
+        const char* depts[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
+        return depts[static_cast<int>(department)];
+    }
 
-        size_t max_chain_length = 0;
-        size_t empty_buckets = 0;
-        size_t total_chain_length = 0;
+    std::string getStatusString() const {
+        const char* statuses[] = {"Active", "Inactive", "On Leave", "Terminated"};
+        return statuses[static_cast<int>(status)];
+    }
 
-        for (const auto& head : table) {
-            size_t chain_length = 0;
-            auto current = head.get();
-            while (current) {
-                ++chain_length;
-                current = current->next.get();
-            }
+    std::string getAccessLevelString() const {
+        return (accessLevel == AccessLevel::ADMIN) ? "Admin" : "Basic";
+    }
 
-            if (chain_length == 0) {
-                ++empty_buckets;
-            } else {
-                max_chain_length = std::max(max_chain_length, chain_length);
-                total_chain_length += chain_length;
+    // Serialization for file I/O
+    std::string serialize() const {
+        std::string line;
+        serialize_to(line);
+        return line;
+    }
+
+    // Appends the serialize() line to out without a stream, so callers writing
+    // many records can reuse one buffer
+    void serialize_to(std::string& out) const {
+        char number[32];
+        auto put_integer = [&](auto value) {
+            auto result = std::to_chars(number, number + sizeof(number), value);
+            out.append(number, result.ptr);
+            out.push_back('|');
+        };
+        auto put_text = [&](std::string_view text) {
+            out.append(text);
+            out.push_back('|');
+        };
+
+        put_text(id);
+        put_text(firstName);
+        put_text(lastName);
+        put_text(position);
+        put_integer(static_cast<int>(department));
+        // The default six significant digits would round salaries of a million
+        // or more; fifteen keep every cent
+        int length = std::snprintf(number, sizeof(number), "%.15g", salary);
+        out.append(number, static_cast<size_t>(std::max(length, 0)));
+        out.push_back('|');
+        put_text(email);
+        put_text(phone);
+        put_integer(static_cast<long long>(std::chrono::system_clock::to_time_t(hireDate)));
+        put_integer(static_cast<int>(status));
+        put_text(managerId);
+        put_integer(static_cast<int>(accessLevel));
+
+        for (size_t i = 0; i < skills.size(); ++i) {
+            if (i > 0) out.push_back(',');
+            out.append(std::string_view(skills[i]));
+        }
+    }
+
+    // Parses one serialize() line in place: fields are sliced as views of data
+    // and numbers read with from_chars, so the only allocations are the record's
+    // own strings
+    static Employee deserialize(std::string_view data) {
+        std::array<std::string_view, 13> fields;
+        size_t count = 0;
+        while (count < fields.size()) {
+            size_t bar = data.find('|');
+            fields[count++] = data.substr(0, bar);
+            if (bar == std::string_view::npos) break;
+            data.remove_prefix(bar + 1);
+        }
+        if (count < 12) {
+            throw EmployeeException("Invalid serialized employee data");
+        }
+
+        auto number = [](std::string_view field, auto& value, const char* name) {
+            const char* end = field.data() + field.size();
+            auto parsed = std::from_chars(field.data(), end, value);
+            if (parsed.ec != std::errc() || parsed.ptr != end) {
+                throw EmployeeException(std::string("Invalid ") + name + " in serialized employee data");
             }
+        };
+        int department, status, access;
+        long long hired;
+        Employee emp;
+        number(fields[4], department, "department");
+        number(fields[5], emp.salary, "salary");
+        number(fields[8], hired, "hire date");
+        number(fields[9], status, "status");
+        number(fields[11], access, "access level");
+        if (hired < -MAX_HIRE_SECONDS || hired > MAX_HIRE_SECONDS) {
+            throw EmployeeException("Invalid hire date in serialized employee data");
+        }
+        if (department < 0 || department > static_cast<int>(Department::UNKNOWN) ||
+            status < 0 || status > static_cast<int>(EmployeeStatus::TERMINATED) ||
+            access < 0 || access > static_cast<int>(AccessLevel::ADMIN)) {
+            throw EmployeeException("Invalid enumeration value in serialized employee data");
         }
 
-        double avg_chain_length = (bucket_count - empty_buckets > 0) ?
-            static_cast<double>(total_chain_length) / (bucket_count - empty_buckets) : 0;
+        emp.id = fields[0];
+        emp.firstName = fields[1];
+        emp.lastName = fields[2];
+        emp.position = fields[3];
+        emp.department = static_cast<Department>(department);
+        emp.email = fields[6];
+        emp.phone = fields[7];
+        emp.hireDate = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(hired));
+        emp.status = static_cast<EmployeeStatus>(status);
+        emp.managerId = fields[10];
+        emp.accessLevel = static_cast<AccessLevel>(access);
+
+        std::string_view skills = count > 12 ? fields[12] : std::string_view();
+        while (!skills.empty()) {
+            size_t comma = skills.find(',');
+            std::string_view skill = skills.substr(0, comma);
+            if (!skill.empty()) emp.skills.push_back(skill);
+            if (comma == std::string_view::npos) break;
+            skills.remove_prefix(comma + 1);
+        }
 
-        os << "Hash Table Statistics:\n"
-           << "  Bucket Count: " << bucket_count << "\n"
-           << "  Element Count: " << element_count << "\n"
-           << "  Load Factor: " << std::fixed << std::setprecision(3) << load_factor() << "\n"
-           << "  Empty Buckets: " << empty_buckets << " ("
-           << std::fixed << std::setprecision(1) << (100.0 * empty_buckets / bucket_count) << "%)\n"
-           << "  Max Chain Length: " << max_chain_length << "\n"
-           << "  Avg Chain Length: " << std::fixed << std::setprecision(2) << avg_chain_length << "\n";
+        return emp;
     }
 };
 
-// ==================== DATA PERSISTENCE LAYER ====================
+// ==================== ADVANCED SEARCH CRITERIA ====================
 
-class DataManager {
-private:
-    std::string data_file;
-    std::string backup_file;
-    mutable std::mutex file_mutex;
+struct SearchCriteria {
+    std::optional<std::string> id;
+    std::optional<std::string> firstName;
+    std::optional<std::string> lastName;
+    std::optional<std::string> position;
+    std::optional<Department> department;
+    std::optional<double> minSalary;
+    std::optional<double> maxSalary;
+    std::optional<EmployeeStatus> status;
+    std::optional<std::string> skill;
+    bool caseSensitive = false;
+    std::optional<size_t> limit;  // Stop after this many matches
+};
 
+// A SearchCriteria compiled once per search into only the checks it needs, so
+// matching a record never re-tests an absent field or the case flag and never
+// allocates. Enum and salary filters run first through one matcher specialized
+// for that exact combination; text checks follow, cheapest first, and the first
+// failing check ends the match.
+class QueryPlan {
 public:
-    explicit DataManager(const std::string& filename = "employees.dat")
-        : data_file(filename), backup_file(filename + ".bak") {}
-
-    bool save(const EmployeeHashTable& table) {
-        std::lock_guard<std::mutex> lock(file_mutex);
+    enum Field : unsigned {
+        ID = 1u << 0, DEPARTMENT = 1u << 1, STATUS = 1u << 2, SALARY = 1u << 3,
+        POSITION = 1u << 4, LAST_NAME = 1u << 5, FIRST_NAME = 1u << 6, SKILL = 1u << 7
+    };
 
-        try {
-            // Create backup first
-            std::ifstream src(data_file);
-            if (src.good()) {
-                std::ofstream dst(backup_file);
-                dst << src.rdbuf();
-                src.close();
-                dst.close();
-            }
+    const SearchCriteria& criteria;
+    size_t limit;
 
-            // Save new data
-            std::ofstream file(data_file);
-            if (!file.is_open()) {
-                Logger::log(Logger::ERROR, "Failed to open file for writing: " + data_file);
-                return false;
-            }
+    // Text terms, folded unless the search is case-sensitive
+    std::string firstName;
+    std::string lastName;
+    std::string position;
+    std::string skill;
+
+    explicit QueryPlan(const SearchCriteria& c)
+        : criteria(c), limit(c.limit.value_or(std::numeric_limits<size_t>::max())),
+          min_salary(c.minSalary.value_or(-std::numeric_limits<double>::infinity())),
+          max_salary(c.maxSalary.value_or(std::numeric_limits<double>::infinity())) {
+        auto prepare = [&](const std::optional<std::string>& term) {
+            if (!term) return std::string();
+            return c.caseSensitive ? *term : TextMatcher::fold_copy(*term);
+        };
+        firstName = prepare(c.firstName);
+        lastName = prepare(c.lastName);
+        position = prepare(c.position);
+        skill = prepare(c.skill);
+
+        if (c.id) fields |= ID;
+        if (c.department) fields |= DEPARTMENT;
+        if (c.status) fields |= STATUS;
+        if (c.minSalary || c.maxSalary) fields |= SALARY;
+        if (c.position) fields |= POSITION;
+        if (c.lastName) fields |= LAST_NAME;
+        if (c.firstName) fields |= FIRST_NAME;
+        if (c.skill) fields |= SKILL;
+        compile();
+    }
 
-            auto employees = table.get_all();
-            file << employees.size() << "\n";
+    bool matches(const Employee& emp) const {
+        for (size_t i = 0; i < check_count; ++i) {
+            if (!checks[i](*this, emp)) return false;
+        }
+        return true;
+    }
 
-            for (const auto& emp : employees) {
-                file << emp.serialize() << "\n";
-            }
+    // Called once a candidate source already guarantees field for every record
+    // it yields, so the per-record check can go
+    void covered(Field field) {
+        fields &= ~field;
+        compile();
+    }
 
-            file.close();
-            Logger::log(Logger::INFO, "Saved " + std::to_string(employees.size()) +
-                       " employees to " + data_file);
-            return true;
-        } catch (const std::exception& e) {
-            Logger::log(Logger::ERROR, "Error saving data: " + std::string(e.what()));
-            return false;
+private:
+    using Check = bool (*)(const QueryPlan&, const Employee&);
+
+    unsigned fields = 0;
+    double min_salary;
+    double max_salary;
+    std::array<Check, 6> checks{};
+    size_t check_count = 0;
+
+    template <bool Department, bool Status, bool Salary>
+    static bool filters(const QueryPlan& plan, const Employee& emp) {
+        if constexpr (Department) {
+            if (emp.department != *plan.criteria.department) return false;
         }
+        if constexpr (Status) {
+            if (emp.status != *plan.criteria.status) return false;
+        }
+        if constexpr (Salary) {
+            if (!(emp.salary >= plan.min_salary && emp.salary <= plan.max_salary)) return false;
+        }
+        return true;
     }
 
-    bool load(EmployeeHashTable& table) {
-        std::lock_guard<std::mutex> lock(file_mutex);
+    static bool id_check(const QueryPlan& plan, const Employee& emp) {
+        return emp.id == *plan.criteria.id;
+    }
 
-        std::ifstream file(data_file);
-        if (!file.is_open()) {
-            Logger::log(Logger::INFO, "Data file not found, starting with empty database");
-            return true;  // Not an error for first run
+    template <bool Exact>
+    static bool contains(std::string_view haystack, const std::string& needle) {
+        if constexpr (Exact) {
+            return haystack.find(needle) != std::string_view::npos;
+        } else {
+            return TextMatcher::contains_folded(haystack, needle);
         }
+    }
 
-        try {
-            size_t count;
-            file >> count;
-            file.ignore();  // Skip newline after count
+    template <bool Exact>
+    static bool position_check(const QueryPlan& plan, const Employee& emp) {
+        return contains<Exact>(emp.position, plan.position);
+    }
 
-            size_t loaded = 0;
-            std::string line;
-            while (std::getline(file, line) && !line.empty()) {
-                try {
-                    Employee emp = Employee::deserialize(line);
-                    if (table.insert(emp)) {
-                        ++loaded;
-                    }
-                } catch (const EmployeeException& e) {
-                    Logger::log(Logger::WARNING, "Failed to load employee record: " +
-                               std::string(e.what()));
-                }
-            }
+    template <bool Exact, std::string Employee::*Name, std::string QueryPlan::*Term>
+    static bool name_check(const QueryPlan& plan, const Employee& emp) {
+        return contains<Exact>(emp.*Name, plan.*Term);
+    }
 
-            file.close();
-            Logger::log(Logger::INFO, "Loaded " + std::to_string(loaded) +
-                       " employees from " + data_file);
-            return true;
-        } catch (const std::exception& e) {
-            Logger::log(Logger::ERROR, "Error loading data: " + std::string(e.what()));
-            return false;
+    template <bool Exact>
+    static bool skill_check(const QueryPlan& plan, const Employee& emp) {
+        for (std::string_view skill : emp.skills) {
+            if (contains<Exact>(skill, plan.skill)) return true;
         }
+        return false;
     }
 
-    bool export_csv(const EmployeeHashTable& table, const std::string& filename) {
-        std::lock_guard<std::mutex> lock(file_mutex);
+    template <bool Exact>
+    void add_text_checks() {
+        if (fields & POSITION) checks[check_count++] = &position_check<Exact>;
+        if (fields & LAST_NAME) checks[check_count++] = &name_check<Exact, &Employee::lastName, &QueryPlan::lastName>;
+        if (fields & FIRST_NAME) checks[check_count++] = &name_check<Exact, &Employee::firstName, &QueryPlan::firstName>;
+        if (fields & SKILL) checks[check_count++] = &skill_check<Exact>;
+    }
 
-        try {
-            std::ofstream file(filename);
-            if (!file.is_open()) {
-                Logger::log(Logger::ERROR, "Failed to open CSV file for writing: " + filename);
-                return false;
-            }
+    void compile() {
+        static constexpr Check FILTERS[8] = {
+            nullptr,
+            &filters<true, false, false>, &filters<false, true, false>, &filters<true, true, false>,
+            &filters<false, false, true>, &filters<true, false, true>, &filters<false, true, true>,
+            &filters<true, true, true>,
+        };
+
+        check_count = 0;
+        if (fields & ID) checks[check_count++] = &id_check;
+        if (Check filter = FILTERS[(fields & (DEPARTMENT | STATUS | SALARY)) >> 1]) checks[check_count++] = filter;
+        if (criteria.caseSensitive) {
+            add_text_checks<true>();
+        } else {
+            add_text_checks<false>();
+        }
+    }
+};
 
-            // Write header
-            file << "ID,FirstName,LastName,Position,Department,Salary,Email,Phone,HireDate,Status,ManagerID,Skills,AccessLevel\n";
+enum class NameField : uint8_t {
+    FIRST_NAME, LAST_NAME, POSITION
+};
 
-            auto employees = table.get_all();
-            for (const auto& emp : employees) {
-                auto time_t = std::chrono::system_clock::to_time_t(emp.hireDate);
-                std::tm* tm_info = std::localtime(&time_t);
-
-                file << emp.id << ","
-                     << emp.firstName << ","
-                     << emp.lastName << ","
-                     << emp.position << ","
-                     << emp.getDepartmentString() << ","
-                     << emp.salary << ","
-                     << emp.email << ","
-                     << emp.phone << ","
-                     << std::put_time(tm_info, "%Y-%m-%d") << ","
-                     << emp.getStatusString() << ","
-                     << emp.managerId << ",\"";
-
-                // Skills in quotes
-                for (size_t i = 0; i < emp.skills.size(); ++i) {
-                    file << emp.skills[i];
-                    if (i < emp.skills.size() - 1) file << ";";
-                }
-                file << "\",";
-                file << emp.getAccessLevelString() << "\n";
-            }
+// One record found by a name lookup. Lower quality is better: 0 when the field
+// equals the query, 1 when it starts with it, 2 when it contains it, and 2 + d
+// when it is d edits away. Case never counts.
+struct NameMatch {
+    Employee employee;
+    NameField field;
+    unsigned quality;
+};
 
-            file.close();
-            Logger::log(Logger::INFO, "Exported " + std::to_string(employees.size()) +
-                       " employees to CSV: " + filename);
-            return true;
-        } catch (const std::exception& e) {
-            Logger::log(Logger::ERROR, "Error exporting CSV: " + std::string(e.what()));
-            return false;
+// ==================== SORTED LISTINGS ====================
+
+enum class SortKey {
+    ID, NAME, SALARY, HIRE_DATE
+};
+
+// Integer images of sort keys whose unsigned order matches the original order,
+// so tree comparisons stay in the node instead of chasing the record
+inline uint64_t ordered_bits(int64_t value) {
+    return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+inline uint64_t ordered_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+// First eight bytes, big-endian and zero-padded: unequal prefixes order exactly
+// as the full strings do
+inline uint64_t packed_prefix(std::string_view text) {
+    uint64_t packed = 0;
+    for (size_t i = 0; i < sizeof(packed); ++i) {
+        packed = (packed << 8) | (i < text.size() ? static_cast<unsigned char>(text[i]) : 0);
+    }
+    return packed;
+}
+
+// One record's place in a sorted index. IDs fit the packed prefix whole, so
+// they are the tie-breaker that makes every position, and every page cursor,
+// unique.
+struct SortEntry {
+    uint64_t primary;
+    uint64_t id;
+    const Employee* record;
+};
+
+template <SortKey Key>
+struct RecordOrder {
+    static SortEntry entry(const Employee& emp) {
+        uint64_t primary = 0;
+        if constexpr (Key == SortKey::NAME) {
+            primary = packed_prefix(emp.lastName);
+        } else if constexpr (Key == SortKey::SALARY) {
+            primary = ordered_bits(emp.salary);
+        } else if constexpr (Key == SortKey::HIRE_DATE) {
+            primary = ordered_bits(static_cast<int64_t>(emp.hireDate.time_since_epoch().count()));
+        }
+        return SortEntry{primary, packed_prefix(emp.id.view()), &emp};
+    }
+
+    bool operator()(const SortEntry& a, const SortEntry& b) const {
+        if (a.primary != b.primary) return a.primary < b.primary;
+        if constexpr (Key == SortKey::NAME) {
+            // Same eight-byte prefix: settle on last then first name in full
+            int order = a.record->lastName.compare(b.record->lastName);
+            if (order == 0) order = a.record->firstName.compare(b.record->firstName);
+            if (order != 0) return order < 0;
         }
+        return a.id < b.id;
     }
 };
 
-// ==================== ADVANCED CLI INTERFACE ====================
+// Also answers salary-only probes, for range searches
+struct SalaryOrder : RecordOrder<SortKey::SALARY> {
+    using is_transparent = void;
+    using RecordOrder::operator();
+    bool operator()(const SortEntry& entry, double salary) const { return entry.primary < ordered_bits(salary); }
+    bool operator()(double salary, const SortEntry& entry) const { return ordered_bits(salary) < entry.primary; }
+};
 
-class AdvancedCLI {
-private:
-    EmployeeHashTable& db;
-    DataManager data_manager;
-    std::unique_ptr<Employee> currentUser;
+// One screen of a sorted listing. after is a copy of the last record of the
+// previous page, so paging resumes strictly past it even if that record has
+// since been updated or removed.
+struct PageRequest {
+    SortKey key = SortKey::ID;
+    bool descending = false;
+    size_t size = 20;
+    std::optional<Employee> after;
+};
 
-    void clear_screen() {
-        #ifdef _WIN32
-            system("cls");
-        #else
-            system("clear");
-        #endif
+struct EmployeePage {
+    std::vector<Employee> employees;
+    bool has_more = false;
+};
+
+// ==================== STORAGE BACKENDS ====================
+
+enum class StorageBackend {
+    CHAINED, OPEN_ADDRESSING
+};
+
+// High-quality hash function (FNV-1a); each backend maps it onto its own bucket layout
+inline size_t fnv1a_hash(std::string_view key) {
+    const size_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const size_t FNV_PRIME = 1099511628211ULL;
+
+    size_t hash_value = FNV_OFFSET_BASIS;
+    for (char c : key) {
+        hash_value ^= static_cast<size_t>(c);
+        hash_value *= FNV_PRIME;
+    }
+    return hash_value;
+}
+
+// Chunked object pool addressed by 32-bit index. Objects are built in place in
+// CHUNK_SIZE-object chunks and never move, so an index or pointer stays valid
+// until release(); freed entries are reused before the pool grows. Allocation is
+// a free-list pop or a bump, and tearing the pool down frees one block per chunk
+// rather than one per object.
+//
+// An entry is FREE, LIVE or DETACHED. Detached entries are still allocated but
+// skipped by for_each_live(), which is how stores keep replaced or removed
+// records readable until the reclaimer lets them go.
+template <typename T>
+class RecordSlab {
+public:
+    static constexpr size_t CHUNK_BITS = 10;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+
+    RecordSlab() = default;
+    ~RecordSlab() { clear(); }
+    RecordSlab(const RecordSlab&) = delete;
+    RecordSlab& operator=(const RecordSlab&) = delete;
+
+    template <typename... Args>
+    uint32_t allocate(Args&&... args) {
+        uint32_t index;
+        if (!free_list.empty()) {
+            index = free_list.back();
+            free_list.pop_back();
+        } else {
+            if (state.size() >= std::numeric_limits<uint32_t>::max()) {
+                throw EmployeeException("Record slab exhausted");
+            }
+            index = static_cast<uint32_t>(state.size());
+            if ((index & (CHUNK_SIZE - 1)) == 0) chunks.emplace_back(new Storage[CHUNK_SIZE]);
+            state.push_back(FREE);
+        }
+        new (address(index)) T(std::forward<Args>(args)...);
+        state[index] = LIVE;
+        ++allocated;
+        return index;
     }
 
-    void pause() {
-        std::cout << "\nPress Enter to continue...";
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        std::cin.get();
+    void detach(uint32_t index) { state[index] = DETACHED; }
+
+    void release(uint32_t index) {
+        std::launder(address(index))->~T();
+        state[index] = FREE;
+        free_list.push_back(index);
+        --allocated;
     }
 
-    std::string get_input(const std::string& prompt) {
-        std::cout << prompt;
-        std::string input;
-        std::getline(std::cin, input);
-        return input;
+    T& operator[](uint32_t index) const { return *std::launder(address(index)); }
+
+    // Live entries in index order, which is allocation order until entries are reused
+    template <typename Visit>
+    void for_each_live(Visit&& visit) const {
+        for (size_t index = 0; index < state.size(); ++index) {
+            if (state[index] == LIVE) visit(static_cast<uint32_t>(index));
+        }
     }
 
-    double get_double_input(const std::string& prompt) {
-        while (true) {
-            try {
-                std::cout << prompt;
-                std::string input;
-                std::getline(std::cin, input);
-                return std::stod(input);
-            } catch (const std::exception&) {
-                std::cout << "Invalid number. Please try again.\n";
-            }
+    // As for_each_live(), stopping at the first visit that returns false;
+    // returns whether every live entry was visited
+    template <typename Visit>
+    bool for_each_live_until(Visit&& visit) const {
+        for (size_t index = 0; index < state.size(); ++index) {
+            if (state[index] == LIVE && !visit(static_cast<uint32_t>(index))) return false;
         }
+        return true;
     }
 
-    int get_int_input(const std::string& prompt, int min_val = 0, int max_val = INT_MAX) {
-        while (true) {
-            try {
-                std::cout << prompt;
-                std::string input;
-                std::getline(std::cin, input);
-                int value = std::stoi(input);
-                if (value >= min_val && value <= max_val) {
-                    return value;
-                }
-                std::cout << "Value must be between " << min_val << " and " << max_val << ".\n";
-            } catch (const std::exception&) {
-                std::cout << "Invalid number. Please try again.\n";
+    // Destroys every entry and returns all chunks; objects without a destructor
+    // are not visited at all
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t index = 0; index < state.size(); ++index) {
+                if (state[index] != FREE) std::launder(address(static_cast<uint32_t>(index)))->~T();
             }
         }
+        chunks.clear();
+        state.clear();
+        free_list.clear();
+        allocated = 0;
     }
 
-    Department get_department_input() {
-        std::cout << "\nDepartments:\n"
-                  << "1. Engineering\n2. HR\n3. Finance\n4. Marketing\n5. Operations\n6. Sales\n";
-        int choice = get_int_input("Select department (1-6): ", 1, 6);
-        return static_cast<Department>(choice - 1);
+    size_t size() const { return allocated; }            // Live plus detached
+    size_t capacity() const { return chunks.size() * CHUNK_SIZE; }
+    size_t free_count() const { return free_list.size(); }
+
+    size_t memory_bytes() const {
+        return capacity() * sizeof(T) + chunks.capacity() * sizeof(chunks[0]) + state.capacity() +
+               free_list.capacity() * sizeof(uint32_t);
     }
 
-    EmployeeStatus get_status_input() {
-        std::cout << "\nStatus options:\n"
-                  << "1. Active\n2. Inactive\n3. On Leave\n4. Terminated\n";
-        int choice = get_int_input("Select status (1-4): ", 1, 4);
-        return static_cast<EmployeeStatus>(choice - 1);
+private:
+    enum EntryState : uint8_t { FREE, LIVE, DETACHED };
+
+    struct alignas(T) Storage {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Storage[]>> chunks;
+    std::vector<uint8_t> state;
+    std::vector<uint32_t> free_list;
+    size_t allocated = 0;
+
+    T* address(uint32_t index) const {
+        return reinterpret_cast<T*>(chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)].bytes);
     }
+};
 
-    AccessLevel get_access_level_input() {
-        std::cout << "\nAccess Level:\n"
-                  << "1. Basic\n2. Admin\n";
-        int choice = get_int_input("Select access level (1-2): ", 1, 2);
-        return static_cast<AccessLevel>(choice - 1);
+// Physical layout behind EmployeeHashTable. Stores are not thread-safe; the table
+// owns locking, validation and logging, and decides when to grow.
+class EmployeeStore {
+public:
+    virtual ~EmployeeStore() = default;
+
+    virtual StorageBackend backend() const = 0;
+    virtual const char* backend_name() const = 0;
+
+    // Returns the stored record, or nullptr if the ID is already present
+    virtual Employee* insert(Employee&& emp) = 0;
+    virtual Employee* find(const std::string& id) const = 0;
+
+    // detach() and replace() unlink a record from the index but keep it allocated
+    // until release(handle), so readers that still hold it are not left dangling
+    struct Detached {
+        const Employee* record = nullptr;
+        size_t handle = 0;
+        explicit operator bool() const { return record != nullptr; }
+    };
+    virtual Detached detach(const std::string& id) = 0;
+    virtual Detached replace(const std::string& id, Employee&& updated) = 0;
+    virtual void release(size_t handle) = 0;
+
+    bool erase(const std::string& id) {
+        Detached removed = detach(id);
+        if (removed) release(removed.handle);
+        return static_cast<bool>(removed);
     }
 
-    std::vector<std::string> get_skills_input() {
-        std::vector<std::string> skills;
-        std::string skills_str = get_input("Enter skills (comma-separated): ");
+    virtual void for_each(const std::function<void(const Employee&)>& visit) const = 0;
+    // Stops as soon as visit returns false; returns whether every record was visited
+    virtual bool for_each_until(const std::function<bool(const Employee&)>& visit) const = 0;
+
+    virtual size_t size() const = 0;
+    virtual size_t bucket_count() const = 0;
+    virtual double max_load_factor() const = 0;
+    virtual void write_statistics(std::ostream& os) const = 0;
+
+    // Bytes allocated for buckets or slots, bookkeeping and the sizeof(Employee)
+    // part of every record, including detached ones not yet released
+    virtual size_t memory_bytes() const = 0;
+
+    // Maintained on every mutation so statistics never walk the buckets. Entry d
+    // counts buckets holding d records (chaining) or records d slots from home
+    // (open addressing); trailing entries may be zero.
+    virtual const std::vector<size_t>& occupancy_histogram() const = 0;
+    virtual const char* histogram_label() const = 0;
+
+protected:
+    static void histogram_add(std::vector<size_t>& histogram, size_t bucket) {
+        if (bucket >= histogram.size()) histogram.resize(bucket + 1, 0);
+        ++histogram[bucket];
+    }
 
-        if (!skills_str.empty()) {
-            std::istringstream iss(skills_str);
-            std::string skill;
-            while (std::getline(iss, skill, ',')) {
-                // Trim whitespace
-                skill.erase(0, skill.find_first_not_of(" \t"));
-                skill.erase(skill.find_last_not_of(" \t") + 1);
-                if (!skill.empty()) {
-                    skills.push_back(skill);
-                }
-            }
-        }
+    static void histogram_move(std::vector<size_t>& histogram, size_t from, size_t to) {
+        --histogram[from];
+        histogram_add(histogram, to);
+    }
 
-        return skills;
+public:
+
+    // Growth is split in two so the expensive half can run while readers still use
+    // the current layout: prepare_growth() only reads, commit_growth() mutates and
+    // either leaves the old layout in the plan to be freed outside any lock or
+    // keeps it until later mutations have drained it. A plan at least doubles the
+    // bucket count and reaches min_bucket_count if that is larger.
+    struct GrowthPlan {
+        virtual ~GrowthPlan() = default;
+    };
+    virtual std::unique_ptr<GrowthPlan> prepare_growth(size_t min_bucket_count) const = 0;
+    virtual void commit_growth(GrowthPlan& plan) = 0;
+
+    void grow() {
+        commit_growth(*prepare_growth(0));
     }
 
-    void display_employee(const Employee& emp) {
-        auto time_t = std::chrono::system_clock::to_time_t(emp.hireDate);
+    double load_factor() const {
+        return bucket_count() ? static_cast<double>(size()) / bucket_count() : 0.0;
+    }
 
-        std::cout << "\n" << std::string(60, '=') << "\n";
-        std::cout << "Employee Details\n";
-        std::cout << std::string(60, '=') << "\n";
-        std::cout << std::left << std::setw(15) << "ID:" << emp.id << "\n";
-        std::cout << std::left << std::setw(15) << "Name:" << emp.getFullName() << "\n";
-        std::cout << std::left << std::setw(15) << "Position:" << emp.position << "\n";
-        std::cout << std::left << std::setw(15) << "Department:" << emp.getDepartmentString() << "\n";
-        std::cout << std::left << std::setw(15) << "Salary:" << "$" << std::fixed << std::setprecision(2) << emp.salary << "\n";
-        std::cout << std::left << std::setw(15) << "Email:" << (emp.email.empty() ? "N/A" : emp.email) << "\n";
-        std::cout << std::left << std::setw(15) << "Phone:" << (emp.phone.empty() ? "N/A" : emp.phone) << "\n";
-        std::cout << std::left << std::setw(15) << "Hire Date:" << std::put_time(std::localtime(&time_t), "%Y-%m-%d") << "\n";
-        std::cout << std::left << std::setw(15) << "Status:" << emp.getStatusString() << "\n";
-        std::cout << std::left << std::setw(15) << "Manager ID:" << (emp.managerId.empty() ? "N/A" : emp.managerId) << "\n";
-        std::cout << std::left << std::setw(15) << "Access Level:" << emp.getAccessLevelString() << "\n";
-        std::cout << std::left << std::setw(15) << "Skills:";
-        if (emp.skills.empty()) {
-            std::cout << "None\n";
-        } else {
-            for (size_t i = 0; i < emp.skills.size(); ++i) {
-                if (i == 0) std::cout << emp.skills[i];
-                else std::cout << ", " << emp.skills[i];
-            }
-            std::cout << "\n";
+    static std::unique_ptr<EmployeeStore> create(StorageBackend backend, size_t initial_bucket_count);
+};
+
+// Separate chaining over power-of-two bucket arrays. Nodes and records live in
+// two slabs and chains link by node index; each node caches its mixed hash, so
+// growing relinks the existing nodes instead of reallocating them.
+//
+// Growth is incremental: the old and new bucket arrays coexist and every
+// mutation moves a few old buckets across, so no single insert pays for the
+// whole table. Old bucket i feeds exactly the new buckets i, i + old size, ...,
+// which are initialized only when it moves, so starting a resize is O(1).
+class ChainedEmployeeStore : public EmployeeStore {
+private:
+    static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MIN_BUCKETS = 16;
+    // Growth starts at load 0.75 of the old table and the next one at 0.75 of
+    // the doubled table, so any step of at least 2 finishes in time even for a
+    // pure insert workload
+    static constexpr size_t MIGRATE_BUCKETS_PER_STEP = 16;
+
+    struct HashNode {
+        size_t hash_value;
+        uint32_t record;
+        uint32_t next;
+    };
+
+    std::unique_ptr<uint32_t[]> table;  // Head node of each bucket
+    size_t table_mask;
+    // Non-null while a resize is in progress. Buckets below migrate_cursor have
+    // moved to table; the rest still hold their chains here.
+    std::unique_ptr<uint32_t[]> old_table;
+    size_t old_mask;
+    size_t migrate_cursor;
+
+    RecordSlab<HashNode> nodes;
+    RecordSlab<Employee> records;
+    size_t element_count;
+    std::vector<size_t> chain_lengths;  // Over live buckets: unmoved old plus initialized new
+
+    // FNV-1a's low bits are weak and buckets are picked by mask, so every hash
+    // goes through the MurmurHash3 finalizer first
+    static size_t hash_of(const std::string& id) {
+        uint64_t h = fnv1a_hash(id);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    static size_t round_up_pow2(size_t n) {
+        size_t count = MIN_BUCKETS;
+        while (count < n) count <<= 1;
+        return count;
+    }
+
+    // The single bucket a hash can live in right now
+    uint32_t* bucket(size_t hash_value) const {
+        if (old_table) {
+            size_t old_index = hash_value & old_mask;
+            if (old_index >= migrate_cursor) return &old_table[old_index];
         }
-        std::cout << std::string(60, '=') << "\n";
+        return &table[hash_value & table_mask];
     }
 
-    void display_employees_table(const std::vector<Employee>& employees) {
-        if (employees.empty()) {
-            std::cout << "\nNo employees found.\n";
-            return;
+    static size_t chain_length_from(const RecordSlab<HashNode>& nodes, uint32_t head) {
+        size_t length = 0;
+        for (uint32_t current = head; current != NO_NODE; current = nodes[current].next) ++length;
+        return length;
+    }
+
+    size_t live_bucket_count() const {
+        if (!old_table) return table_mask + 1;
+        size_t fan_out = (table_mask + 1) / (old_mask + 1);
+        return (old_mask + 1 - migrate_cursor) + migrate_cursor * fan_out;
+    }
+
+    void migrate_bucket() {
+        size_t old_size = old_mask + 1;
+        size_t source = migrate_cursor++;
+
+        for (size_t target = source; target <= table_mask; target += old_size) table[target] = NO_NODE;
+
+        size_t moved = 0;
+        for (uint32_t current = old_table[source]; current != NO_NODE; ++moved) {
+            HashNode& node = nodes[current];
+            uint32_t next = node.next;
+            uint32_t& head = table[node.hash_value & table_mask];
+            node.next = head;
+            head = current;
+            current = next;
         }
 
-        std::cout << "\n" << std::string(140, '=') << "\n";
-        std::cout << std::left
-                  << std::setw(8) << "ID"
-                  << std::setw(20) << "Name"
-                  << std::setw(20) << "Position"
-                  << std::setw(15) << "Department"
-                  << std::setw(12) << "Salary"
-                  << std::setw(25) << "Email"
-                  << std::setw(12) << "Status"
-                  << std::setw(10) << "Manager"
-                  << std::setw(10) << "Access"
-                  << "Skills\n";
-        std::cout << std::string(140, '-') << "\n";
+        --chain_lengths[moved];
+        for (size_t target = source; target <= table_mask; target += old_size) {
+            histogram_add(chain_lengths, chain_length_from(nodes, table[target]));
+        }
 
-        for (const auto& emp : employees) {
-            std::cout << std::left
-                      << std::setw(8) << emp.id
-                      << std::setw(20) << (emp.getFullName().length() > 19 ?
-                                         emp.getFullName().substr(0, 16) + "..." : emp.getFullName())
-                      << std::setw(20) << (emp.position.length() > 19 ?
-                                         emp.position.substr(0, 16) + "..." : emp.position)
-                      << std::setw(15) << emp.getDepartmentString()
-                      << std::setw(12) << ("$" + std::to_string(static_cast<int>(emp.salary)))
-                      << std::setw(25) << (emp.email.length() > 24 ?
-                                         emp.email.substr(0, 21) + "..." :
-                                         (emp.email.empty() ? "N/A" : emp.email))
-                      << std::setw(12) << emp.getStatusString()
-                      << std::setw(10) << (emp.managerId.empty() ? "N/A" : emp.managerId)
-                      << std::setw(10) << emp.getAccessLevelString()
-                      << (emp.skills.empty() ? "None" : emp.skills.at(0)) << "\n";
+        if (migrate_cursor == old_size) old_table.reset();
+    }
+
+    void migrate_step() {
+        for (size_t step = 0; old_table && step < MIGRATE_BUCKETS_PER_STEP; ++step) migrate_bucket();
+    }
+
+    uint32_t find_node(const std::string& id) const {
+        size_t hash_value = hash_of(id);
+        for (uint32_t current = *bucket(hash_value); current != NO_NODE; current = nodes[current].next) {
+            const HashNode& node = nodes[current];
+            if (node.hash_value == hash_value && records[node.record].id == id) return current;
         }
-        std::cout << std::string(140, '=') << "\n";
-        std::cout << "Total employees: " << employees.size() << "\n";
+        return NO_NODE;
     }
 
-public:
-    explicit AdvancedCLI(EmployeeHashTable& database) : db(database) {
-        Logger::init();
-        data_manager.load(db);
+    Detached keep_detached(uint32_t record) {
+        records.detach(record);
+        return Detached{&records[record], record};
     }
 
-    ~AdvancedCLI() {
-        data_manager.save(db);
+public:
+    explicit ChainedEmployeeStore(size_t initial_bucket_count)
+        : table_mask(round_up_pow2(initial_bucket_count) - 1), old_mask(0), migrate_cursor(0), element_count(0),
+          chain_lengths{table_mask + 1} {
+        table.reset(new uint32_t[table_mask + 1]);
+        std::fill_n(table.get(), table_mask + 1, NO_NODE);
     }
 
-    void run() {
-        std::cout << "\n" << std::string(60, '=') << "\n";
-        std::cout << "      ENTERPRISE EMPLOYEE MANAGEMENT SYSTEM\n";
-        std::cout << std::string(60, '=') << "\n";
-        
-        if (!login()) {
-            std::cout << "\nInvalid login. Exiting.\n";
-            return;
+    StorageBackend backend() const override { return StorageBackend::CHAINED; }
+    const char* backend_name() const override { return "Chained"; }
+
+    Employee* insert(Employee&& emp) override {
+        migrate_step();
+        size_t hash_value = hash_of(emp.id);
+        uint32_t* head = bucket(hash_value);
+
+        // Check for duplicates
+        size_t chain_length = 0;
+        for (uint32_t current = *head; current != NO_NODE; current = nodes[current].next) {
+            const HashNode& node = nodes[current];
+            if (node.hash_value == hash_value && records[node.record].id == emp.id) {
+                return nullptr;  // Duplicate found
+            }
+            ++chain_length;
         }
 
-        while (true) {
-            try {
-                show_main_menu();
-                int choice = 0;
-                if (currentUser->accessLevel == AccessLevel::ADMIN) {
-                    choice = get_int_input("\nSelect option (1-13): ", 1, 13);
-                } else {
-                    choice = get_int_input("\nSelect option (1-7): ", 1, 7);
-                }
+        // Insert at head
+        uint32_t record = records.allocate(std::move(emp));
+        *head = nodes.allocate(HashNode{hash_value, record, *head});
+        ++element_count;
+        histogram_move(chain_lengths, chain_length, chain_length + 1);
 
-                if (currentUser->accessLevel == AccessLevel::ADMIN) {
-                    switch (choice) {
-                        case 1: add_employee(); break;
-                        case 2: remove_employee(); break;
-                        case 3: update_employee(); break;
-                        case 4: find_employee(); break;
-                        case 5: advanced_search(); break;
-                        case 6: display_all_employees(); break;
-                        case 7: generate_reports(); break;
-                        case 8: import_export_menu(); break;
-                        case 9: system_statistics(); break;
-                        case 10: data_management(); break;
-                        case 11: help_documentation(); break;
-                        case 12: edit_my_profile(); break;
-                        case 13:
-                            std::cout << "\nSaving data and exiting...\n";
-                            data_manager.save(db);
-                            return;
-                    }
-                } else { // Basic user
-                    switch (choice) {
-                        case 1: find_employee(); break;
-                        case 2: advanced_search(); break;
-                        case 3: display_all_employees(); break;
-                        case 4: generate_reports(); break;
-                        case 5: help_documentation(); break;
-                        case 6: edit_my_profile(); break;
-                        case 7:
-                            std::cout << "\nSaving data and exiting...\n";
-                            data_manager.save(db);
-                            return;
-                        default:
-                            std::cout << "\nInvalid option for a basic user. Please try again.\n";
-                            pause();
-                    }
-                }
-            } catch (const EmployeeException& e) {
-                std::cout << "\nError: " << e.what() << "\n";
-                pause();
-            } catch (const std::exception& e) {
-                std::cout << "\nUnexpected error: " << e.what() << "\n";
-                Logger::log(Logger::CRITICAL, "Unexpected error: " + std::string(e.what()));
-                pause();
+        return &records[record];
+    }
+
+    Employee* find(const std::string& id) const override {
+        uint32_t node = find_node(id);
+        return node == NO_NODE ? nullptr : &records[nodes[node].record];
+    }
+
+    Detached detach(const std::string& id) override {
+        migrate_step();
+        size_t hash_value = hash_of(id);
+        uint32_t* link = bucket(hash_value);
+        size_t position = 0;
+
+        while (*link != NO_NODE) {
+            uint32_t current = *link;
+            const HashNode& node = nodes[current];
+            if (node.hash_value == hash_value && records[node.record].id == id) {
+                size_t chain_length = position + 1 + chain_length_from(nodes, node.next);
+                uint32_t record = node.record;
+                *link = node.next;
+                nodes.release(current);
+                --element_count;
+                histogram_move(chain_lengths, chain_length, chain_length - 1);
+                return keep_detached(record);
             }
+            link = &nodes[current].next;
+            ++position;
         }
+        return Detached{};
     }
 
-private:
-    bool login() {
-        int attempts = 3;
+    Detached replace(const std::string& id, Employee&& updated) override {
+        migrate_step();
+        uint32_t node = find_node(id);
+        if (node == NO_NODE) return Detached{};
+
+        uint32_t previous = nodes[node].record;
+        nodes[node].record = records.allocate(std::move(updated));
+        return keep_detached(previous);
+    }
+
+    void release(size_t handle) override {
+        records.release(static_cast<uint32_t>(handle));
+    }
+
+    void for_each(const std::function<void(const Employee&)>& visit) const override {
+        // Walk the record slab rather than the chains so scans stay sequential
+        records.for_each_live([&](uint32_t record) { visit(records[record]); });
+    }
+
+    bool for_each_until(const std::function<bool(const Employee&)>& visit) const override {
+        return records.for_each_live_until([&](uint32_t record) { return visit(records[record]); });
+    }
+
+    size_t size() const override { return element_count; }
+    size_t bucket_count() const override { return table_mask + 1; }
+    double max_load_factor() const override { return 0.75; }
+
+    // The new bucket array is allocated but left uninitialized; migration fills
+    // each bucket before anything can land in it
+    struct ChainedGrowthPlan : GrowthPlan {
+        std::unique_ptr<uint32_t[]> new_table;
+        size_t new_bucket_count = 0;
+    };
+
+    std::unique_ptr<GrowthPlan> prepare_growth(size_t min_bucket_count) const override {
+        auto plan = std::make_unique<ChainedGrowthPlan>();
+        plan->new_bucket_count = round_up_pow2(std::max((table_mask + 1) * 2, min_bucket_count));
+        plan->new_table.reset(new uint32_t[plan->new_bucket_count]);
+        return plan;
+    }
+
+    void commit_growth(GrowthPlan& plan) override {
+        auto& chained_plan = static_cast<ChainedGrowthPlan&>(plan);
+
+        // A resize requested mid-migration finishes the current one first
+        while (old_table) migrate_bucket();
+
+        old_table = std::move(table);
+        old_mask = table_mask;
+        migrate_cursor = 0;
+        table = std::move(chained_plan.new_table);
+        table_mask = chained_plan.new_bucket_count - 1;
+
+        // Only reserve() asks for more than a doubling, and it is already paying
+        // for a bulk load, so its fan-out is not spread over later mutations
+        if (chained_plan.new_bucket_count > 2 * (old_mask + 1)) {
+            while (old_table) migrate_bucket();
+        }
+    }
+
+    size_t memory_bytes() const override {
+        size_t buckets = table_mask + 1 + (old_table ? old_mask + 1 : 0);
+        return buckets * sizeof(uint32_t) + chain_lengths.capacity() * sizeof(size_t) +
+               nodes.memory_bytes() + records.memory_bytes();
+    }
+
+    const std::vector<size_t>& occupancy_histogram() const override { return chain_lengths; }
+    const char* histogram_label() const override { return "Chain Lengths"; }
+
+    void write_statistics(std::ostream& os) const override {
+        size_t max_chain_length = 0;
+        size_t empty_buckets = chain_lengths[0];
+        size_t live_buckets = live_bucket_count();
+
+        for (size_t length = 0; length < chain_lengths.size(); ++length) {
+            if (chain_lengths[length]) max_chain_length = length;
+        }
+
+        // Every stored record sits in exactly one non-empty chain
+        double avg_chain_length = (live_buckets - empty_buckets > 0) ?
+            static_cast<double>(element_count) / (live_buckets - empty_buckets) : 0;
+
+        os << "  Empty Buckets: " << empty_buckets << " ("
+           << std::fixed << std::setprecision(1) << (100.0 * empty_buckets / live_buckets) << "%)\n"
+           << "  Max Chain Length: " << max_chain_length << "\n"
+           << "  Avg Chain Length: " << std::fixed << std::setprecision(2) << avg_chain_length << "\n";
+        if (old_table) {
+            os << "  Rehash In Progress: " << migrate_cursor << "/" << (old_mask + 1) << " old buckets moved\n";
+        }
+        os << "  Slab Records: " << records.capacity() << " (" << (records.capacity() - records.size()) << " free, "
+           << (records.size() - element_count) << " awaiting reclamation)\n";
+    }
+};
+
+// Robin Hood open addressing over a power-of-two slot array. Slots are 8 bytes and
+// only point into a record slab; records never move once placed, so growing
+// rebuilds the slot array alone.
+class FlatEmployeeStore : public EmployeeStore {
+private:
+    static constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t MIN_SLOTS = 16;
+
+    // The upper bits of the fingerprint are the home slot, so probe distance is
+    // derived rather than stored
+    struct Slot {
+        uint32_t fingerprint = 0;
+        uint32_t record = EMPTY_SLOT;
+    };
+
+    std::vector<Slot> slots;
+    size_t slot_mask;
+    unsigned slot_shift;
+
+    RecordSlab<Employee> records;
+    size_t element_count;
+    std::vector<size_t> probe_distances;
+
+    static uint32_t fingerprint(const std::string& id) {
+        // Fibonacci mixing spreads FNV-1a's weak high bits before they pick the slot
+        return static_cast<uint32_t>((static_cast<uint64_t>(fnv1a_hash(id)) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    size_t home(uint32_t fp) const { return fp >> slot_shift; }
+    size_t distance(size_t pos, uint32_t fp) const { return (pos - home(fp)) & slot_mask; }
+
+    Employee& record(uint32_t index) const { return records[index]; }
+
+    static unsigned shift_for(size_t count) {
+        unsigned shift = 32;
+        while ((size_t(1) << (32 - shift)) < count) --shift;
+        return shift;
+    }
+
+    void reset_slots(size_t count) {
+        slots.assign(count, Slot{});
+        slot_mask = count - 1;
+        slot_shift = shift_for(count);
+    }
+
+    size_t find_slot(const std::string& id, uint32_t fp) const {
+        size_t pos = home(fp);
+        for (size_t dist = 0;; ++dist) {
+            const Slot& slot = slots[pos];
+            if (slot.record == EMPTY_SLOT || distance(pos, slot.fingerprint) < dist) {
+                return slots.size();
+            }
+            if (slot.fingerprint == fp && record(slot.record).id == id) {
+                return pos;
+            }
+            pos = (pos + 1) & slot_mask;
+        }
+    }
+
+    static void place(std::vector<Slot>& target, unsigned shift, Slot incoming,
+                      std::vector<size_t>& distances) {
+        size_t mask = target.size() - 1;
+        size_t pos = incoming.fingerprint >> shift;
+        size_t dist = 0;
+        while (true) {
+            Slot& slot = target[pos];
+            if (slot.record == EMPTY_SLOT) {
+                slot = incoming;
+                histogram_add(distances, dist);
+                return;
+            }
+            size_t resident = (pos - (slot.fingerprint >> shift)) & mask;
+            if (resident < dist) {
+                // The displaced record is counted again wherever it lands
+                std::swap(slot, incoming);
+                histogram_move(distances, resident, dist);
+                dist = resident;
+            }
+            pos = (pos + 1) & mask;
+            ++dist;
+        }
+    }
+
+    static size_t round_up_pow2(size_t n) {
+        size_t count = MIN_SLOTS;
+        while (count < n) count <<= 1;
+        return count;
+    }
+
+public:
+    explicit FlatEmployeeStore(size_t initial_bucket_count) : element_count(0), probe_distances(1, 0) {
+        reset_slots(round_up_pow2(initial_bucket_count));
+    }
+
+    StorageBackend backend() const override { return StorageBackend::OPEN_ADDRESSING; }
+    const char* backend_name() const override { return "Open Addressing (Robin Hood)"; }
+
+    Employee* insert(Employee&& emp) override {
+        uint32_t fp = fingerprint(emp.id);
+        if (find_slot(emp.id, fp) != slots.size()) {
+            return nullptr;  // Duplicate found
+        }
+
+        uint32_t index = records.allocate(std::move(emp));
+        place(slots, slot_shift, Slot{fp, index}, probe_distances);
+        ++element_count;
+        return &record(index);
+    }
+
+    Employee* find(const std::string& id) const override {
+        size_t pos = find_slot(id, fingerprint(id));
+        return pos == slots.size() ? nullptr : &record(slots[pos].record);
+    }
+
+    // Detached records drop out of scans immediately but keep their slab slot
+    // until release()
+    Detached detach(const std::string& id) override {
+        size_t pos = find_slot(id, fingerprint(id));
+        if (pos == slots.size()) return Detached{};
+
+        uint32_t index = slots[pos].record;
+        records.detach(index);
+        --probe_distances[distance(pos, slots[pos].fingerprint)];
+
+        // Backward-shift deletion keeps probe sequences tombstone-free
+        while (true) {
+            size_t next = (pos + 1) & slot_mask;
+            const Slot& follower = slots[next];
+            size_t follower_distance = follower.record == EMPTY_SLOT ? 0 : distance(next, follower.fingerprint);
+            if (follower_distance == 0) {
+                slots[pos] = Slot{};
+                break;
+            }
+            histogram_move(probe_distances, follower_distance, follower_distance - 1);
+            slots[pos] = follower;
+            pos = next;
+        }
+
+        --element_count;
+        return Detached{&record(index), index};
+    }
+
+    Detached replace(const std::string& id, Employee&& updated) override {
+        size_t pos = find_slot(id, fingerprint(id));
+        if (pos == slots.size()) return Detached{};
+
+        uint32_t previous = slots[pos].record;
+        slots[pos].record = records.allocate(std::move(updated));
+        records.detach(previous);
+        return Detached{&record(previous), previous};
+    }
+
+    void release(size_t handle) override {
+        records.release(static_cast<uint32_t>(handle));
+    }
+
+    void for_each(const std::function<void(const Employee&)>& visit) const override {
+        // Walk the slab rather than the slots so scans stay sequential in memory
+        records.for_each_live([&](uint32_t index) { visit(records[index]); });
+    }
+
+    bool for_each_until(const std::function<bool(const Employee&)>& visit) const override {
+        return records.for_each_live_until([&](uint32_t index) { return visit(records[index]); });
+    }
+
+    size_t size() const override { return element_count; }
+    size_t bucket_count() const override { return slots.size(); }
+    double max_load_factor() const override { return 0.875; }
+
+    // Records stay in the slab, so the whole new slot array is built off to the
+    // side and the commit is a swap
+    struct FlatGrowthPlan : GrowthPlan {
+        std::vector<Slot> new_slots;
+        std::vector<size_t> new_distances{0};
+        unsigned new_shift = 0;
+    };
+
+    std::unique_ptr<GrowthPlan> prepare_growth(size_t min_bucket_count) const override {
+        auto plan = std::make_unique<FlatGrowthPlan>();
+        plan->new_slots.assign(round_up_pow2(std::max(slots.size() * 2, min_bucket_count)), Slot{});
+        plan->new_shift = shift_for(plan->new_slots.size());
+        for (const auto& slot : slots) {
+            if (slot.record != EMPTY_SLOT) place(plan->new_slots, plan->new_shift, slot, plan->new_distances);
+        }
+        return plan;
+    }
+
+    void commit_growth(GrowthPlan& plan) override {
+        auto& flat_plan = static_cast<FlatGrowthPlan&>(plan);
+        slots.swap(flat_plan.new_slots);
+        probe_distances.swap(flat_plan.new_distances);
+        slot_mask = slots.size() - 1;
+        slot_shift = flat_plan.new_shift;
+    }
+
+    size_t memory_bytes() const override {
+        return slots.capacity() * sizeof(Slot) + records.memory_bytes() + probe_distances.capacity() * sizeof(size_t);
+    }
+
+    const std::vector<size_t>& occupancy_histogram() const override { return probe_distances; }
+    const char* histogram_label() const override { return "Probe Distances"; }
+
+    void write_statistics(std::ostream& os) const override {
+        size_t max_probe = 0;
+        size_t total_probe = 0;
+
+        for (size_t dist = 0; dist < probe_distances.size(); ++dist) {
+            if (probe_distances[dist]) max_probe = dist;
+            total_probe += dist * probe_distances[dist];
+        }
+
+        size_t empty_slots = slots.size() - element_count;
+        double avg_probe = element_count ? static_cast<double>(total_probe) / element_count : 0;
+
+        os << "  Empty Slots: " << empty_slots << " ("
+           << std::fixed << std::setprecision(1) << (100.0 * empty_slots / slots.size()) << "%)\n"
+           << "  Max Probe Distance: " << max_probe << "\n"
+           << "  Avg Probe Distance: " << std::fixed << std::setprecision(2) << avg_probe << "\n"
+           << "  Slab Records: " << records.capacity() << " (" << (records.capacity() - records.size()) << " free, "
+           << (records.size() - element_count) << " awaiting reclamation)\n";
+    }
+};
+
+std::unique_ptr<EmployeeStore> EmployeeStore::create(StorageBackend backend, size_t initial_bucket_count) {
+    if (backend == StorageBackend::OPEN_ADDRESSING) {
+        return std::make_unique<FlatEmployeeStore>(initial_bucket_count);
+    }
+    return std::make_unique<ChainedEmployeeStore>(initial_bucket_count);
+}
+
+// ==================== SECONDARY INDEXES ====================
+
+// Unordered set of records with O(1) insert/erase and a dense vector to iterate.
+// Allocator-aware, so a PostingList inside a pmr container draws from the same
+// memory resource as the container.
+class PostingList {
+private:
+    std::pmr::vector<const Employee*> records;
+    std::pmr::unordered_map<const Employee*, size_t> positions;
+
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    explicit PostingList(const allocator_type& alloc = {}) : records(alloc), positions(alloc) {}
+    PostingList(const PostingList& other, const allocator_type& alloc)
+        : records(other.records, alloc), positions(other.positions, alloc) {}
+    PostingList(PostingList&& other, const allocator_type& alloc)
+        : records(std::move(other.records), alloc), positions(std::move(other.positions), alloc) {}
+
+    void insert(const Employee* emp) {
+        if (positions.emplace(emp, records.size()).second) {
+            records.push_back(emp);
+        }
+    }
+
+    void erase(const Employee* emp) {
+        auto it = positions.find(emp);
+        if (it == positions.end()) return;
+
+        size_t pos = it->second;
+        positions.erase(it);
+        if (pos != records.size() - 1) {
+            records[pos] = records.back();
+            positions[records[pos]] = pos;
+        }
+        records.pop_back();
+    }
+
+    void reserve(size_t additional) {
+        records.reserve(records.size() + additional);
+        positions.reserve(positions.size() + additional);
+    }
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+    const std::pmr::vector<const Employee*>& entries() const { return records; }
+
+    size_t memory_bytes() const {
+        return records.capacity() * sizeof(const Employee*) + hash_container_bytes(positions);
+    }
+};
+
+// Distinct values of one text field (first names, last names or positions),
+// folded to lower case, each mapped to the records holding it, plus a trigram
+// index over those values. Lookups work on the distinct values, which are far
+// fewer than records, and expand to records only at the end. A value whose
+// last record leaves keeps its (empty) entry, so trigram lists only grow.
+class TermIndex {
+public:
+    using Postings = std::pmr::unordered_map<std::pmr::string, PostingList>;
+    using Term = Postings::value_type;
+
+    explicit TermIndex(std::pmr::memory_resource* arena) : terms(arena), trigrams(arena) {}
+
+    void insert(std::string_view value, const Employee* emp) { term(value).insert(emp); }
+
+    // Presizes the entries of each value about to be inserted count times
+    void reserve(const std::unordered_map<std::string_view, size_t>& counts) {
+        terms.reserve(terms.size() + counts.size());
+        for (const auto& [value, count] : counts) term(value).reserve(count);
+    }
+
+    void erase(std::string_view value, const Employee* emp) {
+        auto found = terms.find(folded_key(value));
+        if (found != terms.end()) found->second.erase(emp);
+    }
+
+    // Calls visit(term) for every value that contains needle, which must be folded
+    template <typename Visit>
+    void for_each_containing(std::string_view needle, Visit&& visit) const {
+        auto check = [&](const Term& term) {
+            if (!term.second.empty() && TextMatcher::contains_folded(term.first, needle)) visit(term);
+        };
+        if (needle.size() < GRAM) {
+            for (const Term& term : terms) check(term);
+            return;
+        }
+
+        // A value containing needle contains each of its trigrams, so the
+        // shortest of their lists already holds every match
+        const std::pmr::vector<const Term*>* shortest = nullptr;
+        for (size_t i = 0; i + GRAM <= needle.size(); ++i) {
+            auto it = trigrams.find(gram_at(needle, i));
+            if (it == trigrams.end()) return;
+            if (!shortest || it->second.size() < shortest->size()) shortest = &it->second;
+        }
+        for (const Term* term : *shortest) check(*term);
+    }
+
+    // Calls visit(term, distance) for every value within max_edits edits of
+    // query, which must be folded
+    template <typename Visit>
+    void for_each_similar(std::string_view query, size_t max_edits, Visit&& visit) const {
+        auto check = [&](const Term& term) {
+            size_t length = term.first.size();
+            if (term.second.empty() || length + max_edits < query.size() || length > query.size() + max_edits) return;
+            size_t distance = TextMatcher::edit_distance(term.first, query, max_edits);
+            if (distance <= max_edits) visit(term, distance);
+        };
+
+        std::vector<uint32_t> grams;
+        for (size_t i = 0; i + GRAM <= query.size(); ++i) grams.push_back(gram_at(query, i));
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+        // One edit touches at most GRAM + 1 trigrams (a transposition spans two
+        // characters), so a match shares at least this many with query
+        size_t edit_reach = (GRAM + 1) * max_edits;
+        if (grams.size() <= edit_reach) {
+            for (const Term& term : terms) check(term);
+            return;
+        }
+        size_t needed = grams.size() - edit_reach;
+
+        std::unordered_map<const Term*, size_t> shared;
+        for (uint32_t gram : grams) {
+            auto it = trigrams.find(gram);
+            if (it == trigrams.end()) continue;
+            for (const Term* term : it->second) ++shared[term];
+        }
+        for (const auto& [term, count] : shared) {
+            if (count >= needed) check(*term);
+        }
+    }
+
+    size_t memory_bytes() const {
+        size_t bytes = hash_container_bytes(terms) + hash_container_bytes(trigrams);
+        for (const Term& term : terms) {
+            bytes += term.second.memory_bytes();
+            bytes += string_heap_bytes(term.first);
+        }
+        for (const auto& entry : trigrams) bytes += entry.second.capacity() * sizeof(const Term*);
+        return bytes;
+    }
+
+private:
+    static constexpr size_t GRAM = 3;
+
+    Postings terms;
+    // Each distinct trigram of a value lists that value once
+    std::pmr::unordered_map<uint32_t, std::pmr::vector<const Term*>> trigrams;
+
+    static uint32_t gram_at(std::string_view text, size_t i) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8) |
+               static_cast<unsigned char>(text[i + 2]);
+    }
+
+    PostingList& term(std::string_view value) {
+        std::pmr::string key = folded_key(value);
+        auto found = terms.find(key);
+        if (found == terms.end()) {
+            found = terms.try_emplace(std::move(key)).first;
+            add_trigrams(*found);
+        }
+        return found->second;
+    }
+
+    std::pmr::string folded_key(std::string_view value) const {
+        std::pmr::string key(value, terms.get_allocator());
+        for (char& c : key) c = TextMatcher::fold(c);
+        return key;
+    }
+
+    // Term nodes never move once inserted, so the lists can point at them
+    void add_trigrams(const Term& term) {
+        std::vector<uint32_t> grams;
+        for (size_t i = 0; i + GRAM <= term.first.size(); ++i) grams.push_back(gram_at(term.first, i));
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        for (uint32_t gram : grams) trigrams[gram].push_back(&term);
+    }
+};
+
+// Point-in-time copy of the running totals SecondaryIndex keeps, cheap enough to
+// take for every menu redraw
+struct TableAggregates {
+    static constexpr size_t DEPARTMENTS = 7;
+    static constexpr size_t STATUSES = 4;
+
+    size_t employee_count = 0;
+    std::array<size_t, DEPARTMENTS> department_count{};
+    std::array<double, DEPARTMENTS> department_salary{};
+    std::array<size_t, STATUSES> status_count{};
+    double total_salary = 0.0;
+    double min_salary = 0.0;
+    double max_salary = 0.0;
+    double salary_stddev = 0.0;
+    size_t distinct_skills = 0;
+    std::vector<size_t> occupancy_histogram;
+
+    double mean_salary() const {
+        return employee_count ? total_salary / employee_count : 0.0;
+    }
+};
+
+// Memory behind a table. Store and record bytes are exact allocation sizes
+// (allocator headers excluded); index bytes are estimated from node counts.
+struct MemoryUsage {
+    size_t employee_count = 0;
+    size_t store_bytes = 0;        // Buckets/slots plus sizeof(Employee) per record
+    size_t record_heap_bytes = 0;  // Strings and skill lists that outgrew the record
+    size_t index_bytes = 0;
+    StringPool::Usage shared_strings;
+
+    size_t total() const { return store_bytes + record_heap_bytes + index_bytes + shared_strings.bytes; }
+
+    double bytes_per_record() const {
+        return employee_count ? static_cast<double>(store_bytes + record_heap_bytes) / employee_count : 0.0;
+    }
+};
+
+// Department/status posting lists, an ordered salary index and an inverted skill
+// index, keyed by record address. search() drives from the most selective one and
+// checks the remaining criteria per candidate. The manager index is the org chart:
+// each managerId maps to the records that report to it.
+class SecondaryIndex {
+private:
+    static constexpr size_t DEPARTMENT_COUNT = TableAggregates::DEPARTMENTS;
+    static constexpr size_t STATUS_COUNT = TableAggregates::STATUSES;
+
+    using SalaryIndex = std::pmr::set<SortEntry, SalaryOrder>;
+    template <SortKey Key>
+    using SortedIndex = std::pmr::set<SortEntry, RecordOrder<Key>>;
+
+    // Every container draws from one pool resource, so clear() and destruction
+    // hand its chunks back at once instead of freeing node by node. Keys and
+    // values are plain pointers and handles, which is what lets the containers be
+    // abandoned in the arena without running their destructors.
+    struct Lists {
+        std::pmr::vector<PostingList> by_department;
+        std::pmr::vector<PostingList> by_status;
+        SalaryIndex by_salary;
+        SortedIndex<SortKey::ID> by_id;
+        SortedIndex<SortKey::NAME> by_name;
+        SortedIndex<SortKey::HIRE_DATE> by_hire_date;
+        std::pmr::unordered_map<InternedString, PostingList, InternedString::Hash> by_skill;
+        std::pmr::unordered_map<EmployeeId, PostingList, EmployeeId::Hash> by_manager;
+        TermIndex first_names;
+        TermIndex last_names;
+        TermIndex positions;
+
+        explicit Lists(std::pmr::memory_resource* arena)
+            : by_department(DEPARTMENT_COUNT, arena), by_status(STATUS_COUNT, arena), by_salary(arena),
+              by_id(arena), by_name(arena), by_hire_date(arena), by_skill(arena), by_manager(arena),
+              first_names(arena), last_names(arena), positions(arena) {}
+
+        const TermIndex& terms(NameField field) const {
+            switch (field) {
+                case NameField::FIRST_NAME: return first_names;
+                case NameField::LAST_NAME: return last_names;
+                default: return positions;
+            }
+        }
+    };
+
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> arena;
+    Lists* lists = nullptr;
+
+    void reset_arena() {
+        auto fresh = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        lists = new (fresh->allocate(sizeof(Lists), alignof(Lists))) Lists(fresh.get());
+        arena = std::move(fresh);
+    }
+
+    // Adjusted on every insert/erase; long double keeps the drift from repeated
+    // add-then-subtract well below a cent. Min and max come from lists->by_salary.
+    std::array<long double, DEPARTMENT_COUNT> department_salary{};
+    long double salary_squares = 0.0L;
+
+    // Sort orders other than salary cost a tree insert per write, so each is
+    // built the first time a listing asks for it and maintained from then on
+    unsigned maintained_orders = order_bit(SortKey::SALARY);
+
+    // Likewise the term indexes, three posting-list updates per write: built by
+    // the first name lookup and maintained from then on
+    bool terms_maintained = false;
+
+    static constexpr unsigned order_bit(SortKey key) { return 1u << static_cast<unsigned>(key); }
+
+    void insert_terms(const Employee* emp) {
+        lists->first_names.insert(emp->firstName, emp);
+        lists->last_names.insert(emp->lastName, emp);
+        lists->positions.insert(emp->position, emp);
+    }
+
+    void account(const Employee* emp, int sign) {
+        long double salary = emp->salary;
+        department_salary[static_cast<size_t>(emp->department)] += sign * salary;
+        salary_squares += sign * salary * salary;
+    }
+
+    using SalaryRange = std::pair<SalaryIndex::const_iterator, SalaryIndex::const_iterator>;
+
+    SalaryRange salary_range(const SearchCriteria& criteria) const {
+        auto first = criteria.minSalary ? lists->by_salary.lower_bound(*criteria.minSalary) : lists->by_salary.begin();
+        auto last = criteria.maxSalary ? lists->by_salary.upper_bound(*criteria.maxSalary) : lists->by_salary.end();
+        if (criteria.minSalary && criteria.maxSalary && *criteria.minSalary > *criteria.maxSalary) {
+            last = first;
+        }
+        return {first, last};
+    }
+
+    // Counting a tree range is linear, so stop once it can no longer win
+    static size_t bounded_distance(SalaryRange range, size_t limit) {
+        size_t count = 0;
+        for (auto it = range.first; it != range.second && count < limit; ++it) ++count;
+        return count;
+    }
+
+    // Sorting a flat array and appending in order is far cheaper than one tree
+    // insert per record
+    template <typename Set, typename ForEach>
+    static void build_order_in(Set& set, ForEach& for_each_record) {
+        using Order = typename Set::key_compare;
+        std::vector<SortEntry> entries;
+        for_each_record([&](const Employee& emp) { entries.push_back(Order::entry(emp)); });
+        std::sort(entries.begin(), entries.end(), Order{});
+        set.clear();
+        for (const SortEntry& entry : entries) set.emplace_hint(set.end(), entry);
+    }
+
+    template <typename Set, typename Visit>
+    static void visit_sorted_in(const Set& set, bool descending, const Employee* after, Visit& visit) {
+        using Order = typename Set::key_compare;
+        if (!descending) {
+            auto it = after ? set.upper_bound(Order::entry(*after)) : set.begin();
+            for (; it != set.end() && visit(*it->record); ++it) {}
+        } else {
+            auto it = after ? set.lower_bound(Order::entry(*after)) : set.end();
+            while (it != set.begin() && visit(*(--it)->record)) {}
+        }
+    }
+
+public:
+    SecondaryIndex() { reset_arena(); }
+
+    SecondaryIndex(SecondaryIndex&& other) noexcept
+        : arena(std::move(other.arena)), lists(other.lists),
+          department_salary(other.department_salary), salary_squares(other.salary_squares),
+          maintained_orders(other.maintained_orders), terms_maintained(other.terms_maintained) {
+        other.lists = nullptr;
+    }
+
+    SecondaryIndex& operator=(SecondaryIndex&& other) noexcept {
+        // The old contents leave with other and are released when it goes
+        std::swap(arena, other.arena);
+        std::swap(lists, other.lists);
+        std::swap(department_salary, other.department_salary);
+        std::swap(salary_squares, other.salary_squares);
+        std::swap(maintained_orders, other.maintained_orders);
+        std::swap(terms_maintained, other.terms_maintained);
+        return *this;
+    }
+
+    void insert(const Employee* emp) {
+        lists->by_department[static_cast<size_t>(emp->department)].insert(emp);
+        lists->by_status[static_cast<size_t>(emp->status)].insert(emp);
+        lists->by_salary.insert(SalaryOrder::entry(*emp));
+        if (maintained_orders & order_bit(SortKey::ID)) lists->by_id.insert(RecordOrder<SortKey::ID>::entry(*emp));
+        if (maintained_orders & order_bit(SortKey::NAME)) lists->by_name.insert(RecordOrder<SortKey::NAME>::entry(*emp));
+        if (maintained_orders & order_bit(SortKey::HIRE_DATE)) {
+            lists->by_hire_date.insert(RecordOrder<SortKey::HIRE_DATE>::entry(*emp));
+        }
+        account(emp, +1);
+        for (const auto& skill : emp->skills) {
+            lists->by_skill[skill].insert(emp);
+        }
+        if (!emp->managerId.empty()) {
+            lists->by_manager[emp->managerId].insert(emp);
+        }
+        if (terms_maintained) insert_terms(emp);
+    }
+
+    // Presizes the posting lists for a batch about to be inserted, so a bulk load
+    // does not rehash them repeatedly
+    void reserve(const std::vector<Employee>& incoming) {
+        std::array<size_t, DEPARTMENT_COUNT> departments{};
+        std::array<size_t, STATUS_COUNT> statuses{};
+        std::unordered_map<InternedString, size_t, InternedString::Hash> skills;
+        std::unordered_map<EmployeeId, size_t, EmployeeId::Hash> managers;
+        std::unordered_map<std::string_view, size_t> first_names, last_names, positions;
+        for (const auto& emp : incoming) {
+            ++departments[static_cast<size_t>(emp.department)];
+            ++statuses[static_cast<size_t>(emp.status)];
+            for (const auto& skill : emp.skills) ++skills[skill];
+            if (!emp.managerId.empty()) ++managers[emp.managerId];
+            if (!terms_maintained) continue;
+            ++first_names[emp.firstName];
+            ++last_names[emp.lastName];
+            ++positions[emp.position];
+        }
+
+        for (size_t i = 0; i < DEPARTMENT_COUNT; ++i) lists->by_department[i].reserve(departments[i]);
+        for (size_t i = 0; i < STATUS_COUNT; ++i) lists->by_status[i].reserve(statuses[i]);
+        lists->by_skill.reserve(lists->by_skill.size() + skills.size());
+        for (const auto& [skill, count] : skills) lists->by_skill[skill].reserve(count);
+        lists->by_manager.reserve(lists->by_manager.size() + managers.size());
+        for (const auto& [manager, count] : managers) lists->by_manager[manager].reserve(count);
+        lists->first_names.reserve(first_names);
+        lists->last_names.reserve(last_names);
+        lists->positions.reserve(positions);
+    }
+
+    void erase(const Employee* emp) {
+        lists->by_department[static_cast<size_t>(emp->department)].erase(emp);
+        lists->by_status[static_cast<size_t>(emp->status)].erase(emp);
+
+        // Records never change in place, so each one is found under the keys it
+        // was inserted with
+        if (lists->by_salary.erase(SalaryOrder::entry(*emp))) account(emp, -1);
+        if (maintained_orders & order_bit(SortKey::ID)) lists->by_id.erase(RecordOrder<SortKey::ID>::entry(*emp));
+        if (maintained_orders & order_bit(SortKey::NAME)) lists->by_name.erase(RecordOrder<SortKey::NAME>::entry(*emp));
+        if (maintained_orders & order_bit(SortKey::HIRE_DATE)) {
+            lists->by_hire_date.erase(RecordOrder<SortKey::HIRE_DATE>::entry(*emp));
+        }
+
+        for (const auto& skill : emp->skills) {
+            auto it = lists->by_skill.find(skill);
+            if (it == lists->by_skill.end()) continue;
+            it->second.erase(emp);
+            if (it->second.empty()) lists->by_skill.erase(it);
+        }
+
+        if (!emp->managerId.empty()) {
+            auto it = lists->by_manager.find(emp->managerId);
+            if (it != lists->by_manager.end()) {
+                it->second.erase(emp);
+                if (it->second.empty()) lists->by_manager.erase(it);
+            }
+        }
+
+        if (terms_maintained) {
+            lists->first_names.erase(emp->firstName, emp);
+            lists->last_names.erase(emp->lastName, emp);
+            lists->positions.erase(emp->position, emp);
+        }
+    }
+
+    // Records whose managerId is manager_id, or nullptr if there are none
+    const PostingList* reports_of(const EmployeeId& manager_id) const {
+        auto it = lists->by_manager.find(manager_id);
+        return it == lists->by_manager.end() ? nullptr : &it->second;
+    }
+
+    // Calls visit(manager_id, reports) for every ID that has at least one report
+    template <typename Visit>
+    void for_each_manager(Visit&& visit) const {
+        for (const auto& [manager_id, reports] : lists->by_manager) visit(manager_id, reports);
+    }
+
+    // O(1) in the number of entries: the whole arena is dropped at once
+    void clear() {
+        reset_arena();
+        department_salary.fill(0.0L);
+        salary_squares = 0.0L;
+    }
+
+    size_t distinct_skills() const { return lists->by_skill.size(); }
+
+    std::vector<InternedString> skills() const {
+        std::vector<InternedString> names;
+        names.reserve(lists->by_skill.size());
+        for (const auto& entry : lists->by_skill) {
+            if (!entry.second.empty()) names.push_back(entry.first);
+        }
+        return names;
+    }
+
+    size_t memory_bytes() const {
+        size_t bytes = 0;
+        for (const auto& list : lists->by_department) bytes += list.memory_bytes();
+        for (const auto& list : lists->by_status) bytes += list.memory_bytes();
+        // Red-black tree node: colour plus three links ahead of the value; one
+        // tree per sort order
+        size_t sorted_entries = lists->by_salary.size() + lists->by_id.size() + lists->by_name.size() +
+                                lists->by_hire_date.size();
+        bytes += sorted_entries * (sizeof(SortEntry) + 4 * sizeof(void*));
+        bytes += hash_container_bytes(lists->by_skill) + hash_container_bytes(lists->by_manager);
+        for (const auto& entry : lists->by_skill) bytes += entry.second.memory_bytes();
+        for (const auto& entry : lists->by_manager) bytes += entry.second.memory_bytes();
+        bytes += lists->first_names.memory_bytes() + lists->last_names.memory_bytes() +
+                 lists->positions.memory_bytes();
+        return bytes;
+    }
+
+    // O(departments + statuses); the bucket histogram is left to the caller
+    TableAggregates aggregates() const {
+        TableAggregates totals;
+        totals.employee_count = lists->by_salary.size();
+        long double total = 0.0L;
+        for (size_t i = 0; i < DEPARTMENT_COUNT; ++i) {
+            totals.department_count[i] = lists->by_department[i].size();
+            totals.department_salary[i] = static_cast<double>(department_salary[i]);
+            total += department_salary[i];
+        }
+        for (size_t i = 0; i < STATUS_COUNT; ++i) totals.status_count[i] = lists->by_status[i].size();
+        totals.distinct_skills = lists->by_skill.size();
+        if (lists->by_salary.empty()) return totals;
+
+        long double n = static_cast<long double>(lists->by_salary.size());
+        long double mean = total / n;
+        totals.total_salary = static_cast<double>(total);
+        totals.min_salary = lists->by_salary.begin()->record->salary;
+        totals.max_salary = lists->by_salary.rbegin()->record->salary;
+        totals.salary_stddev = static_cast<double>(std::sqrt(std::max(0.0L, salary_squares / n - mean * mean)));
+        return totals;
+    }
+
+    struct NameHit {
+        const Employee* record;
+        NameField field;
+        unsigned quality;
+    };
+
+    // Up to limit records whose first name, last name or position matches the
+    // folded query, each once and best first (see NameMatch); needs has_terms(). Values rank by
+    // quality, then field, then how much of the value the query covers;
+    // records holding the same value come in posting order.
+    std::vector<NameHit> match_names(std::string_view query, size_t max_edits, size_t limit) const {
+        struct ValueHit {
+            unsigned quality;
+            NameField field;
+            size_t length;
+            const PostingList* records;
+        };
+        std::vector<ValueHit> values;
+        for (NameField field : {NameField::FIRST_NAME, NameField::LAST_NAME, NameField::POSITION}) {
+            const TermIndex& terms = lists->terms(field);
+            terms.for_each_containing(query, [&](const TermIndex::Term& term) {
+                bool prefix = term.first.compare(0, query.size(), query) == 0;
+                unsigned quality = term.first.size() == query.size() ? 0 : prefix ? 1 : 2;
+                values.push_back({quality, field, term.first.size(), &term.second});
+            });
+            if (max_edits == 0) continue;
+            terms.for_each_similar(query, max_edits, [&](const TermIndex::Term& term, size_t distance) {
+                // Values containing the query were ranked above
+                if (TextMatcher::contains_folded(term.first, query)) return;
+                values.push_back({2 + static_cast<unsigned>(distance), field, term.first.size(), &term.second});
+            });
+        }
+        std::sort(values.begin(), values.end(), [](const ValueHit& a, const ValueHit& b) {
+            return std::tie(a.quality, a.field, a.length) < std::tie(b.quality, b.field, b.length);
+        });
+
+        std::vector<NameHit> hits;
+        std::unordered_set<const Employee*> seen;
+        for (const ValueHit& value : values) {
+            for (const Employee* emp : value.records->entries()) {
+                if (hits.size() == limit) return hits;
+                if (seen.insert(emp).second) hits.push_back({emp, value.field, value.quality});
+            }
+        }
+        return hits;
+    }
+
+    bool has_terms() const { return terms_maintained; }
+
+    // Builds the term indexes from every record for_each_record visits and keeps
+    // them up to date afterwards
+    template <typename ForEach>
+    void build_terms(ForEach&& for_each_record) {
+        std::unordered_map<std::string_view, size_t> first_names, last_names, positions;
+        for_each_record([&](const Employee& emp) {
+            ++first_names[emp.firstName];
+            ++last_names[emp.lastName];
+            ++positions[emp.position];
+        });
+        lists->first_names.reserve(first_names);
+        lists->last_names.reserve(last_names);
+        lists->positions.reserve(positions);
+        for_each_record([&](const Employee& emp) { insert_terms(&emp); });
+        terms_maintained = true;
+    }
+
+    bool has_order(SortKey key) const { return maintained_orders & order_bit(key); }
+
+    // Builds key's sorted index from every record for_each_record visits and keeps
+    // it up to date afterwards
+    template <typename ForEach>
+    void build_order(SortKey key, ForEach&& for_each_record) {
+        switch (key) {
+            case SortKey::ID: build_order_in(lists->by_id, for_each_record); break;
+            case SortKey::NAME: build_order_in(lists->by_name, for_each_record); break;
+            case SortKey::SALARY: build_order_in(lists->by_salary, for_each_record); break;
+            case SortKey::HIRE_DATE: build_order_in(lists->by_hire_date, for_each_record); break;
+        }
+        maintained_orders |= order_bit(key);
+    }
+
+    // Visits records in key order, or reverse order if descending, starting just
+    // past after when given, until visit returns false. Seeking is O(log N) and
+    // each visited record one tree step.
+    template <typename Visit>
+    void visit_sorted(SortKey key, bool descending, const Employee* after, Visit&& visit) const {
+        switch (key) {
+            case SortKey::ID: visit_sorted_in(lists->by_id, descending, after, visit); break;
+            case SortKey::NAME: visit_sorted_in(lists->by_name, descending, after, visit); break;
+            case SortKey::SALARY: visit_sorted_in(lists->by_salary, descending, after, visit); break;
+            case SortKey::HIRE_DATE: visit_sorted_in(lists->by_hire_date, descending, after, visit); break;
+        }
+    }
+
+    // Visits a superset of the records matching the plan's indexed fields, taken
+    // from the smallest candidate set, until visit returns false. The chosen index
+    // matches its field exactly, so the plan stops checking it. Returns false
+    // without visiting anything when no index narrows the search below
+    // scan_threshold records.
+    bool visit_candidates(QueryPlan& plan, size_t scan_threshold,
+                          const std::function<bool(const Employee&)>& visit) const {
+        const SearchCriteria& criteria = plan.criteria;
+        enum class Source { NONE, DEPARTMENT, STATUS, SALARY, SKILL, TEXT };
+        Source best = Source::NONE;
+        size_t best_size = scan_threshold;
+
+        if (criteria.department) {
+            size_t n = lists->by_department[static_cast<size_t>(*criteria.department)].size();
+            if (n < best_size) { best = Source::DEPARTMENT; best_size = n; }
+        }
+        if (criteria.status) {
+            size_t n = lists->by_status[static_cast<size_t>(*criteria.status)].size();
+            if (n < best_size) { best = Source::STATUS; best_size = n; }
+        }
+
+        SalaryRange salaries{lists->by_salary.end(), lists->by_salary.end()};
+        if (criteria.minSalary || criteria.maxSalary) {
+            salaries = salary_range(criteria);
+            size_t n = bounded_distance(salaries, best_size);
+            if (n < best_size) { best = Source::SALARY; best_size = n; }
+        }
+
+        std::vector<const PostingList*> skill_lists;
+        if (criteria.skill) {
+            size_t n = 0;
+            for (const auto& [skill, list] : lists->by_skill) {
+                if (TextMatcher::contains(skill, plan.skill, criteria.caseSensitive)) {
+                    skill_lists.push_back(&list);
+                    n += list.size();
+                }
+            }
+            if (n < best_size) { best = Source::SKILL; best_size = n; }
+        }
+
+        // Term indexes hold folded values, so a case-sensitive term still gets a
+        // superset and keeps its per-record check. Each record holds one value
+        // per field, so the lists of different values never overlap.
+        std::vector<const PostingList*> text_lists;
+        QueryPlan::Field text_field = QueryPlan::FIRST_NAME;
+        auto consider_text = [&](const std::optional<std::string>& term, const std::string& prepared,
+                                 NameField field, QueryPlan::Field plan_field) {
+            if (!term || !terms_maintained) return;
+            std::string needle = criteria.caseSensitive ? TextMatcher::fold_copy(prepared) : prepared;
+            std::vector<const PostingList*> found;
+            size_t n = 0;
+            lists->terms(field).for_each_containing(needle, [&](const TermIndex::Term& value) {
+                found.push_back(&value.second);
+                n += value.second.size();
+            });
+            if (n < best_size) {
+                best = Source::TEXT;
+                best_size = n;
+                text_lists.swap(found);
+                text_field = plan_field;
+            }
+        };
+        consider_text(criteria.lastName, plan.lastName, NameField::LAST_NAME, QueryPlan::LAST_NAME);
+        consider_text(criteria.firstName, plan.firstName, NameField::FIRST_NAME, QueryPlan::FIRST_NAME);
+        consider_text(criteria.position, plan.position, NameField::POSITION, QueryPlan::POSITION);
+
+        auto visit_list = [&](const PostingList& list) {
+            for (const Employee* emp : list.entries()) {
+                if (!visit(*emp)) return false;
+            }
+            return true;
+        };
+
+        switch (best) {
+            case Source::NONE:
+                return false;
+            case Source::DEPARTMENT:
+                plan.covered(QueryPlan::DEPARTMENT);
+                visit_list(lists->by_department[static_cast<size_t>(*criteria.department)]);
+                break;
+            case Source::STATUS:
+                plan.covered(QueryPlan::STATUS);
+                visit_list(lists->by_status[static_cast<size_t>(*criteria.status)]);
+                break;
+            case Source::SALARY:
+                plan.covered(QueryPlan::SALARY);
+                for (auto it = salaries.first; it != salaries.second && visit(*it->record); ++it) {}
+                break;
+            case Source::SKILL:
+                plan.covered(QueryPlan::SKILL);
+                if (skill_lists.size() == 1) {
+                    visit_list(*skill_lists.front());
+                } else {
+                    // A record can carry several matching skills; report it once
+                    std::unordered_set<const Employee*> seen;
+                    for (const PostingList* list : skill_lists) {
+                        for (const Employee* emp : list->entries()) {
+                            if (seen.insert(emp).second && !visit(*emp)) return true;
+                        }
+                    }
+                }
+                break;
+            case Source::TEXT:
+                if (!criteria.caseSensitive) plan.covered(text_field);
+                for (const PostingList* list : text_lists) {
+                    if (!visit_list(*list)) break;
+                }
+                break;
+        }
+        return true;
+    }
+};
+
+// ==================== EPOCH-BASED RECLAMATION ====================
+
+// Defers releasing unlinked records until no reader can still hold them. pin() runs
+// under the owner's shared lock and retire()/collect() under its exclusive lock, so
+// the epoch never moves while a pin is being taken; dropping a pin is a plain
+// atomic decrement from any thread.
+class EpochReclaimer {
+public:
+    class Pin {
+    private:
+        std::atomic<size_t>& counter;
+    public:
+        explicit Pin(std::atomic<size_t>& c) : counter(c) {}
+        ~Pin() { counter.fetch_sub(1, std::memory_order_release); }
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+    };
+
+private:
+    static constexpr size_t EPOCHS = 3;
+
+    uint64_t epoch = 0;
+    std::array<std::atomic<size_t>, EPOCHS> active{};
+    std::array<std::vector<size_t>, EPOCHS> retired;
+
+public:
+    std::shared_ptr<Pin> pin() {
+        auto& counter = active[epoch % EPOCHS];
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return std::make_shared<Pin>(counter);
+    }
+
+    void retire(size_t handle) {
+        retired[epoch % EPOCHS].push_back(handle);
+    }
+
+    // Live pins can only belong to the current or the previous epoch. Once the
+    // previous one has drained, whatever was retired during it is unreachable.
+    template <typename Release>
+    void collect(Release&& release) {
+        size_t previous = (epoch + EPOCHS - 1) % EPOCHS;
+        if (active[previous].load(std::memory_order_acquire) != 0) return;
+
+        for (size_t handle : retired[previous]) release(handle);
+        retired[previous].clear();
+        ++epoch;
+    }
+
+    size_t pending() const {
+        size_t total = 0;
+        for (const auto& list : retired) total += list.size();
+        return total;
+    }
+
+    // Takes over another table's bookkeeping; neither side may have live pins
+    void adopt(EpochReclaimer& other) {
+        epoch = other.epoch;
+        for (size_t i = 0; i < EPOCHS; ++i) {
+            retired[i] = std::move(other.retired[i]);
+            other.retired[i].clear();
+        }
+    }
+};
+
+// ==================== HIGH-PERFORMANCE HASH TABLE ====================
+
+enum class MutationOp : uint8_t { INSERT, UPDATE, REMOVE };
+
+// One change of a committed batch; record is the stored version, null for removals
+struct CommittedChange {
+    MutationOp op;
+    std::string_view id;
+    const Employee* record;
+};
+
+// Receives every committed mutation in the order it was applied. Calls are made
+// with the table's writer lock held but no table lock, so a journal may read the
+// table; it must not mutate it.
+class MutationJournal {
+public:
+    virtual ~MutationJournal() = default;
+    virtual void record_insert(const Employee& emp) = 0;
+    virtual void record_update(const std::string& id, const Employee& emp) = 0;
+    virtual void record_remove(const std::string& id) = 0;
+
+    // A batch should survive a crash whole or not at all. This default records
+    // each change on its own, for journals that cannot append atomically.
+    virtual void record_batch(const std::vector<CommittedChange>& changes) {
+        for (const auto& change : changes) {
+            switch (change.op) {
+                case MutationOp::INSERT: record_insert(*change.record); break;
+                case MutationOp::UPDATE: record_update(std::string(change.id), *change.record); break;
+                case MutationOp::REMOVE: record_remove(std::string(change.id)); break;
+            }
+        }
+    }
+};
+
+// Inserts, updates and removes that EmployeeHashTable::apply() commits as one
+// unit, in the order they were added
+class MutationBatch {
+public:
+    struct Mutation {
+        MutationOp op;
+        std::string id;
+        Employee record;  // Unused for removals
+    };
+
+    void insert(Employee emp) {
+        std::string id = emp.id;
+        mutations.push_back({MutationOp::INSERT, std::move(id), std::move(emp)});
+    }
+
+    void update(const std::string& id, Employee emp) { mutations.push_back({MutationOp::UPDATE, id, std::move(emp)}); }
+    void remove(const std::string& id) { mutations.push_back({MutationOp::REMOVE, id, Employee()}); }
+
+    size_t size() const { return mutations.size(); }
+    bool empty() const { return mutations.empty(); }
+    void clear() { mutations.clear(); }
+
+private:
+    friend class EmployeeHashTable;
+    std::vector<Mutation> mutations;
+};
+
+// Fields EmployeeHashTable::update_where() assigns on every matching record;
+// unset fields are left alone
+struct FieldChanges {
+    std::optional<std::string> managerId;  // Empty clears the manager
+    std::optional<Department> department;
+    std::optional<std::string> position;
+    std::optional<EmployeeStatus> status;
+
+    bool empty() const { return !managerId && !department && !position && !status; }
+};
+
+class EmployeeHashTable {
+private:
+    std::unique_ptr<EmployeeStore> store;
+
+    // Readers share table_mutex; writers serialize on writer_mutex and hold
+    // table_mutex exclusively only while they actually change the layout
+    mutable MeteredSharedMutex table_mutex;
+    std::mutex writer_mutex;
+
+    // Removed and superseded records wait here until every snapshot that could see
+    // them is gone
+    mutable EpochReclaimer reclaimer;
+
+    // Kept in step with the store on every insert/update/remove
+    SecondaryIndex index;
+
+    // Belongs to this table object rather than its contents, so moves leave it be
+    MutationJournal* journal = nullptr;
+
+    // An index only pays off over a sequential scan when it narrows the
+    // candidates to well under the table size
+    static constexpr size_t INDEX_SCAN_DIVISOR = 4;
+
+    // Caller holds table_mutex, shared or exclusive, and the key's order is indexed
+    EmployeePage collect_page(const PageRequest& request) const {
+        EmployeePage result;
+        result.employees.reserve(request.size);
+        index.visit_sorted(request.key, request.descending, request.after ? &*request.after : nullptr,
+            [&](const Employee& emp) {
+                if (result.employees.size() == request.size) {
+                    result.has_more = true;
+                    return false;
+                }
+                result.employees.push_back(emp);
+                return true;
+            });
+        return result;
+    }
+
+    // Calls emit under the shared lock for every match until plan.limit of them;
+    // returns how many records were examined
+    template <typename Emit>
+    uint64_t execute(QueryPlan& plan, Emit&& emit) const {
+        if (plan.limit == 0) return 0;
+
+        uint64_t scanned = 0;
+        size_t matched = 0;
+        auto visit = [&](const Employee& emp) {
+            ++scanned;
+            if (!plan.matches(emp)) return true;
+            emit(emp);
+            return ++matched < plan.limit;
+        };
+
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        if (plan.criteria.id) {
+            plan.covered(QueryPlan::ID);
+            if (const Employee* emp = store->find(*plan.criteria.id)) visit(*emp);
+        } else if (!index.visit_candidates(plan, store->size() / INDEX_SCAN_DIVISOR, visit)) {
+            store->for_each_until(visit);
+        }
+        return scanned;
+    }
+
+    // Caller holds table_mutex exclusively
+    void retire(const EmployeeStore::Detached& detached) {
+        if (detached) reclaimer.retire(detached.handle);
+        reclaimer.collect([this](size_t handle) { store->release(handle); });
+    }
+
+    // Caller holds writer_mutex, so nothing can change between prepare and commit
+    void rehash(size_t min_bucket_count = 0) {
+        Metrics::Timer timer(Metrics::rehash_latency);
+        std::unique_ptr<EmployeeStore::GrowthPlan> plan;
+        double current_load;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            current_load = store->load_factor();
+            plan = store->prepare_growth(min_bucket_count);
+        }
+
+        Logger::log(Logger::INFO, "Rehashing hash table, current load factor: " +
+                   std::to_string(current_load));
+
+        size_t new_bucket_count;
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            store->commit_growth(*plan);
+            new_bucket_count = store->bucket_count();
+        }
+
+        Logger::log(Logger::INFO, "Rehash committed, new bucket count: " +
+                   std::to_string(new_bucket_count));
+    }
+
+    // Caller holds writer_mutex. Grows once to fit expected_size records without
+    // crossing the store's load limit.
+    void reserve_locked(size_t expected_size) {
+        size_t buckets;
+        double max_load;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            buckets = store->bucket_count();
+            max_load = store->max_load_factor();
+        }
+        size_t required = static_cast<size_t>(std::ceil(expected_size / max_load)) + 1;
+        if (required > buckets) rehash(required);
+    }
+
+    // Marks each record valid or not, spreading large batches over all cores;
+    // returns the first failure message for the summary log
+    static std::string validate_all(const std::vector<Employee>& employees, std::vector<uint8_t>& valid) {
+        valid.assign(employees.size(), 0);
+        size_t workers = ParallelRange::workers_for(employees.size(), PARALLEL_VALIDATION_MIN);
+        std::vector<std::string> first_error(workers);
+
+        ParallelRange::run(employees.size(), workers, [&](size_t worker, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    employees[i].validate();
+                    valid[i] = 1;
+                } catch (const EmployeeException& e) {
+                    if (first_error[worker].empty()) first_error[worker] = employees[i].id.str() + ": " + e.what();
+                }
+            }
+        });
+
+        for (const auto& error : first_error) {
+            if (!error.empty()) return error;
+        }
+        return "";
+    }
+
+    // Below this many records per thread, spawning threads costs more than it saves
+    static constexpr size_t PARALLEL_VALIDATION_MIN = 4096;
+
+    // Bulk inserts release the exclusive lock between batches so readers are not
+    // stalled for the whole load
+    static constexpr size_t BULK_BATCH_SIZE = 4096;
+
+public:
+    static constexpr double MAX_LOAD_FACTOR = 0.75;
+
+    struct BulkInsertResult {
+        size_t inserted = 0;
+        size_t duplicates = 0;
+        size_t invalid = 0;
+    };
+
+    explicit EmployeeHashTable(size_t initial_bucket_count = 17,
+                               StorageBackend backend = StorageBackend::CHAINED)
+        : store(EmployeeStore::create(backend, initial_bucket_count)) {
+        Logger::log(Logger::INFO, "Hash table initialized with " +
+                   std::to_string(store->bucket_count()) + " buckets (" +
+                   store->backend_name() + ")");
+    }
+
+    // Move Constructor
+    EmployeeHashTable(EmployeeHashTable&& other) noexcept
+        : store(std::move(other.store)), index(std::move(other.index)) {
+        reclaimer.adopt(other.reclaimer);
+    }
+
+    // Move Assignment Operator
+    EmployeeHashTable& operator=(EmployeeHashTable&& other) noexcept {
+        if (this != &other) {
+            std::scoped_lock writers(writer_mutex, other.writer_mutex);
+            std::scoped_lock tables(table_mutex, other.table_mutex);
+
+            // Records still awaiting reclamation die with the old store
+            store = std::move(other.store);
+            index = std::move(other.index);
+            reclaimer.adopt(other.reclaimer);
+        }
+        return *this;
+    }
+
+    // Disable copy operations
+    EmployeeHashTable(const EmployeeHashTable&) = delete;
+    EmployeeHashTable& operator=(const EmployeeHashTable&) = delete;
+
+    StorageBackend backend() const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        return store->backend();
+    }
+
+    // Pass nullptr to detach. The journal must outlive its attachment.
+    void set_journal(MutationJournal* new_journal) {
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        journal = new_journal;
+    }
+
+    bool insert(const Employee& emp) {
+        try {
+            emp.validate();
+        } catch (const EmployeeException& e) {
+            Logger::log(Logger::ERROR, "Employee validation failed: " + std::string(e.what()));
+            throw;
+        }
+
+        Employee emp_copy(emp);
+        std::lock_guard<std::mutex> writer(writer_mutex);
+
+        bool inserted;
+        bool needs_rehash;
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            Employee* stored = store->insert(std::move(emp_copy));
+            inserted = stored != nullptr;
+            if (inserted) index.insert(stored);
+            needs_rehash = inserted && store->load_factor() > store->max_load_factor();
+        }
+
+        if (inserted) {
+            Logger::log(Logger::INFO, "Employee inserted: ", emp.id);
+            if (journal) journal->record_insert(emp);
+
+            if (needs_rehash) {
+                rehash();
+            }
+        } else {
+            Logger::log(Logger::WARNING, "Duplicate employee ID attempted: ", emp.id);
+        }
+
+        return inserted;
+    }
+
+    // Sizes the table once so the next expected_size records insert without rehashing
+    void reserve(size_t expected_size) {
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        reserve_locked(expected_size);
+    }
+
+    // Loads many records at once: validation runs in parallel, the table grows at
+    // most once, records are moved rather than copied, and a single summary line
+    // is logged. Invalid records and duplicate IDs are skipped and counted.
+    BulkInsertResult bulk_insert(std::vector<Employee>&& employees) {
+        BulkInsertResult result;
+        std::vector<uint8_t> valid;
+        std::string first_error = validate_all(employees, valid);
+        size_t valid_count = static_cast<size_t>(std::count(valid.begin(), valid.end(), 1));
+        result.invalid = employees.size() - valid_count;
+
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        reserve_locked(size() + valid_count);
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            index.reserve(employees);
+        }
+
+        bool needs_rehash = false;
+        std::vector<const Employee*> batch;
+        for (size_t begin = 0; begin < employees.size(); begin += BULK_BATCH_SIZE) {
+            size_t end = std::min(employees.size(), begin + BULK_BATCH_SIZE);
+            batch.clear();
+            {
+                std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+                for (size_t i = begin; i < end; ++i) {
+                    if (!valid[i]) continue;
+                    Employee* stored = store->insert(std::move(employees[i]));
+                    if (stored) {
+                        index.insert(stored);
+                        batch.push_back(stored);
+                    } else {
+                        ++result.duplicates;
+                    }
+                }
+                needs_rehash = store->load_factor() > store->max_load_factor();
+            }
+            result.inserted += batch.size();
+
+            // Records cannot be removed or replaced while writer_mutex is held
+            if (journal) {
+                for (const Employee* stored : batch) journal->record_insert(*stored);
+            }
+            if (needs_rehash) rehash();
+        }
+
+        std::string summary = "Bulk inserted " + std::to_string(result.inserted) + " employees (" +
+                              std::to_string(result.duplicates) + " duplicate, " +
+                              std::to_string(result.invalid) + " invalid)";
+        if (result.invalid) {
+            Logger::log(Logger::WARNING, summary, ", first rejected ", first_error);
+        } else {
+            Logger::log(Logger::INFO, summary);
+        }
+        return result;
+    }
+
+    struct BatchResult {
+        size_t inserted = 0;
+        size_t updated = 0;
+        size_t removed = 0;
+    };
+
+    // Commits every mutation in the batch, in order, or none of them. Records are
+    // validated in one pass first, and an insert of an existing ID or an update
+    // or removal of a missing one, counting the mutations before it, rejects the
+    // whole batch with an EmployeeException before anything changes. Readers see
+    // none of the batch or all of it, and the journal gets one record_batch().
+    BatchResult apply(MutationBatch batch) {
+        auto reject = [](const std::string& problem) {
+            Logger::log(Logger::ERROR, "Batch rejected: ", problem);
+            throw EmployeeException("Batch rejected: " + problem);
+        };
+        auto& mutations = batch.mutations;
+        for (const auto& mutation : mutations) {
+            if (mutation.op == MutationOp::REMOVE) continue;
+            if (mutation.record.id != mutation.id) reject("record for " + mutation.id + " has another ID");
+            try {
+                mutation.record.validate();
+            } catch (const EmployeeException& e) {
+                reject(mutation.id + ": " + e.what());
+            }
+        }
+
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        size_t inserts = 0;
+        {
+            // Whether each ID touched so far exists once the batch reaches it
+            std::unordered_map<std::string_view, bool> present;
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            for (const auto& mutation : mutations) {
+                auto known = present.find(mutation.id);
+                bool exists = known != present.end() ? known->second : store->find(mutation.id) != nullptr;
+                if (mutation.op == MutationOp::INSERT) {
+                    if (exists) reject("employee ID already exists: " + mutation.id);
+                    ++inserts;
+                } else if (!exists) {
+                    reject("employee not found: " + mutation.id);
+                }
+                present[mutation.id] = mutation.op != MutationOp::REMOVE;
+            }
+        }
+        return commit_locked(mutations, inserts);
+    }
+
+    // Assigns changes to every record matching criteria, as one batch, and
+    // returns how many records changed. The new values are validated once, not
+    // per record; matches are collected by address under the writer lock and
+    // each is copied exactly once, into its new version. Records never change in
+    // place, since snapshots and views may still be reading them. Records that
+    // already hold the values are left alone, and a record is never made its own
+    // manager.
+    size_t update_where(const SearchCriteria& criteria, const FieldChanges& changes) {
+        if (changes.empty()) return 0;
+        if (changes.managerId && EmployeeId(*changes.managerId).truncated()) {
+            throw EmployeeException("Invalid manager ID format");
+        }
+        if (changes.position && !Validator::isValidPosition(*changes.position)) {
+            throw EmployeeException("Invalid position format");
+        }
+        EmployeeId manager(changes.managerId.value_or(""));
+        InternedString position(changes.position.value_or(""));
+
+        std::lock_guard<std::mutex> writer(writer_mutex);
+        QueryPlan plan(criteria);
+        std::vector<const Employee*> matches;
+        uint64_t scanned = execute(plan, [&](const Employee& emp) { matches.push_back(&emp); });
+        Metrics::search_rows_scanned.add(scanned);
+
+        std::vector<MutationBatch::Mutation> mutations;
+        for (const Employee* emp : matches) {
+            bool set_manager = changes.managerId && emp->managerId != manager && emp->id != manager;
+            bool set_department = changes.department && emp->department != *changes.department;
+            bool set_position = changes.position && emp->position != position;
+            bool set_status = changes.status && emp->status != *changes.status;
+            if (!set_manager && !set_department && !set_position && !set_status) continue;
+
+            Employee updated = *emp;
+            if (set_manager) updated.managerId = manager;
+            if (set_department) updated.department = *changes.department;
+            if (set_position) updated.position = position;
+            if (set_status) updated.status = *changes.status;
+            mutations.push_back({MutationOp::UPDATE, emp->id, std::move(updated)});
+        }
+        if (mutations.empty()) return 0;
+        return commit_locked(mutations, 0).updated;
+    }
+
+private:
+    // Caller holds writer_mutex and has checked that every mutation will succeed.
+    // The table is grown once for the inserts, then everything is applied under
+    // one exclusive lock. Superseded records are retired only after the journal
+    // has seen the batch, since its changes may point at them.
+    BatchResult commit_locked(std::vector<MutationBatch::Mutation>& mutations, size_t inserts) {
+        reserve_locked(size() + inserts);
+
+        BatchResult result;
+        std::vector<CommittedChange> changes;
+        std::vector<EmployeeStore::Detached> superseded;
+        changes.reserve(mutations.size());
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            for (auto& mutation : mutations) {
+                switch (mutation.op) {
+                    case MutationOp::INSERT: {
+                        Employee* stored = store->insert(std::move(mutation.record));
+                        index.insert(stored);
+                        changes.push_back({MutationOp::INSERT, mutation.id, stored});
+                        ++result.inserted;
+                        break;
+                    }
+                    case MutationOp::UPDATE: {
+                        EmployeeStore::Detached previous = store->replace(mutation.id, std::move(mutation.record));
+                        index.erase(previous.record);
+                        Employee* stored = store->find(mutation.id);
+                        index.insert(stored);
+                        superseded.push_back(previous);
+                        changes.push_back({MutationOp::UPDATE, mutation.id, stored});
+                        ++result.updated;
+                        break;
+                    }
+                    case MutationOp::REMOVE: {
+                        EmployeeStore::Detached removed = store->detach(mutation.id);
+                        index.erase(removed.record);
+                        superseded.push_back(removed);
+                        changes.push_back({MutationOp::REMOVE, mutation.id, nullptr});
+                        ++result.removed;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (journal) journal->record_batch(changes);
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            for (const auto& detached : superseded) retire(detached);
+        }
+        Logger::log(Logger::INFO, "Batch committed: ", std::to_string(result.inserted), " inserted, ",
+                    std::to_string(result.updated), " updated, ", std::to_string(result.removed), " removed");
+        return result;
+    }
+
+public:
+    bool remove(const std::string& id) {
+        std::lock_guard<std::mutex> writer(writer_mutex);
+
+        bool removed;
+        {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            EmployeeStore::Detached detached = store->detach(id);
+            removed = static_cast<bool>(detached);
+            if (removed) index.erase(detached.record);
+            retire(detached);
+        }
+
+        if (removed) {
+            Logger::log(Logger::INFO, "Employee removed: ", id);
+            if (journal) journal->record_remove(id);
+            return true;
+        }
+
+        Logger::log(Logger::WARNING, "Employee not found for removal: ", id);
+        return false;
+    }
+
+    // The returned pointer is only guaranteed until the next mutation; use
+    // snapshot() when the record has to outlive concurrent writers
+    Employee* find(const std::string& id) const {
+        Metrics::Timer timer(Metrics::lookup_latency);
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        return store->find(id);
+    }
+
+    // Zero-copy read that stays valid for as long as it is held, even across a
+    // concurrent update(), remove() or rehash. Updates never modify a record in
+    // place, so the snapshot keeps showing the version it was taken from.
+    // Snapshots must not outlive the table. Returns nullptr if the ID is absent.
+    std::shared_ptr<const Employee> snapshot(const std::string& id) const {
+        Metrics::Timer timer(Metrics::lookup_latency);
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        const Employee* record = store->find(id);
+        if (!record) return nullptr;
+        return std::shared_ptr<const Employee>(reclaimer.pin(), record);
+    }
+
+    // Resolves a batch of IDs under one lock acquisition; all results share one
+    // pin. Missing IDs yield nullptr at the same position.
+    std::vector<std::shared_ptr<const Employee>> snapshot(const std::vector<std::string>& ids) const {
+        Metrics::Timer timer(Metrics::lookup_latency);
+        std::vector<std::shared_ptr<const Employee>> results;
+        results.reserve(ids.size());
+
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        auto pin = reclaimer.pin();
+        for (const auto& id : ids) {
+            const Employee* record = store->find(id);
+            results.push_back(record ? std::shared_ptr<const Employee>(pin, record) : nullptr);
+        }
+        return results;
+    }
+
+    // Point-in-time view of every record, held by address: one pointer per record
+    // instead of a copy, and no lock is held while it is iterated. Records stay
+    // valid and unchanged for as long as the view lives, so later changes are not
+    // visible through it. Like snapshots, views must not outlive the table, and a
+    // long-lived view delays reclaiming removed records.
+    class View {
+    private:
+        std::shared_ptr<const void> pin;  // An EpochReclaimer::Pin, or the pins of concatenated views
+        std::vector<const Employee*> records;
+        friend class EmployeeHashTable;
+
+    public:
+        class iterator {
+        private:
+            std::vector<const Employee*>::const_iterator it;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Employee;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Employee*;
+            using reference = const Employee&;
+
+            explicit iterator(std::vector<const Employee*>::const_iterator position) : it(position) {}
+            reference operator*() const { return **it; }
+            pointer operator->() const { return *it; }
+            iterator& operator++() { ++it; return *this; }
+            iterator operator++(int) { iterator previous = *this; ++it; return previous; }
+            bool operator==(const iterator& other) const { return it == other.it; }
+            bool operator!=(const iterator& other) const { return it != other.it; }
+        };
+
+        iterator begin() const { return iterator(records.begin()); }
+        iterator end() const { return iterator(records.end()); }
+        const Employee& operator[](size_t i) const { return *records[i]; }
+        size_t size() const { return records.size(); }
+        bool empty() const { return records.empty(); }
+
+        // One view over the records of several, each part consistent on its own;
+        // every part's records stay pinned for as long as the result lives
+        static View concat(std::vector<View>&& parts) {
+            View result;
+            auto pins = std::make_shared<std::vector<std::shared_ptr<const void>>>();
+            size_t total = 0;
+            for (const auto& part : parts) total += part.records.size();
+            result.records.reserve(total);
+            for (auto& part : parts) {
+                result.records.insert(result.records.end(), part.records.begin(), part.records.end());
+                pins->push_back(std::move(part.pin));
+            }
+            result.pin = std::move(pins);
+            return result;
+        }
+    };
+
+    View view() const {
+        View result;
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        result.pin = reclaimer.pin();
+        result.records.reserve(store->size());
+        store->for_each([&](const Employee& emp) { result.records.push_back(&emp); });
+        return result;
+    }
+
+    // Streams every record through visit without copying any of them
+    template <typename Visit>
+    void for_each(Visit&& visit) const {
+        for (const Employee& emp : view()) visit(emp);
+    }
+
+    // Org-chart queries run over the manager index under a single shared lock and
+    // walk iteratively, visiting each record at most once; a managerId loop is
+    // reported through cycle instead of recursing or repeating forever.
+
+    // Everyone under root_id in depth-first pre-order, starting with the root
+    struct OrgSubtree {
+        View members;
+        std::vector<size_t> depth;  // depth[i] belongs to members[i]; the root is 0
+        bool cycle = false;
+    };
+
+    // Managers above an employee, nearest first, up to someone without a manager
+    // or whose manager is not in the table
+    struct OrgChain {
+        View managers;
+        bool cycle = false;
+    };
+
+    struct SpanOfControl {
+        size_t direct = 0;
+        size_t total = 0;
+    };
+
+    // The top of the chart: managers with no manager of their own, and manager
+    // IDs that reports point at but that are not in the table
+    struct OrgRoots {
+        View top_managers;
+        std::vector<std::pair<std::string, size_t>> missing_managers;  // ID, report count
+    };
+
+    OrgSubtree subtree(const std::string& root_id) const {
+        OrgSubtree result;
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        const Employee* root = store->find(root_id);
+        if (!root) return result;
+
+        result.members.pin = reclaimer.pin();
+        std::unordered_set<const Employee*> visited{root};
+        std::vector<std::pair<const Employee*, size_t>> pending{{root, 0}};
+        while (!pending.empty()) {
+            auto [emp, depth] = pending.back();
+            pending.pop_back();
+            result.members.records.push_back(emp);
+            result.depth.push_back(depth);
+
+            const PostingList* reports = index.reports_of(emp->id);
+            if (!reports) continue;
+            // Pushed in reverse so reports come out in index order
+            const auto& entries = reports->entries();
+            for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+                if (visited.insert(*it).second) {
+                    pending.emplace_back(*it, depth + 1);
+                } else {
+                    result.cycle = true;
+                }
+            }
+        }
+        return result;
+    }
+
+    OrgChain chain_of_command(const std::string& id) const {
+        OrgChain result;
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        const Employee* current = store->find(id);
+        if (!current) return result;
+
+        result.managers.pin = reclaimer.pin();
+        std::unordered_set<const Employee*> visited{current};
+        while (!current->managerId.empty()) {
+            const Employee* manager = store->find(current->managerId);
+            if (!manager) break;
+            if (!visited.insert(manager).second) {
+                result.cycle = true;
+                break;
+            }
+            result.managers.records.push_back(manager);
+            current = manager;
+        }
+        return result;
+    }
+
+    SpanOfControl span_of_control(const std::string& id) const {
+        OrgSubtree tree = subtree(id);
+        SpanOfControl span;
+        if (tree.members.empty()) return span;
+        span.direct = static_cast<size_t>(std::count(tree.depth.begin(), tree.depth.end(), 1));
+        span.total = tree.members.size() - 1;
+        return span;
+    }
+
+    // Both lists are ordered by ID
+    OrgRoots org_roots() const {
+        OrgRoots result;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            result.top_managers.pin = reclaimer.pin();
+            index.for_each_manager([&](const std::string& manager_id, const PostingList& reports) {
+                const Employee* manager = store->find(manager_id);
+                if (!manager) {
+                    result.missing_managers.emplace_back(manager_id, reports.size());
+                } else if (manager->managerId.empty()) {
+                    result.top_managers.records.push_back(manager);
+                }
+            });
+        }
+
+        auto& tops = result.top_managers.records;
+        std::sort(tops.begin(), tops.end(), [](const Employee* a, const Employee* b) { return a->id < b->id; });
+        std::sort(result.missing_managers.begin(), result.missing_managers.end());
+        return result;
+    }
+
+    bool update(const std::string& id, const Employee& updated_emp) {
+        std::lock_guard<std::mutex> writer(writer_mutex);
+
+        bool exists;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            exists = store->find(id) != nullptr;
+        }
+
+        if (exists) {
+            try {
+                updated_emp.validate();
+            } catch (const EmployeeException& e) {
+                Logger::log(Logger::ERROR, "Employee update validation failed: " + std::string(e.what()));
+                throw;
+            }
+
+            Employee replacement(updated_emp);
+            {
+                std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+                EmployeeStore::Detached previous = store->replace(id, std::move(replacement));
+                index.erase(previous.record);
+                index.insert(store->find(id));
+                retire(previous);
+            }
+            Logger::log(Logger::INFO, "Employee updated: ", id);
+            if (journal) journal->record_update(id, updated_emp);
+            return true;
+        }
+
+        Logger::log(Logger::WARNING, "Employee not found for update: ", id);
+        return false;
+    }
+
+    std::vector<Employee> search(const SearchCriteria& criteria) const {
+        Metrics::Timer timer(Metrics::search_latency);
+        QueryPlan plan(criteria);
+        std::vector<Employee> results;
+        uint64_t scanned = execute(plan, [&](const Employee& emp) { results.push_back(emp); });
+        Metrics::search_rows_scanned.add(scanned);
+        Metrics::search_rows_matched.add(results.size());
+
+        Logger::log(Logger::INFO, "Search completed, found ", std::to_string(results.size()), " results");
+        return results;
+    }
+
+    // Number of records matching criteria, stopping at criteria.limit; nothing
+    // is copied
+    size_t count(const SearchCriteria& criteria) const {
+        Metrics::Timer timer(Metrics::search_latency);
+        QueryPlan plan(criteria);
+        size_t matched = 0;
+        uint64_t scanned = execute(plan, [&](const Employee&) { ++matched; });
+        Metrics::search_rows_scanned.add(scanned);
+        Metrics::search_rows_matched.add(matched);
+
+        Logger::log(Logger::INFO, "Count completed, ", std::to_string(matched), " matches");
+        return matched;
+    }
+
+    // One page of the table in sort order, copying only that page: O(log N) to
+    // seek to the cursor plus one step per record returned. The first page in
+    // an order not yet indexed builds that index under the exclusive lock.
+    EmployeePage page(const PageRequest& request) {
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            if (index.has_order(request.key)) return collect_page(request);
+        }
+
+        std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+        if (!index.has_order(request.key)) {
+            index.build_order(request.key, [&](const auto& visit) { store->for_each(visit); });
+            Logger::log(Logger::INFO, "Built sorted index for ", std::to_string(store->size()), " employees");
+        }
+        return collect_page(request);
+    }
+
+    // Typo-tolerant lookup over first names, last names and positions, best
+    // match first. Without max_edits, queries of 3-5 characters allow one edit
+    // and longer ones two; shorter queries match by substring only. The first
+    // lookup builds the term indexes under the exclusive lock.
+    std::vector<NameMatch> find_by_name(std::string_view query, size_t limit = 20,
+                                        std::optional<size_t> max_edits = std::nullopt) {
+        Metrics::Timer timer(Metrics::search_latency);
+        std::string folded = TextMatcher::fold_copy(query);
+        size_t edits = max_edits.value_or(folded.size() < 3 ? 0 : folded.size() < 6 ? 1 : 2);
+
+        std::vector<NameMatch> matches;
+        if (folded.empty() || limit == 0) return matches;
+        auto collect = [&] {
+            auto hits = index.match_names(folded, edits, limit);
+            matches.reserve(hits.size());
+            for (const auto& hit : hits) matches.push_back(NameMatch{*hit.record, hit.field, hit.quality});
+        };
+        bool indexed;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            indexed = index.has_terms();
+            if (indexed) collect();
+        }
+        if (!indexed) {
+            std::unique_lock<MeteredSharedMutex> lock(table_mutex);
+            if (!index.has_terms()) {
+                index.build_terms([&](const auto& visit) { store->for_each(visit); });
+                Logger::log(Logger::INFO, "Built name index for ", std::to_string(store->size()), " employees");
+            }
+            collect();
+        }
+
+        Logger::log(Logger::INFO, "Name lookup completed, found ", std::to_string(matches.size()), " results");
+        return matches;
+    }
+
+    std::vector<Employee> get_all() const {
+        SearchCriteria empty_criteria;
+        return search(empty_criteria);
+    }
+
+    double load_factor() const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        return store->load_factor();
+    }
+
+    size_t size() const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        return store->size();
+    }
+
+    // Running counts and salary totals, kept current by every mutation
+    TableAggregates aggregates() const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        TableAggregates totals = index.aggregates();
+        totals.occupancy_histogram = store->occupancy_histogram();
+        return totals;
+    }
+
+    // Distinct skills held by at least one record, for merging aggregates across tables
+    std::vector<InternedString> skills() const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+        return index.skills();
+    }
+
+    // Walks every record to total its heap bytes: O(n), for statistics screens
+    MemoryUsage memory_usage() const {
+        MemoryUsage usage;
+        {
+            std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+            usage.employee_count = store->size();
+            usage.store_bytes = store->memory_bytes();
+            store->for_each([&](const Employee& emp) { usage.record_heap_bytes += emp.heap_bytes(); });
+            usage.index_bytes = index.memory_bytes();
+        }
+        usage.shared_strings = StringPool::usage();
+        return usage;
+    }
+
+    void get_statistics(std::ostream& os) const {
+        std::shared_lock<MeteredSharedMutex> lock(table_mutex);
+
+        os << "Hash Table Statistics:\n"
+           << "  Backend: " << store->backend_name() << "\n"
+           << "  Bucket Count: " << store->bucket_count() << "\n"
+           << "  Element Count: " << store->size() << "\n"
+           << "  Load Factor: " << std::fixed << std::setprecision(3) << store->load_factor() << "\n"
+           << "  Records Awaiting Reclamation: " << reclaimer.pending() << "\n"
+           << "  Indexed Skills: " << index.distinct_skills() << "\n";
+        store->write_statistics(os);
+
+        const auto& histogram = store->occupancy_histogram();
+        size_t last = histogram.size();
+        while (last > 1 && histogram[last - 1] == 0) --last;
+        os << "  " << store->histogram_label() << ":";
+        for (size_t i = 0; i < last; ++i) os << " " << i << "=" << histogram[i];
+        os << "\n";
+    }
+};
+
+// ==================== BINARY STORAGE FORMAT ====================
+
+// Read-only view of a whole file. POSIX builds map it, so loading never copies
+// the bytes through a stream buffer; elsewhere it falls back to a single read.
+class MappedFile {
+public:
+    // Read-ahead hint: whole-file decoding wants it, single-record lookups do not
+    enum Access { SEQUENTIAL, RANDOM };
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#else
+    void* mapping = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path, Access access = SEQUENTIAL) {
+#ifdef _WIN32
+        static_cast<void>(access);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return;
+        buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        bytes = buffer.data();
+        length = buffer.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                ::madvise(p, static_cast<size_t>(info.st_size), access == RANDOM ? MADV_RANDOM : MADV_SEQUENTIAL);
+                mapping = p;
+                bytes = static_cast<const char*>(p);
+                length = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (mapping) ::munmap(mapping, length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Versioned columnar layout written by DataManager. After the header come, each
+// padded to 8 bytes: salary (double[N]), hire date (int64[N]), seven string
+// columns of StringRef[N], skill offsets (uint32[N+1]) into a StringRef[M] skill
+// column, department/status/access (uint8[N] each) and finally the string heap.
+// Every section offset follows from N, M and the heap size, so none are stored.
+// Values are written in host byte order; the endian tag rejects foreign files.
+class BinaryFormat {
+public:
+    static constexpr char MAGIC[4] = {'E', 'M', 'P', 'B'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ENDIAN_TAG = 0x01020304;
+
+    static bool is_binary(const char* data, size_t size) {
+        return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    // Record count from the header, or 0 when it is missing or implausible
+    static size_t record_count(const char* data, size_t size) {
+        if (size < sizeof(Header)) return 0;
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        return header.record_count <= size ? static_cast<size_t>(header.record_count) : 0;
+    }
+
+    // Records is any sized range of const Employee&. generation tags this write
+    // so that files derived from it, such as a RecordIndex, can be matched to it.
+    template <typename Records>
+    static void write(std::ostream& out, const Records& employees, uint32_t generation = 0) {
+        const size_t n = employees.size();
+        StringHeap heap;
+        std::vector<double> salaries(n);
+        std::vector<int64_t> hire_dates(n);
+        std::vector<StringRef> strings(n * STRING_COLUMNS);
+        std::vector<uint32_t> skill_offsets(n + 1);
+        std::vector<StringRef> skills;
+        std::vector<uint8_t> enums(n * 3);
+
+        size_t i = 0;
+        for (const Employee& emp : employees) {
+            salaries[i] = emp.salary;
+            hire_dates[i] = static_cast<int64_t>(std::chrono::system_clock::to_time_t(emp.hireDate));
+            const std::string_view columns[STRING_COLUMNS] = {emp.id.view(), emp.firstName, emp.lastName,
+                emp.position, emp.email, emp.phone, emp.managerId.view()};
+            for (size_t c = 0; c < STRING_COLUMNS; ++c) {
+                strings[c * n + i] = heap.add(columns[c]);
+            }
+            skill_offsets[i] = checked_u32(skills.size());
+            for (const auto& skill : emp.skills) {
+                skills.push_back(heap.add(skill));
+            }
+            enums[i] = static_cast<uint8_t>(emp.department);
+            enums[n + i] = static_cast<uint8_t>(emp.status);
+            enums[2 * n + i] = static_cast<uint8_t>(emp.accessLevel);
+            ++i;
+        }
+        skill_offsets[n] = checked_u32(skills.size());
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.endian_tag = ENDIAN_TAG;
+        header.generation = generation;
+        header.record_count = n;
+        header.skill_count = skills.size();
+        header.heap_size = heap.bytes.size();
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        write_section(out, salaries.data(), salaries.size() * sizeof(double));
+        write_section(out, hire_dates.data(), hire_dates.size() * sizeof(int64_t));
+        write_section(out, strings.data(), strings.size() * sizeof(StringRef));
+        write_section(out, skill_offsets.data(), skill_offsets.size() * sizeof(uint32_t));
+        write_section(out, skills.data(), skills.size() * sizeof(StringRef));
+        write_section(out, enums.data(), enums.size());
+        write_section(out, heap.bytes.data(), heap.bytes.size());
+    }
+
+    // Where each section of one file starts. Every record can be decoded from it
+    // on its own, which is what lets lazy loading fault in single records.
+    struct Layout {
+        uint64_t records = 0;
+        uint64_t skill_count = 0;
+        uint64_t heap_size = 0;
+        uint32_t generation = 0;
+        uint64_t salary_at = 0;
+        uint64_t hire_at = 0;
+        uint64_t strings_at = 0;
+        uint64_t skill_offsets_at = 0;
+        uint64_t skills_at = 0;
+        uint64_t enums_at = 0;
+        uint64_t heap_at = 0;
+    };
+
+    // Checks the header and that every section fits; throws when they do not
+    static Layout layout(const char* data, size_t size) {
+        if (size < sizeof(Header)) throw EmployeeException("Truncated binary data file");
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        if (!is_binary(header.magic, sizeof(header.magic)) || header.endian_tag != ENDIAN_TAG) {
+            throw EmployeeException("Unrecognized binary data file");
+        }
+        if (header.version != VERSION) {
+            throw EmployeeException("Unsupported binary data version " + std::to_string(header.version));
+        }
+
+        const uint64_t n = header.record_count;
+        const uint64_t m = header.skill_count;
+        const uint64_t limit = size;
+        if (n > limit || m > limit || header.heap_size > limit) {
+            throw EmployeeException("Corrupt binary data header");
+        }
+        Layout layout;
+        layout.records = n;
+        layout.skill_count = m;
+        layout.heap_size = header.heap_size;
+        layout.generation = header.generation;
+        uint64_t offset = sizeof(Header);
+        layout.salary_at = next_section(offset, n * sizeof(double));
+        layout.hire_at = next_section(offset, n * sizeof(int64_t));
+        layout.strings_at = next_section(offset, n * STRING_COLUMNS * sizeof(StringRef));
+        layout.skill_offsets_at = next_section(offset, (n + 1) * sizeof(uint32_t));
+        layout.skills_at = next_section(offset, m * sizeof(StringRef));
+        layout.enums_at = next_section(offset, n * 3);
+        layout.heap_at = next_section(offset, header.heap_size);
+        if (offset - padding(header.heap_size) > limit) {
+            throw EmployeeException("Truncated binary data file");
+        }
+        return layout;
+    }
+
+    // ID of record i, read without decoding the rest of it
+    static std::string_view id_of(const Layout& layout, const char* data, uint64_t i) {
+        return text(layout, data, data + layout.strings_at + i * sizeof(StringRef));
+    }
+
+    // Decodes record i; throws EmployeeException when it is malformed
+    static Employee decode(const Layout& layout, const char* data, uint64_t i) {
+        const uint64_t n = layout.records;
+        Employee emp;
+        auto column = [&](size_t c) {
+            return text(layout, data, data + layout.strings_at + (c * n + i) * sizeof(StringRef));
+        };
+        emp.id = column(0);
+        emp.firstName = column(1);
+        emp.lastName = column(2);
+        emp.position = column(3);
+        emp.email = column(4);
+        emp.phone = column(5);
+        emp.managerId = column(6);
+        emp.salary = load<double>(data + layout.salary_at + i * sizeof(double));
+        int64_t hired = load<int64_t>(data + layout.hire_at + i * sizeof(int64_t));
+        if (hired < -Employee::MAX_HIRE_SECONDS || hired > Employee::MAX_HIRE_SECONDS) {
+            throw EmployeeException("Invalid hire date for record " + emp.id.str());
+        }
+        emp.hireDate = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(hired));
+
+        uint8_t dept = static_cast<uint8_t>(data[layout.enums_at + i]);
+        uint8_t status = static_cast<uint8_t>(data[layout.enums_at + n + i]);
+        uint8_t access = static_cast<uint8_t>(data[layout.enums_at + 2 * n + i]);
+        if (dept > static_cast<uint8_t>(Department::UNKNOWN) ||
+            status > static_cast<uint8_t>(EmployeeStatus::TERMINATED) ||
+            access > static_cast<uint8_t>(AccessLevel::ADMIN)) {
+            throw EmployeeException("Invalid enumeration value for record " + emp.id.str());
+        }
+        emp.department = static_cast<Department>(dept);
+        emp.status = static_cast<EmployeeStatus>(status);
+        emp.accessLevel = static_cast<AccessLevel>(access);
+
+        uint32_t first = load<uint32_t>(data + layout.skill_offsets_at + i * sizeof(uint32_t));
+        uint32_t last = load<uint32_t>(data + layout.skill_offsets_at + (i + 1) * sizeof(uint32_t));
+        if (first > last || last > layout.skill_count) {
+            throw EmployeeException("Invalid skill range for record " + emp.id.str());
+        }
+        emp.skills.reserve(last - first);
+        for (uint32_t s = first; s < last; ++s) {
+            emp.skills.push_back(text(layout, data, data + layout.skills_at + s * sizeof(StringRef)));
+        }
+        return emp;
+    }
+
+    // Decodes every record of a mapped file into sink. Malformed records are
+    // reported through on_error and skipped; a malformed layout throws.
+    template <typename Sink, typename OnError>
+    static size_t read(const char* data, size_t size, Sink&& sink, OnError&& on_error) {
+        const Layout sections = layout(data, size);
+        size_t decoded = 0;
+        for (uint64_t i = 0; i < sections.records; ++i) {
+            try {
+                sink(decode(sections, data, i));
+                ++decoded;
+            } catch (const EmployeeException& e) {
+                on_error(e);
+            }
+        }
+        return decoded;
+    }
+
+private:
+    static constexpr size_t STRING_COLUMNS = 7;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t endian_tag;
+        uint32_t generation;  // Tag of this write, 0 in files written before it existed
+        uint64_t record_count;
+        uint64_t skill_count;
+        uint64_t heap_size;
+    };
+    static_assert(sizeof(Header) == 40, "binary header layout must stay fixed");
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+    static_assert(sizeof(StringRef) == 8, "string references must stay 8 bytes");
+
+    // Repeated values (positions, skills, manager IDs) are stored once
+    struct StringHeap {
+        std::string bytes;
+        std::unordered_map<std::string_view, StringRef> seen;  // Views into the records being written
+
+        StringRef add(std::string_view value) {
+            auto it = seen.find(value);
+            if (it != seen.end()) return it->second;
+            StringRef ref{checked_u32(bytes.size()), checked_u32(value.size())};
+            bytes += value;
+            checked_u32(bytes.size());
+            seen.emplace(value, ref);
+            return ref;
+        }
+    };
+
+    static uint32_t checked_u32(size_t value) {
+        if (value > std::numeric_limits<uint32_t>::max()) {
+            throw EmployeeException("Data set too large for binary format version " + std::to_string(VERSION));
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    static uint64_t padding(uint64_t bytes) { return (8 - bytes % 8) % 8; }
+
+    static uint64_t next_section(uint64_t& offset, uint64_t bytes) {
+        uint64_t at = offset;
+        offset += bytes + padding(bytes);
+        return at;
+    }
+
+    static std::string_view text(const Layout& layout, const char* data, const char* at) {
+        StringRef ref = load<StringRef>(at);
+        if (static_cast<uint64_t>(ref.offset) + ref.length > layout.heap_size) {
+            throw EmployeeException("String reference outside heap");
+        }
+        return std::string_view(data + layout.heap_at + ref.offset, ref.length);
+    }
+
+    static void write_section(std::ostream& out, const void* data, size_t bytes) {
+        static const char zeros[8] = {};
+        if (bytes) out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        out.write(zeros, static_cast<std::streamsize>(padding(bytes)));
+    }
+
+    template <typename T>
+    static T load(const char* at) {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+};
+
+// Persisted ID -> record number map for one binary data file, written beside it
+// so a lazy open can find any record without reading the others. Slots hold
+// record numbers in an open-addressing table probed linearly; the table is
+// sized to a power of two at least twice the record count. A record's slot is
+// picked from its ID only, so candidates are confirmed against the data file.
+// The header repeats the data file's generation, record count and size, and an
+// index that disagrees with its data file is ignored.
+class RecordIndex {
+public:
+    static constexpr char MAGIC[4] = {'E', 'M', 'P', 'I'};
+    static constexpr uint32_t VERSION = 1;
+
+    // What an index must agree with to describe a data file
+    struct Stamp {
+        uint32_t generation = 0;
+        uint64_t records = 0;
+        uint64_t data_size = 0;
+
+        bool operator==(const Stamp& other) const {
+            return generation == other.generation && records == other.records && data_size == other.data_size;
+        }
+    };
+
+    // id_of(i) is the ID of record i. Records sharing an ID are probed in file
+    // order, so the first of them is found first, as in a load.
+    template <typename IdOf>
+    static RecordIndex build(const Stamp& stamp, IdOf&& id_of) {
+        if (stamp.records >= EMPTY) throw EmployeeException("Too many records for a record index");
+        RecordIndex index;
+        index.stamp = stamp;
+        index.bits = MIN_BITS;
+        while ((uint64_t(1) << index.bits) < stamp.records * 2) ++index.bits;
+        index.owned.assign(size_t(1) << index.bits, EMPTY);
+        const uint64_t mask = index.owned.size() - 1;
+        for (uint64_t i = 0; i < stamp.records; ++i) {
+            uint64_t slot = index.home(id_of(i));
+            while (index.owned[slot] != EMPTY) slot = (slot + 1) & mask;
+            index.owned[slot] = static_cast<uint32_t>(i);
+        }
+        index.slots = index.owned.data();
+        return index;
+    }
+
+    // Maps an index file; returns nothing when it is missing, malformed or
+    // stamped for another version of the data file
+    static std::optional<RecordIndex> open(const std::string& path, const Stamp& expected) {
+        RecordIndex index;
+        index.mapped = std::make_unique<MappedFile>(path, MappedFile::RANDOM);
+        const char* data = index.mapped->data();
+        const size_t size = index.mapped->size();
+        if (size < sizeof(Header)) return std::nullopt;
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.bits < MIN_BITS || header.bits > MAX_BITS) {
+            return std::nullopt;
+        }
+        index.stamp = {header.generation, header.records, header.data_size};
+        index.bits = header.bits;
+        const uint64_t capacity = uint64_t(1) << header.bits;
+        if (!(index.stamp == expected) || expected.generation == 0 || capacity <= header.records ||
+            size != sizeof(Header) + capacity * sizeof(uint32_t)) {
+            return std::nullopt;
+        }
+        index.slots = reinterpret_cast<const uint32_t*>(data + sizeof(Header));
+        return index;
+    }
+
+    // Writes through a temporary file, so a reader never maps half an index
+    void save(const std::string& path) const {
+        std::string temp_file = path + ".tmp";
+        {
+            std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.generation = stamp.generation;
+            header.bits = bits;
+            header.records = stamp.records;
+            header.data_size = stamp.data_size;
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(slots),
+                       static_cast<std::streamsize>((size_t(1) << bits) * sizeof(uint32_t)));
+            file.close();
+            if (!file) throw EmployeeException("Failed to write " + temp_file);
+        }
+        if (std::rename(temp_file.c_str(), path.c_str()) != 0) {
+            throw EmployeeException("Failed to replace " + path);
+        }
+    }
+
+    // Calls visit(record) for each record that may hold id, in probe order,
+    // until visit returns true. Slots of an opened index are not checked up
+    // front, so a probe that wraps around without meeting an empty slot stops
+    // and returns false: the index is corrupt and should be rebuilt.
+    template <typename Visit>
+    bool probe(std::string_view id, Visit&& visit) const {
+        const uint64_t capacity = uint64_t(1) << bits;
+        uint64_t slot = home(id);
+        for (uint64_t step = 0; step < capacity; ++step, slot = (slot + 1) & (capacity - 1)) {
+            if (slots[slot] == EMPTY) return true;
+            if (slots[slot] < stamp.records && visit(static_cast<uint64_t>(slots[slot]))) return true;
+        }
+        return false;
+    }
+
+    const Stamp& describes() const { return stamp; }
+    uint64_t size_bytes() const { return sizeof(Header) + (uint64_t(1) << bits) * sizeof(uint32_t); }
+
+private:
+    static constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t MIN_BITS = 4;
+    static constexpr uint32_t MAX_BITS = 33;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t generation;
+        uint32_t bits;  // log2 of the slot count
+        uint64_t records;
+        uint64_t data_size;
+    };
+    static_assert(sizeof(Header) == 32, "record index header layout must stay fixed");
+
+    Stamp stamp;
+    uint32_t bits = MIN_BITS;
+    const uint32_t* slots = nullptr;
+    std::vector<uint32_t> owned;         // Slots of a built index
+    std::unique_ptr<MappedFile> mapped;  // Slots of an opened index
+
+    RecordIndex() = default;
+
+    // Fibonacci mixing spreads FNV-1a's weak high bits before they pick the slot
+    uint64_t home(std::string_view id) const {
+        return (static_cast<uint64_t>(fnv1a_hash(id)) * 0x9E3779B97F4A7C15ULL) >> (64 - bits);
+    }
+};
+
+// ==================== WRITE-AHEAD LOG ====================
+
+// Append-only journal of mutations since the last checkpoint of the data file.
+// Each entry is framed as [body length][checksum][body], where the body is the
+// operation code, the target ID and, for inserts and updates, the full record.
+// Entries carry whole records, so replaying them over a state that already
+// contains some of them (a checkpoint racing a writer, or a crash between a
+// checkpoint and the removal of the log it sealed) converges to the same result.
+// A batch is one frame holding all its entries, so a crash keeps all or none of
+// it. Not thread-safe; DataManager serializes access.
+class WriteAheadLog {
+public:
+    enum class Op : uint8_t { INSERT = 1, UPDATE = 2, REMOVE = 3, BATCH = 4 };
+
+    struct Entry {
+        Op op;
+        std::string id;
+        Employee record;
+    };
+
+    explicit WriteAheadLog(const std::string& path) : path(path) {}
+
+    // Opens for appending, writing a fresh header if the log is missing or empty
+    void open() {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        bytes = existing.is_open() ? static_cast<uint64_t>(existing.tellg()) : 0;
+        existing.close();
+
+        if (bytes < sizeof(HEADER)) {
+            reset();
+            return;
+        }
+        out.open(path, std::ios::binary | std::ios::app);
+        if (!out.is_open()) throw EmployeeException("Cannot open write-ahead log: " + path);
+    }
+
+    // Drops every entry; called once their effects are in a checkpoint
+    void reset() {
+        out.close();
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) throw EmployeeException("Cannot open write-ahead log: " + path);
+        out.write(HEADER, sizeof(HEADER));
+        out.flush();
+        bytes = sizeof(HEADER);
+        entries = 0;
+        failed = false;
+    }
+
+    // Hands every entry so far to sealed_path for a checkpoint to fold in and
+    // starts an empty log, so writers keep appending while the checkpoint runs.
+    // Entries still sealed from a checkpoint that failed stay ahead of these.
+    void seal(const std::string& sealed_path) {
+        out.close();
+        try {
+            if (failed) cut_torn_frame();
+            std::ifstream previous(sealed_path, std::ios::binary | std::ios::ate);
+            std::streamoff sealed_bytes = previous.is_open() ? std::streamoff(previous.tellg()) : 0;
+            bool extend = sealed_bytes > std::streamoff(sizeof(HEADER));
+            previous.close();
+            if (!extend) {
+                if (std::rename(path.c_str(), sealed_path.c_str()) != 0) {
+                    throw EmployeeException("Cannot seal write-ahead log: " + path);
+                }
+            } else if (bytes > sizeof(HEADER)) {
+                std::ifstream current(path, std::ios::binary);
+                current.seekg(sizeof(HEADER));
+                std::ofstream sealed(sealed_path, std::ios::binary | std::ios::app);
+                sealed << current.rdbuf();
+                sealed.flush();
+                if (!sealed) {
+                    // The entries stay in this log; a partial copy would hide later ones from replay
+                    sealed.close();
+                    std::error_code error;
+                    std::filesystem::resize_file(sealed_path, static_cast<uintmax_t>(sealed_bytes), error);
+                    throw EmployeeException("Cannot extend sealed write-ahead log: " + sealed_path);
+                }
+            }
+        } catch (...) {
+            open();
+            throw;
+        }
+        reset();
+    }
+
+    void close() { out.close(); }
+
+    uint64_t size_bytes() const { return bytes; }
+    bool empty() const { return bytes <= sizeof(HEADER); }
+    size_t entry_count() const { return entries; }
+
+    void append_insert(const Employee& emp) { append(Op::INSERT, emp.id, &emp); }
+    void append_update(const std::string& id, const Employee& emp) { append(Op::UPDATE, id, &emp); }
+    void append_remove(const std::string& id) { append(Op::REMOVE, id, nullptr); }
+
+    void append_batch(const std::vector<CommittedChange>& changes) {
+        body.clear();
+        put(body, static_cast<uint8_t>(Op::BATCH));
+        put(body, static_cast<uint32_t>(changes.size()));
+        for (const auto& change : changes) {
+            Op op = change.op == MutationOp::INSERT ? Op::INSERT : change.op == MutationOp::UPDATE ? Op::UPDATE
+                                                                                                    : Op::REMOVE;
+            encode_entry(body, op, change.id, change.record);
+        }
+        write_frame(changes.size());
+    }
+
+    // Applies every intact entry in order and returns how many were applied. A
+    // torn, corrupt or undecodable tail, as left by a crash mid-append, ends the
+    // replay and is cut off so later appends follow the last good entry.
+    template <typename Apply>
+    static size_t replay(const std::string& path, Apply&& apply) {
+        MappedFile mapped(path);
+        if (mapped.size() == 0) return 0;
+        if (mapped.size() < sizeof(HEADER) || std::memcmp(mapped.data(), HEADER, sizeof(HEADER)) != 0) {
+            throw EmployeeException("Unrecognized write-ahead log: " + path);
+        }
+
+        const char* data = mapped.data();
+        size_t offset = sizeof(HEADER);
+        size_t applied = 0;
+        while (offset < mapped.size()) {
+            Reader frame{data + offset, mapped.size() - offset};
+            uint32_t length, checksum;
+            if (!frame.try_read(length) || !frame.try_read(checksum) || length > frame.remaining() ||
+                body_checksum(frame.at, length) != checksum) {
+                break;
+            }
+
+            Reader body{frame.at, length};
+            std::vector<Entry> decoded;
+            try {
+                if (body.remaining() > 0 && static_cast<Op>(*body.at) == Op::BATCH) {
+                    body.read<uint8_t>();
+                    uint32_t count = body.read<uint32_t>();
+                    decoded.reserve(std::min<size_t>(count, length));
+                    for (uint32_t i = 0; i < count; ++i) decoded.push_back(decode(body));
+                } else {
+                    decoded.push_back(decode(body));
+                }
+            } catch (const EmployeeException& e) {
+                Logger::log(Logger::WARNING, "Malformed write-ahead log entry in ", path, ": ", e.what());
+                break;
+            }
+            for (auto& entry : decoded) apply(entry);
+            applied += decoded.size();
+            offset += FRAME_OVERHEAD + length;
+        }
+
+        if (offset < mapped.size()) {
+            Logger::log(Logger::WARNING, "Discarding ", std::to_string(mapped.size() - offset),
+                        " bytes of incomplete write-ahead log entries from ", path);
+            std::string intact(data, offset);
+            std::ofstream rewrite(path, std::ios::binary | std::ios::trunc);
+            rewrite.write(intact.data(), static_cast<std::streamsize>(intact.size()));
+        }
+        return applied;
+    }
+
+private:
+    static constexpr char HEADER[8] = {'E', 'M', 'P', 'W', 1, 0, 0, 0};
+    static constexpr size_t FRAME_OVERHEAD = 2 * sizeof(uint32_t);
+
+    std::string path;
+    std::ofstream out;
+    uint64_t bytes = 0;
+    size_t entries = 0;
+    bool failed = false;  // A torn frame could not be cut off; refuse appends until reset()
+    std::string body;  // Reused between appends
+
+    struct Reader {
+        const char* at;
+        size_t left;
+
+        size_t remaining() const { return left; }
+
+        template <typename T>
+        bool try_read(T& value) {
+            if (left < sizeof(T)) return false;
+            std::memcpy(&value, at, sizeof(T));
+            at += sizeof(T);
+            left -= sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        T read() {
+            T value;
+            if (!try_read(value)) throw EmployeeException("Truncated write-ahead log entry");
+            return value;
+        }
+
+        // Points into the entry being decoded
+        std::string_view read_string() {
+            uint32_t length = read<uint32_t>();
+            if (length > left) throw EmployeeException("Truncated write-ahead log entry");
+            std::string_view value(at, length);
+            at += length;
+            left -= length;
+            return value;
+        }
+    };
+
+    static uint32_t body_checksum(const char* data, size_t size) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    template <typename T>
+    static void put(std::string& buffer, T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void put_string(std::string& buffer, std::string_view value) {
+        put(buffer, static_cast<uint32_t>(value.size()));
+        buffer += value;
+    }
+
+    static void encode_record(std::string& buffer, const Employee& emp) {
+        for (std::string_view field : {emp.id.view(), std::string_view(emp.firstName), std::string_view(emp.lastName),
+                                       std::string_view(emp.position), std::string_view(emp.email),
+                                       std::string_view(emp.phone), emp.managerId.view()}) {
+            put_string(buffer, field);
+        }
+        put(buffer, emp.salary);
+        put(buffer, static_cast<int64_t>(std::chrono::system_clock::to_time_t(emp.hireDate)));
+        put(buffer, static_cast<uint8_t>(emp.department));
+        put(buffer, static_cast<uint8_t>(emp.status));
+        put(buffer, static_cast<uint8_t>(emp.accessLevel));
+        put(buffer, static_cast<uint32_t>(emp.skills.size()));
+        for (const auto& skill : emp.skills) put_string(buffer, skill);
+    }
+
+    static Employee decode_record(Reader& in) {
+        Employee emp;
+        emp.id = in.read_string();
+        emp.firstName = in.read_string();
+        emp.lastName = in.read_string();
+        emp.position = in.read_string();
+        emp.email = in.read_string();
+        emp.phone = in.read_string();
+        emp.managerId = in.read_string();
+        emp.salary = in.read<double>();
+        int64_t hired = in.read<int64_t>();
+        if (hired < -Employee::MAX_HIRE_SECONDS || hired > Employee::MAX_HIRE_SECONDS) {
+            throw EmployeeException("Invalid hire date in write-ahead log entry");
+        }
+        emp.hireDate = std::chrono::system_clock::from_time_t(static_cast<std::time_t>(hired));
+        uint8_t dept = in.read<uint8_t>(), status = in.read<uint8_t>(), access = in.read<uint8_t>();
+        if (dept > static_cast<uint8_t>(Department::UNKNOWN) ||
+            status > static_cast<uint8_t>(EmployeeStatus::TERMINATED) ||
+            access > static_cast<uint8_t>(AccessLevel::ADMIN)) {
+            throw EmployeeException("Invalid enumeration value in write-ahead log entry");
+        }
+        emp.department = static_cast<Department>(dept);
+        emp.status = static_cast<EmployeeStatus>(status);
+        emp.accessLevel = static_cast<AccessLevel>(access);
+        uint32_t skill_count = in.read<uint32_t>();
+        for (uint32_t i = 0; i < skill_count; ++i) emp.skills.push_back(in.read_string());
+        return emp;
+    }
+
+    static Entry decode(Reader& in) {
+        Entry entry;
+        entry.op = static_cast<Op>(in.read<uint8_t>());
+        entry.id = in.read_string();
+        if (entry.op == Op::INSERT || entry.op == Op::UPDATE) {
+            entry.record = decode_record(in);
+        } else if (entry.op != Op::REMOVE) {
+            throw EmployeeException("Unknown write-ahead log operation");
+        }
+        return entry;
+    }
+
+    static void encode_entry(std::string& buffer, Op op, std::string_view id, const Employee* emp) {
+        put(buffer, static_cast<uint8_t>(op));
+        put_string(buffer, id);
+        if (emp) encode_record(buffer, *emp);
+    }
+
+    void append(Op op, const std::string& id, const Employee* emp) {
+        body.clear();
+        encode_entry(body, op, id, emp);
+        write_frame(1);
+    }
+
+    // The entry reaches the OS before the mutating call returns, so it survives a
+    // process crash. A failed write is cut back to the last whole frame and
+    // throws: replay stops at a torn frame, so nothing may follow one.
+    void write_frame(size_t count) {
+        if (failed) throw EmployeeException("Write-ahead log has a torn entry: " + path);
+        std::string frame;
+        frame.reserve(FRAME_OVERHEAD);
+        put(frame, static_cast<uint32_t>(body.size()));
+        put(frame, body_checksum(body.data(), body.size()));
+        out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+        out.flush();
+        if (!out) {
+            out.close();
+            try {
+                cut_torn_frame();
+                out.open(path, std::ios::binary | std::ios::app);
+                failed = !out.is_open();
+            } catch (const EmployeeException&) {
+                failed = true;
+            }
+            throw EmployeeException("Failed to append to write-ahead log " + path);
+        }
+        bytes += FRAME_OVERHEAD + body.size();
+        entries += count;
+        Metrics::wal_bytes.add(FRAME_OVERHEAD + body.size());
+    }
+
+    void cut_torn_frame() {
+        std::error_code error;
+        std::filesystem::resize_file(path, bytes, error);
+        if (error) throw EmployeeException("Cannot cut torn entry from write-ahead log " + path + ": " + error.message());
+        failed = false;
+    }
+};
+
+// ==================== CSV INTERCHANGE FORMAT ====================
+
+// Spreadsheet format for export_csv/import_csv: a header line, then one record per
+// row with RFC 4180 quoting (fields holding a comma, quote or line break are
+// quoted, quotes doubled). Rows end at a '\n' outside quotes; the import counts
+// quotes per byte range first so each thread knows where its first row starts.
+class CsvFormat {
+public:
+    static constexpr std::string_view HEADER =
+        "ID,FirstName,LastName,Position,Department,Salary,Email,Phone,HireDate,Status,ManagerID,Skills,AccessLevel";
+    static constexpr size_t COLUMNS = 13;
+
+    // Rows formatted per worker before the buffers are flushed in order
+    static constexpr size_t CHUNK_ROWS = 8192;
+    static constexpr size_t MIN_BYTES_PER_WORKER = size_t(1) << 20;
+
+    // Records is a random-access sized range of const Employee&. Returns the
+    // number of rows written.
+    template <typename Records>
+    static size_t write(std::ostream& out, const Records& employees) {
+        out << HEADER << "\n";
+
+        const size_t n = employees.size();
+        const size_t workers = ParallelRange::workers_for(n, CHUNK_ROWS);
+        std::vector<std::string> buffers(workers);
+        std::vector<DateCache> dates(workers);
+
+        for (size_t round = 0; round < n; round += workers * CHUNK_ROWS) {
+            size_t round_rows = std::min(n - round, workers * CHUNK_ROWS);
+            ParallelRange::run(round_rows, workers, [&](size_t worker, size_t begin, size_t end) {
+                std::string& buffer = buffers[worker];
+                buffer.clear();
+                for (size_t i = round + begin; i < round + end; ++i) {
+                    append_row(buffer, employees[i], dates[worker]);
+                }
+            });
+            for (const auto& buffer : buffers) out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        return n;
+    }
+
+    struct RowError {
+        size_t line;
+        std::string message;
+    };
+
+    // Parses every data row in file order. Malformed rows are skipped and reported
+    // through errors with their 1-based line number; a missing or foreign header
+    // throws. Field values are not validated here; bulk_insert() does that.
+    static std::vector<Employee> read(const char* data, size_t size, std::vector<RowError>& errors) {
+        if (size == 0) throw EmployeeException("Empty CSV file");
+        const char* end = data + size;
+        const char* body = data;
+        if (size >= 3 && std::memcmp(body, "\xEF\xBB\xBF", 3) == 0) body += 3;  // UTF-8 BOM
+
+        const char* header_end = static_cast<const char*>(std::memchr(body, '\n', static_cast<size_t>(end - body)));
+        if (!header_end) header_end = end;
+        if (trim_cr(std::string_view(body, static_cast<size_t>(header_end - body))) != HEADER) {
+            throw EmployeeException("Unrecognized CSV header; expected " + std::string(HEADER));
+        }
+        body = header_end == end ? end : header_end + 1;
+
+        // Each worker owns the rows that start inside its byte range. Whether a
+        // range starts inside a quoted field follows from the quotes before it.
+        const size_t length = static_cast<size_t>(end - body);
+        const size_t workers = ParallelRange::workers_for(length, MIN_BYTES_PER_WORKER);
+        std::vector<std::vector<Employee>> parsed(workers);
+        std::vector<std::vector<RowError>> failed(workers);
+        std::vector<size_t> lines(workers, 0);
+        std::vector<char> quoted(workers, 0);
+
+        if (workers > 1) {
+            ParallelRange::run(length, workers, [&](size_t worker, size_t begin, size_t stop) {
+                quoted[worker] = odd_quotes(body + begin, body + stop);
+            });
+            char inside = 0;
+            for (size_t worker = 0; worker < workers; ++worker) {
+                char range = quoted[worker];
+                quoted[worker] = inside;
+                inside ^= range;
+            }
+        }
+
+        ParallelRange::run(length, workers, [&](size_t worker, size_t begin, size_t stop) {
+            const char* p = body + begin;
+            if (begin > 0 && (quoted[worker] || p[-1] != '\n')) {
+                size_t skipped = 0;
+                p = row_end(p, end, quoted[worker], skipped);
+                p = p == end ? end : p + 1;
+            }
+
+            auto& records = parsed[worker];
+            records.reserve((stop - begin) / 128);
+            DateParser dates;
+            std::array<std::string, COLUMNS> fields;
+            size_t line = 0;
+            while (p < body + stop) {
+                const char* eol = row_end(p, end, false, line);
+                std::string_view row = trim_cr(std::string_view(p, static_cast<size_t>(eol - p)));
+                size_t row_line = line - std::count(row.begin(), row.end(), '\n');
+                p = eol == end ? end : eol + 1;
+                ++line;
+                if (row.empty()) continue;
+
+                const char* problem = split_row(row, fields);
+                if (!problem) {
+                    records.emplace_back();
+                    problem = decode_row(fields, records.back(), dates);
+                    if (problem) records.pop_back();
+                }
+                if (problem) failed[worker].push_back(RowError{row_line + 1, problem});
+            }
+            lines[worker] = line;
+        });
+
+        // Line numbers are per worker until offset by the lines before them
+        size_t total = 0;
+        size_t first_line = 2;
+        for (size_t worker = 0; worker < workers; ++worker) {
+            total += parsed[worker].size();
+            for (auto& error : failed[worker]) {
+                error.line += first_line - 1;
+                errors.push_back(std::move(error));
+            }
+            first_line += lines[worker];
+        }
+
+        std::vector<Employee> employees = std::move(parsed[0]);
+        employees.reserve(total);
+        for (size_t worker = 1; worker < workers; ++worker) {
+            std::move(parsed[worker].begin(), parsed[worker].end(), std::back_inserter(employees));
+        }
+        return employees;
+    }
+
+private:
+    static constexpr const char* DEPARTMENT_NAMES[] = {"Engineering", "HR", "Finance", "Marketing",
+                                                       "Operations", "Sales", "Unknown"};
+    static constexpr const char* STATUS_NAMES[] = {"Active", "Inactive", "On Leave", "Terminated"};
+
+    static char odd_quotes(const char* p, const char* end) {
+        char odd = 0;
+        while ((p = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p))))) {
+            odd ^= 1;
+            ++p;
+        }
+        return odd;
+    }
+
+    // The first '\n' at or after p outside quotes, or end; inside says whether p
+    // is in a quoted field. Adds the line breaks passed inside quotes to lines.
+    static const char* row_end(const char* p, const char* end, bool inside, size_t& lines) {
+        while (true) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!eol) return end;
+            if (odd_quotes(p, eol)) inside = !inside;
+            if (!inside) return eol;
+            ++lines;
+            p = eol + 1;
+        }
+    }
+
+    static std::string_view trim_cr(std::string_view text) {
+        return (!text.empty() && text.back() == '\r') ? text.substr(0, text.size() - 1) : text;
+    }
+
+    static bool local_date(std::time_t t, std::tm& out) {
+#ifdef _WIN32
+        return localtime_s(&out, &t) == 0;
+#else
+        return localtime_r(&t, &out) != nullptr;
+#endif
+    }
+
+    // Hire dates are mostly whole days shared by many records, so recent
+    // conversions are kept; a miss costs one localtime_r, never mktime, which
+    // rereads the zone rules on every call
+    class DateCache {
+    private:
+        struct Entry {
+            std::time_t when = 0;
+            bool filled = false;
+            char text[10] = {};
+        };
+        std::array<Entry, 64> entries{};
+
+        static void put_digits(char* out, int value, int width) {
+            for (int i = width - 1; i >= 0; --i, value /= 10) out[i] = static_cast<char>('0' + value % 10);
+        }
+
+    public:
+        std::string_view format(std::chrono::system_clock::time_point when) {
+            std::time_t t = std::chrono::system_clock::to_time_t(when);
+            Entry& entry = entries[static_cast<size_t>(t) % entries.size()];
+            if (!entry.filled || entry.when != t) {
+                std::tm day{};
+                if (!local_date(t, day)) return {};
+                int year = day.tm_year + 1900;
+                if (year < 0 || year > 9999) return {};
+                put_digits(entry.text, year, 4);
+                entry.text[4] = '-';
+                put_digits(entry.text + 5, day.tm_mon + 1, 2);
+                entry.text[7] = '-';
+                put_digits(entry.text + 8, day.tm_mday, 2);
+                entry.when = t;
+                entry.filled = true;
+            }
+            return std::string_view(entry.text, 10);
+        }
+    };
+
+    // Local midnight for each distinct YYYY-MM-DD seen by one import worker
+    class DateParser {
+    private:
+        std::unordered_map<uint32_t, std::time_t> days;
+
+        static bool digits(std::string_view text, size_t from, size_t count, int& value) {
+            value = 0;
+            for (size_t i = from; i < from + count; ++i) {
+                if (text[i] < '0' || text[i] > '9') return false;
+                value = value * 10 + (text[i] - '0');
+            }
+            return true;
+        }
+
+    public:
+        bool parse(std::string_view text, std::chrono::system_clock::time_point& when) {
+            int year, month, day;
+            if (text.size() != 10 || text[4] != '-' || text[7] != '-' ||
+                !digits(text, 0, 4, year) || !digits(text, 5, 2, month) || !digits(text, 8, 2, day) ||
+                month < 1 || month > 12 || day < 1 || day > 31) {
+                return false;
+            }
+
+            uint32_t key = static_cast<uint32_t>(year * 10000 + month * 100 + day);
+            auto it = days.find(key);
+            if (it == days.end()) {
+                std::tm midnight{};
+                midnight.tm_year = year - 1900;
+                midnight.tm_mon = month - 1;
+                midnight.tm_mday = day;
+                midnight.tm_isdst = -1;
+                std::time_t t;
+                {
+                    // mktime() shares the process time zone state; calls are per
+                    // distinct day, so serializing them costs nothing
+                    static std::mutex zone_mutex;
+                    std::lock_guard<std::mutex> lock(zone_mutex);
+                    t = std::mktime(&midnight);
+                }
+                if (t == -1 || midnight.tm_mday != day) return false;  // e.g. 2023-02-30
+                it = days.emplace(key, t).first;
+            }
+            when = std::chrono::system_clock::from_time_t(it->second);
+            return true;
+        }
+    };
+
+    static void append_field(std::string& out, std::string_view field) {
+        if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out.append(field);
+            return;
+        }
+        append_quoted(out, field);
+    }
+
+    static void append_quoted(std::string& out, std::string_view field) {
+        out.push_back('"');
+        for (char c : field) {
+            if (c == '"') out.push_back('"');
+            out.push_back(c);
+        }
+        out.push_back('"');
+    }
+
+    static void append_row(std::string& out, const Employee& emp, DateCache& dates) {
+        // Shortest text that reads back to the same double
+        char salary[32];
+        auto printed = std::to_chars(salary, salary + sizeof(salary), emp.salary);
+
+        append_field(out, emp.id); out.push_back(',');
+        append_field(out, emp.firstName); out.push_back(',');
+        append_field(out, emp.lastName); out.push_back(',');
+        append_field(out, emp.position); out.push_back(',');
+        out.append(DEPARTMENT_NAMES[static_cast<size_t>(emp.department)]); out.push_back(',');
+        out.append(salary, printed.ptr); out.push_back(',');
+        append_field(out, emp.email); out.push_back(',');
+        append_field(out, emp.phone); out.push_back(',');
+        out.append(dates.format(emp.hireDate)); out.push_back(',');
+        out.append(STATUS_NAMES[static_cast<size_t>(emp.status)]); out.push_back(',');
+        append_field(out, emp.managerId); out.push_back(',');
+
+        std::string skills;
+        for (size_t i = 0; i < emp.skills.size(); ++i) {
+            if (i) skills.push_back(';');
+            skills.append(emp.skills[i]);
+        }
+        append_quoted(out, skills);
+        out.push_back(',');
+        out.append(emp.getAccessLevelString());
+        out.push_back('\n');
+    }
+
+    // Returns nullptr on success or a description of what is wrong with the row
+    static const char* split_row(std::string_view row, std::array<std::string, COLUMNS>& fields) {
+        const char* p = row.data();
+        const char* end = p + row.size();
+        for (size_t column = 0; column < COLUMNS; ++column) {
+            if (p > end) return "Too few columns";
+            std::string& field = fields[column];
+            field.clear();
+
+            if (p < end && *p == '"') {
+                ++p;
+                while (true) {
+                    const char* quote = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p)));
+                    if (!quote) return "Unterminated quoted field";
+                    field.append(p, quote);
+                    p = quote + 1;
+                    if (p < end && *p == '"') {
+                        field.push_back('"');
+                        ++p;
+                    } else {
+                        break;
+                    }
+                }
+                if (p < end && *p != ',') return "Unexpected character after quoted field";
+            } else {
+                const char* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(end - p)));
+                const char* stop = comma ? comma : end;
+                field.assign(p, stop);
+                p = stop;
+            }
+            ++p;  // Past the comma, or one past the end after the last field
+        }
+        return p > end ? nullptr : "Too many columns";
+    }
+
+    template <size_t N>
+    static bool lookup(const std::string& name, const char* const (&names)[N], size_t& value) {
+        for (size_t i = 0; i < N; ++i) {
+            if (name == names[i]) {
+                value = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static const char* decode_row(std::array<std::string, COLUMNS>& fields, Employee& emp, DateParser& dates) {
+        size_t department, status;
+        if (!lookup(fields[4], DEPARTMENT_NAMES, department)) return "Unknown department";
+        if (!lookup(fields[9], STATUS_NAMES, status)) return "Unknown status";
+        if (fields[12] != "Admin" && fields[12] != "Basic") return "Unknown access level";
+
+        const std::string& salary = fields[5];
+        auto parsed = std::from_chars(salary.data(), salary.data() + salary.size(), emp.salary);
+        if (parsed.ec != std::errc() || parsed.ptr != salary.data() + salary.size()) return "Invalid salary";
+        if (!dates.parse(fields[8], emp.hireDate)) return "Invalid hire date";
+
+        emp.id = std::move(fields[0]);
+        emp.firstName = std::move(fields[1]);
+        emp.lastName = std::move(fields[2]);
+        emp.position = std::move(fields[3]);
+        emp.department = static_cast<Department>(department);
+        emp.email = std::move(fields[6]);
+        emp.phone = std::move(fields[7]);
+        emp.status = static_cast<EmployeeStatus>(status);
+        emp.managerId = std::move(fields[10]);
+        emp.accessLevel = fields[12] == "Admin" ? AccessLevel::ADMIN : AccessLevel::BASIC;
+
+        std::string_view skills = fields[11];
+        while (!skills.empty()) {
+            size_t semicolon = skills.find(';');
+            std::string_view skill = skills.substr(0, semicolon);
+            if (!skill.empty()) emp.skills.emplace_back(skill);
+            if (semicolon == std::string_view::npos) break;
+            skills.remove_prefix(semicolon + 1);
+        }
+        return nullptr;
+    }
+};
+
+// ==================== BACKUP ARCHIVES ====================
+
+// LZ77 block compression in the LZ4 sequence layout: a token holding 4-bit
+// literal and match lengths (longer ones continue in 255-runs), the literals,
+// then a 16-bit back offset. Matches are found greedily through a hash of
+// 4-byte prefixes and there is no entropy stage, so both directions run at
+// memory speed, which suits repetitive text like serialized records.
+class BlockCodec {
+public:
+    static void compress(std::string_view input, std::string& out) {
+        const char* src = input.data();
+        const size_t n = input.size();
+        std::array<uint32_t, size_t(1) << HASH_BITS> recent{};  // Position + 1 of the last prefix per hash
+
+        size_t anchor = 0;
+        size_t i = 0;
+        while (i + MIN_MATCH <= n) {
+            uint32_t prefix = load32(src + i);
+            uint32_t& slot = recent[(prefix * 2654435761u) >> (32 - HASH_BITS)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(i + 1);
+            if (candidate == 0 || i + 1 - candidate > MAX_OFFSET || load32(src + candidate - 1) != prefix) {
+                ++i;
+                continue;
+            }
+
+            size_t match = candidate - 1;
+            size_t length = MIN_MATCH;
+            while (i + length < n && src[match + length] == src[i + length]) ++length;
+            put_sequence(out, src + anchor, i - anchor, i - match, length);
+            i += length;
+            anchor = i;
+        }
+        put_sequence(out, src + anchor, n - anchor, 0, 0);
+    }
+
+    // Throws if input does not decode to exactly size bytes
+    static void decompress(std::string_view input, char* out, size_t size) {
+        const auto* in = reinterpret_cast<const unsigned char*>(input.data());
+        const auto* end = in + input.size();
+        auto fail = [] { throw EmployeeException("Corrupt compressed block"); };
+        auto extended = [&](size_t length) {
+            if (length != 15) return length;
+            unsigned char next;
+            do {
+                if (in == end) fail();
+                next = *in++;
+                length += next;
+            } while (next == 255);
+            return length;
+        };
+
+        size_t pos = 0;
+        while (in < end) {
+            unsigned token = *in++;
+            size_t literals = extended(token >> 4);
+            if (literals > static_cast<size_t>(end - in) || literals > size - pos) fail();
+            std::memcpy(out + pos, in, literals);
+            in += literals;
+            pos += literals;
+            if (in == end) break;
+
+            if (end - in < 2) fail();
+            size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+            in += 2;
+            size_t length = extended(token & 15) + MIN_MATCH;
+            if (offset == 0 || offset > pos || length > size - pos) fail();
+            // Byte by byte: the match may overlap the bytes it produces
+            for (size_t k = 0; k < length; ++k, ++pos) out[pos] = out[pos - offset];
+        }
+        if (pos != size) fail();
+    }
+
+private:
+    static constexpr size_t MIN_MATCH = 4;
+    static constexpr size_t MAX_OFFSET = 65535;
+    static constexpr unsigned HASH_BITS = 12;
+
+    static uint32_t load32(const char* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static void put_length(std::string& out, size_t length) {
+        for (; length >= 255; length -= 255) out.push_back(static_cast<char>(255));
+        out.push_back(static_cast<char>(length));
+    }
+
+    // A match length of zero ends the block with literals only
+    static void put_sequence(std::string& out, const char* literals, size_t literal_count, size_t offset,
+                             size_t length) {
+        size_t extra = length ? length - MIN_MATCH : 0;
+        out.push_back(static_cast<char>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(extra, 15)));
+        if (literal_count >= 15) put_length(out, literal_count - 15);
+        out.append(literals, literal_count);
+        if (!length) return;
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (extra >= 15) put_length(out, extra - 15);
+    }
+};
+
+// 128-bit name of a chunk's contents. It is not cryptographic: two independent
+// 64-bit lanes keep accidental collisions far out of reach, and every chunk is
+// checked against its digest again when it is restored.
+struct ChunkDigest {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const ChunkDigest& other) const { return low == other.low && high == other.high; }
+
+    struct Hash {
+        size_t operator()(const ChunkDigest& digest) const { return static_cast<size_t>(digest.low); }
+    };
+
+    static ChunkDigest of(std::string_view data) {
+        uint64_t a = 0x9E3779B97F4A7C15ULL ^ data.size();
+        uint64_t b = 0xC2B2AE3D27D4EB4FULL + data.size();
+        auto mix = [&](uint64_t word) {
+            a = rotate(a ^ (word * 0x87C37B91114253D5ULL), 31) * 0x4CF5AD432745937FULL;
+            b = rotate(b + word, 27) * 0x52DCE729ULL + 0x38495AB5ULL;
+        };
+        size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data.data() + i, sizeof(word));
+            mix(word);
+        }
+        if (i < data.size()) {
+            uint64_t word = 0;
+            std::memcpy(&word, data.data() + i, data.size() - i);
+            mix(word);
+        }
+        return {finalize(a ^ rotate(b, 17)), finalize(b + a)};
+    }
+
+private:
+    static uint64_t rotate(uint64_t x, unsigned bits) { return (x << bits) | (x >> (64 - bits)); }
+
+    static uint64_t finalize(uint64_t h) {
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+};
+
+// Append-only file of compressed chunks named by digest, shared by every backup
+// archive in one directory. A chunk is stored once and never rewritten, so a
+// backup writes only what no earlier backup stored. After the header each frame
+// is a fixed header (lengths, digest, codec, body checksum, header checksum)
+// and the stored bytes. Opening reads only the frame headers to rebuild the
+// digest index; a crash can tear only the last frame, so only its body is
+// checked and a torn tail is cut off. Any other chunk is read back and checked
+// the first time a backup reuses it, and stored again if it is corrupt; the
+// later frame for a digest wins. Not thread-safe; DataManager serializes
+// access.
+class ChunkStore {
+public:
+    struct Location {
+        uint64_t offset = 0;  // Of the frame header
+        uint32_t stored = 0;
+        uint32_t raw = 0;
+    };
+
+    explicit ChunkStore(std::string file) : path(std::move(file)) {}
+
+    const std::string& file() const { return path; }
+    size_t chunk_count() const { return index.size(); }
+    uint64_t size_bytes() const { return bytes; }
+
+    // False once the file has been changed by anyone else since open()
+    bool current() const {
+        std::error_code error;
+        return std::filesystem::file_size(path, error) == bytes && !error;
+    }
+
+    void open() {
+        index.clear();
+        reader.close();
+        bytes = 0;
+        {
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (in.is_open() && in.tellg() > 0) scan(in, static_cast<uint64_t>(in.tellg()));
+        }
+        if (bytes == 0) {
+            std::ofstream created(path, std::ios::binary | std::ios::trunc);
+            created.write(HEADER, sizeof(HEADER));
+            if (!created) throw EmployeeException("Failed to create chunk store: " + path);
+            bytes = sizeof(HEADER);
+        }
+        out.open(path, std::ios::binary | std::ios::app);
+        if (!out.is_open()) throw EmployeeException("Failed to open chunk store: " + path);
+    }
+
+    // Where the chunk with this digest lives, storing it first if it is new; the
+    // flag says whether it was written
+    std::pair<Location, bool> put(const ChunkDigest& digest, std::string_view raw) {
+        auto found = index.find(digest);
+        if (found != index.end()) {
+            if (found->second.verified || intact(found->second.location, digest)) {
+                found->second.verified = true;
+                return {found->second.location, false};
+            }
+            Logger::log(Logger::WARNING, "Corrupt chunk at offset ", std::to_string(found->second.location.offset),
+                        " of ", path, "; storing it again");
+            index.erase(found);
+        }
+
+        compressed.clear();
+        BlockCodec::compress(raw, compressed);
+        Codec codec = Codec::LZ;
+        std::string_view body = compressed;
+        if (compressed.size() >= raw.size()) {
+            codec = Codec::STORED;
+            body = raw;
+        }
+
+        Frame frame{static_cast<uint32_t>(body.size()), static_cast<uint32_t>(raw.size()), digest, codec,
+                    checksum(body)};
+        std::string header = frame.encode();
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+        if (!out) throw EmployeeException("Failed to append to chunk store: " + path);
+
+        Location location{bytes, frame.stored, frame.raw};
+        bytes += header.size() + body.size();
+        index.emplace(digest, Entry{location, true});
+        return {location, true};
+    }
+
+    void flush() {
+        out.flush();
+        if (!out) throw EmployeeException("Failed to write chunk store: " + path);
+    }
+
+    // Reads the chunk at location from an open store file into raw and checks it
+    // against digest; scratch holds the stored bytes
+    static void read(std::istream& in, const Location& location, const ChunkDigest& digest, std::string& scratch,
+                     std::string& raw) {
+        char header[Frame::SIZE];
+        in.seekg(static_cast<std::streamoff>(location.offset));
+        in.read(header, sizeof(header));
+        std::optional<Frame> frame = in ? Frame::decode(header) : std::nullopt;
+        if (!frame || !(frame->digest == digest) || frame->stored != location.stored || frame->raw != location.raw) {
+            throw EmployeeException("Backup chunk is missing from the chunk store");
+        }
+
+        scratch.resize(frame->stored);
+        in.read(scratch.data(), static_cast<std::streamsize>(scratch.size()));
+        if (!in || checksum(scratch) != frame->body_checksum) throw EmployeeException("Corrupt backup chunk");
+        if (frame->codec == Codec::STORED) {
+            raw.swap(scratch);
+        } else {
+            raw.resize(frame->raw);
+            BlockCodec::decompress(scratch, raw.data(), raw.size());
+        }
+        if (!(ChunkDigest::of(raw) == digest)) throw EmployeeException("Corrupt backup chunk");
+    }
+
+private:
+    static constexpr char HEADER[8] = {'E', 'M', 'P', 'K', 1, 0, 0, 0};
+
+    enum class Codec : uint8_t { STORED = 0, LZ = 1 };
+
+    struct Frame {
+        static constexpr size_t SIZE = 4 + 4 + 8 + 8 + 1 + 4 + 4;
+
+        uint32_t stored;
+        uint32_t raw;
+        ChunkDigest digest;
+        Codec codec;
+        uint32_t body_checksum;
+
+        std::string encode() const {
+            std::string header;
+            header.reserve(SIZE);
+            auto put = [&](auto value) { header.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+            put(stored);
+            put(raw);
+            put(digest.low);
+            put(digest.high);
+            put(static_cast<uint8_t>(codec));
+            put(body_checksum);
+            put(checksum(header));
+            return header;
+        }
+
+        static std::optional<Frame> decode(const char* header) {
+            size_t at = 0;
+            auto get = [&](auto& value) {
+                std::memcpy(&value, header + at, sizeof(value));
+                at += sizeof(value);
+            };
+            Frame frame;
+            uint8_t codec;
+            uint32_t header_checksum;
+            get(frame.stored);
+            get(frame.raw);
+            get(frame.digest.low);
+            get(frame.digest.high);
+            get(codec);
+            get(frame.body_checksum);
+            get(header_checksum);
+            if (header_checksum != checksum(std::string_view(header, SIZE - 4)) || codec > 1) return std::nullopt;
+            frame.codec = static_cast<Codec>(codec);
+            return frame;
+        }
+    };
+
+    struct Entry {
+        Location location;
+        bool verified;  // Written or read back intact since open()
+    };
+
+    std::string path;
+    std::ofstream out;
+    std::ifstream reader;  // Opened by the first check of an older chunk
+    uint64_t bytes = 0;
+    std::unordered_map<ChunkDigest, Entry, ChunkDigest::Hash> index;
+    std::string compressed;  // Reused between puts
+    std::string checked_body;
+    std::string checked_raw;
+
+    // Whether the chunk at location, stored before open(), still reads back as digest
+    bool intact(const Location& location, const ChunkDigest& digest) {
+        if (!reader.is_open()) reader.open(path, std::ios::binary);
+        reader.clear();
+        try {
+            read(reader, location, digest, checked_body, checked_raw);
+            return true;
+        } catch (const EmployeeException&) {
+            return false;
+        }
+    }
+
+    static uint32_t checksum(std::string_view data) {
+        uint64_t hash = static_cast<uint64_t>(fnv1a_hash(data));
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    void scan(std::ifstream& in, uint64_t size) {
+        char header[Frame::SIZE];
+        in.seekg(0);
+        in.read(header, sizeof(HEADER));
+        if (!in || std::memcmp(header, HEADER, sizeof(HEADER)) != 0) {
+            throw EmployeeException("Unrecognized chunk store: " + path);
+        }
+
+        uint64_t offset = sizeof(HEADER);
+        uint64_t last = 0;
+        std::optional<Frame> last_frame;
+        while (offset + Frame::SIZE <= size) {
+            in.seekg(static_cast<std::streamoff>(offset));
+            in.read(header, sizeof(header));
+            std::optional<Frame> frame = in ? Frame::decode(header) : std::nullopt;
+            if (!frame || offset + Frame::SIZE + frame->stored > size) break;
+            index[frame->digest] = Entry{Location{offset, frame->stored, frame->raw}, false};
+            last = offset;
+            last_frame = frame;
+            offset += Frame::SIZE + frame->stored;
+        }
+
+        if (last_frame) {
+            std::string body(last_frame->stored, '\0');
+            in.seekg(static_cast<std::streamoff>(last + Frame::SIZE));
+            in.read(body.data(), static_cast<std::streamsize>(body.size()));
+            if (!in || checksum(body) != last_frame->body_checksum) {
+                index.erase(last_frame->digest);
+                offset = last;
+            } else {
+                index[last_frame->digest].verified = true;
+            }
+        }
+        in.close();
+        if (offset < size) {
+            Logger::log(Logger::WARNING, "Discarding ", std::to_string(size - offset),
+                        " bytes of incomplete chunks from ", path);
+            std::filesystem::resize_file(path, offset);
+        }
+        bytes = offset;
+    }
+};
+
+// A backup is a small archive file naming the chunks that hold its records, in
+// order, plus the chunk store in the same directory that holds the chunks. The
+// records are sorted by ID and cut into chunks after a record whose ID hashes
+// onto a boundary, so boundaries move only with the records that define them:
+// a changed record rewrites its own chunk and nothing else, and a backup after
+// a few changes stores a few new chunks. Each chunk is its records in
+// BinaryFormat, which keeps every field intact; version 1 archives held
+// Employee::serialize() lines and still restore. Restore streams the chunks
+// back one at a time.
+//
+// Archive layout: header, store file name, record count, raw byte count,
+// chunk count, then offset, stored and raw length and digest per chunk, and a
+// checksum of everything before it.
+class BackupArchive {
+public:
+    static constexpr const char* STORE_NAME = "backups.pack";
+
+    struct Stats {
+        size_t records = 0;
+        size_t chunks = 0;
+        size_t new_chunks = 0;
+        uint64_t raw_bytes = 0;     // Serialized records
+        uint64_t stored_bytes = 0;  // Written to the chunk store by this backup
+        uint64_t archive_bytes = 0;
+    };
+
+    static bool is_archive(const std::string& path) {
+        char header[sizeof(HEADER)];
+        std::ifstream in(path, std::ios::binary);
+        return in.read(header, sizeof(header)) && has_header(header);
+    }
+
+    // The chunk store that archive is kept in
+    static std::string store_path(const std::string& archive) {
+        size_t slash = archive.find_last_of("/\\");
+        return slash == std::string::npos ? STORE_NAME : archive.substr(0, slash + 1) + STORE_NAME;
+    }
+
+    // Chunks and stores employees, then writes the archive beside store through
+    // a temporary file, so a failed backup leaves no archive behind
+    static Stats write(const EmployeeHashTable::View& employees, const std::string& archive, ChunkStore& store) {
+        std::vector<const Employee*> records;
+        records.reserve(employees.size());
+        for (const auto& emp : employees) records.push_back(&emp);
+        std::sort(records.begin(), records.end(),
+                  [](const Employee* a, const Employee* b) { return a->id.view() < b->id.view(); });
+
+        Stats stats;
+        stats.records = records.size();
+        std::string entries;
+        std::vector<std::reference_wrapper<const Employee>> members;
+        size_t member_bytes = 0;
+        std::ostringstream encoded;
+        std::string chunk;
+        uint64_t stored_before = store.size_bytes();
+        auto cut = [&] {
+            if (members.empty()) return;
+            encoded.str("");
+            BinaryFormat::write(encoded, members);
+            chunk = encoded.str();
+            members.clear();
+            member_bytes = 0;
+            ChunkDigest digest = ChunkDigest::of(chunk);
+            auto [location, written] = store.put(digest, chunk);
+            put(entries, location.offset);
+            put(entries, location.stored);
+            put(entries, location.raw);
+            put(entries, digest.low);
+            put(entries, digest.high);
+            ++stats.chunks;
+            stats.new_chunks += written;
+            stats.raw_bytes += chunk.size();
+        };
+        for (const Employee* emp : records) {
+            members.push_back(*emp);
+            member_bytes += encoded_bytes(*emp);
+            if ((member_bytes >= MIN_CHUNK_BYTES && is_boundary(emp->id.view())) || member_bytes >= MAX_CHUNK_BYTES) {
+                cut();
+            }
+        }
+        cut();
+        store.flush();
+        stats.stored_bytes = store.size_bytes() - stored_before;
+
+        std::string name = store.file().substr(store.file().find_last_of("/\\") + 1);
+        std::string contents(HEADER, sizeof(HEADER));
+        put(contents, static_cast<uint32_t>(name.size()));
+        contents += name;
+        put(contents, static_cast<uint64_t>(stats.records));
+        put(contents, stats.raw_bytes);
+        put(contents, static_cast<uint32_t>(stats.chunks));
+        contents += entries;
+        put(contents, checksum(contents));
+
+        std::string temp_file = archive + ".tmp";
+        {
+            std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            file.flush();
+            if (!file) throw EmployeeException("Failed to write " + temp_file);
+        }
+        if (std::rename(temp_file.c_str(), archive.c_str()) != 0) {
+            std::remove(temp_file.c_str());
+            throw EmployeeException("Failed to write backup archive " + archive);
+        }
+        stats.archive_bytes = contents.size();
+        Metrics::save_bytes.add(stats.stored_bytes + stats.archive_bytes);
+        return stats;
+    }
+
+    // Calls sink(Employee&&) for every record in archive, in order, holding one
+    // decompressed chunk at a time. Records that do not decode go to on_error.
+    // Returns the record count the archive was written with.
+    template <typename Sink, typename OnError>
+    static size_t read(const std::string& archive, Sink&& sink, OnError&& on_error) {
+        MappedFile mapped(archive);
+        const char* at = mapped.data();
+        size_t left = mapped.size();
+        auto fail = [&] { throw EmployeeException("Corrupt backup archive: " + archive); };
+        if (left < sizeof(HEADER) + sizeof(uint32_t) || !has_header(at) ||
+            get<uint32_t>(at + left - sizeof(uint32_t)) != checksum(std::string_view(at, left - sizeof(uint32_t)))) {
+            fail();
+        }
+        left -= sizeof(uint32_t);
+        const bool text_lines = at[4] == 1;
+        auto take = [&](size_t count) {
+            if (count > left) fail();
+            const char* taken = at;
+            at += count;
+            left -= count;
+            return taken;
+        };
+        take(sizeof(HEADER));
+        uint32_t name_length = get<uint32_t>(take(sizeof(uint32_t)));
+        std::string name(take(name_length), name_length);
+        uint64_t records = get<uint64_t>(take(sizeof(uint64_t)));
+        take(sizeof(uint64_t));  // Raw bytes
+        uint32_t chunks = get<uint32_t>(take(sizeof(uint32_t)));
+        if (left != static_cast<size_t>(chunks) * ENTRY_BYTES) fail();
+
+        size_t slash = archive.find_last_of("/\\");
+        std::string store = slash == std::string::npos ? name : archive.substr(0, slash + 1) + name;
+        std::ifstream in(store, std::ios::binary);
+        if (!in.is_open()) throw EmployeeException("Chunk store not found: " + store);
+
+        std::string scratch;
+        std::string raw;
+        for (uint32_t i = 0; i < chunks; ++i) {
+            const char* entry = take(ENTRY_BYTES);
+            ChunkStore::Location location{get<uint64_t>(entry), get<uint32_t>(entry + 8), get<uint32_t>(entry + 12)};
+            ChunkDigest digest{get<uint64_t>(entry + 16), get<uint64_t>(entry + 24)};
+            ChunkStore::read(in, location, digest, scratch, raw);
+            Metrics::load_bytes.add(location.stored);
+
+            if (!text_lines) {
+                BinaryFormat::read(raw.data(), raw.size(), sink, on_error);
+                continue;
+            }
+            std::string_view rest = raw;
+            while (!rest.empty()) {
+                size_t eol = rest.find('\n');
+                std::string_view line = rest.substr(0, eol);
+                if (!line.empty()) {
+                    try {
+                        sink(Employee::deserialize(line));
+                    } catch (const EmployeeException& e) {
+                        on_error(e);
+                    }
+                }
+                if (eol == std::string_view::npos) break;
+                rest.remove_prefix(eol + 1);
+            }
+        }
+        return static_cast<size_t>(records);
+    }
+
+private:
+    // Byte 4 is the version: 1 for text lines, 2 for BinaryFormat chunks
+    static constexpr char HEADER[8] = {'E', 'M', 'P', 'A', 2, 0, 0, 0};
+
+    static bool has_header(const char* header) {
+        return std::memcmp(header, HEADER, 4) == 0 && (header[4] == 1 || header[4] == 2) &&
+               std::memcmp(header + 5, HEADER + 5, 3) == 0;
+    }
+
+    // What a record adds to a BinaryFormat chunk, before string deduplication
+    static size_t encoded_bytes(const Employee& emp) {
+        size_t bytes = sizeof(double) + sizeof(int64_t) + 7 * 8 + sizeof(uint32_t) + 3 + emp.id.view().size() +
+                       emp.firstName.size() + emp.lastName.size() + emp.position.size() + emp.email.size() +
+                       emp.phone.size() + emp.managerId.view().size();
+        for (const auto& skill : emp.skills) bytes += 8 + skill.size();
+        return bytes;
+    }
+    static constexpr size_t ENTRY_BYTES = 8 + 4 + 4 + 8 + 8;
+
+    // Chunks average about 4 KiB of records: small enough that scattered updates
+    // rewrite little, large enough to compress and keep the archive short
+    static constexpr size_t MIN_CHUNK_BYTES = 1024;
+    static constexpr size_t MAX_CHUNK_BYTES = 64 * 1024;
+    static constexpr unsigned BOUNDARY_BITS = 4;  // One record in 16 past the minimum ends a chunk
+
+    static bool is_boundary(std::string_view id) {
+        uint64_t h = static_cast<uint64_t>(fnv1a_hash(id)) * 0x9E3779B97F4A7C15ULL;
+        return (h >> (64 - BOUNDARY_BITS)) == 0;
+    }
+
+    template <typename T>
+    static void put(std::string& buffer, T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static T get(const char* at) {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        return value;
+    }
+
+    static uint32_t checksum(std::string_view data) {
+        uint64_t hash = static_cast<uint64_t>(fnv1a_hash(data));
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+};
+
+// ==================== LAZY LOADING ====================
+
+// Most recently used records up to a byte budget, each costed as in
+// MemoryUsage: sizeof(Employee) plus the heap bytes it owns. Thread-safe.
+class RecordCache {
+public:
+    explicit RecordCache(size_t capacity_bytes) : capacity(capacity_bytes) {}
+
+    std::shared_ptr<const Employee> get(std::string_view id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(id);
+        if (it == entries.end()) return nullptr;
+        order.splice(order.begin(), order, it->second);
+        return it->second->record;
+    }
+
+    // A record larger than the whole budget is not kept
+    void put(std::string_view id, std::shared_ptr<const Employee> record) {
+        const size_t bytes = sizeof(Employee) + record->heap_bytes();
+        if (bytes > capacity) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(id);
+        if (it != entries.end()) {
+            used -= it->second->bytes;
+            order.erase(it->second);
+            entries.erase(it);
+        }
+        order.push_front({std::string(id), std::move(record), bytes});
+        entries.emplace(order.front().id, order.begin());
+        used += bytes;
+        while (used > capacity) {
+            used -= order.back().bytes;
+            entries.erase(order.back().id);
+            order.pop_back();
+        }
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return order.size();
+    }
+
+    size_t size_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return used;
+    }
+
+private:
+    struct Entry {
+        std::string id;
+        std::shared_ptr<const Employee> record;
+        size_t bytes;
+    };
+
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::list<Entry> order;  // Most recent first
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> entries;  // Keys view Entry::id
+    size_t used = 0;
+};
+
+// Answers ID lookups from a binary data file without loading it. The record
+// index finds the candidates for an ID, which are decoded and validated on
+// first access and then kept in a RecordCache. Logged changes are newer than
+// the data file, so they are read up front and answer first.
+class LazyDataFile {
+private:
+    MappedFile mapped;
+    BinaryFormat::Layout layout;
+    std::string index_path;
+    std::shared_ptr<const RecordIndex> index;  // Replaced if a probe finds it corrupt
+    mutable std::mutex index_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const Employee>> logged;  // Null once removed
+    RecordCache cache;
+
+    // Builds the index from the ID column and writes it to index_path
+    void rebuild_index() {
+        auto rebuilt = std::make_shared<const RecordIndex>(RecordIndex::build(stamp(), [this](uint64_t i) {
+            try {
+                return BinaryFormat::id_of(layout, mapped.data(), i);
+            } catch (const EmployeeException&) {
+                return std::string_view();  // The record fails to decode anyway
+            }
+        }));
+        // Untagged files predate generations and could never be matched again
+        if (layout.generation != 0) {
+            try {
+                rebuilt->save(index_path);
+            } catch (const EmployeeException& e) {
+                Logger::log(Logger::WARNING, "Could not write record index: ", e.what());
+            }
+        }
+        std::lock_guard<std::mutex> lock(index_mutex);
+        index = std::move(rebuilt);
+    }
+
+    std::shared_ptr<const RecordIndex> current_index() const {
+        std::lock_guard<std::mutex> lock(index_mutex);
+        return index;
+    }
+
+public:
+    // Throws when data_file is not a well-formed binary data file
+    LazyDataFile(const std::string& data_file, size_t cache_bytes)
+        : mapped(data_file, MappedFile::RANDOM), cache(cache_bytes) {
+        if (!BinaryFormat::is_binary(mapped.data(), mapped.size())) {
+            throw EmployeeException("Lazy loading needs a binary data file: " + data_file);
+        }
+        layout = BinaryFormat::layout(mapped.data(), mapped.size());
+    }
+
+    LazyDataFile(const LazyDataFile&) = delete;
+    LazyDataFile& operator=(const LazyDataFile&) = delete;
+
+    RecordIndex::Stamp stamp() const { return {layout.generation, layout.records, mapped.size()}; }
+
+    // Maps the index at path, or rebuilds it from the ID column when it is
+    // missing or stale and writes it back for the next open. Returns whether
+    // the persisted index was used.
+    bool open_index(const std::string& path) {
+        index_path = path;
+        if (auto opened = RecordIndex::open(path, stamp())) {
+            index = std::make_shared<const RecordIndex>(std::move(*opened));
+            return true;
+        }
+        rebuild_index();
+        return false;
+    }
+
+    // Folds one logged change in, as DataManager's replay would apply it
+    void redo(WriteAheadLog::Entry& entry) {
+        if (entry.op == WriteAheadLog::Op::REMOVE) {
+            logged[entry.id] = nullptr;
+            return;
+        }
+        try {
+            entry.record.validate();
+        } catch (const EmployeeException&) {
+            return;  // Replay skips it too
+        }
+        logged[entry.id] = std::make_shared<const Employee>(std::move(entry.record));
+    }
+
+    // The logged version of id, null if it was removed; nothing when the log
+    // does not mention it
+    std::optional<std::shared_ptr<const Employee>> logged_version(const std::string& id) const {
+        auto it = logged.find(id);
+        if (it == logged.end()) return std::nullopt;
+        return it->second;
+    }
+
+    // The data file's record for id, or null. Of several records with the ID,
+    // the first valid one is the one a load keeps.
+    std::shared_ptr<const Employee> find(const std::string& id) {
+        if (auto cached = cache.get(id)) {
+            Metrics::lazy_cache_hits.add();
+            return cached;
+        }
+        std::shared_ptr<const Employee> found;
+        auto visit = [&](uint64_t record) {
+            try {
+                if (BinaryFormat::id_of(layout, mapped.data(), record) != id) return false;
+                Employee emp = BinaryFormat::decode(layout, mapped.data(), record);
+                emp.validate();
+                found = std::make_shared<const Employee>(std::move(emp));
+                return true;
+            } catch (const EmployeeException&) {
+                return false;
+            }
+        };
+        if (!current_index()->probe(id, visit)) {
+            Logger::log(Logger::WARNING, "Record index ", index_path, " has no free slot left; rebuilding it");
+            rebuild_index();
+            current_index()->probe(id, visit);
+        }
+        if (found) {
+            Metrics::lazy_record_faults.add();
+            cache.put(id, found);
+        }
+        return found;
+    }
+
+    size_t records() const { return static_cast<size_t>(layout.records); }
+    const RecordCache& cached() const { return cache; }
+};
+
+// ==================== DATA PERSISTENCE LAYER ====================
+
+enum class DataFormat {
+    TEXT,    // Pipe-delimited Employee::serialize() lines
+    BINARY   // BinaryFormat columns
+};
+
+class DataManager : public MutationJournal {
+private:
+    std::string data_file;
+    std::string backup_file;
+    DataFormat format;
+    mutable std::mutex file_mutex;
+
+    // Set by open(): mutations of the attached table are appended to the log and
+    // periodically folded into the data file by a checkpoint
+    EmployeeHashTable* attached = nullptr;
+    std::unique_ptr<WriteAheadLog> wal;
+    uint64_t checkpoint_bytes = 0;
+    bool sealed_pending = false;  // A sealed log awaits its checkpoint
+    bool append_failed = false;   // A logged change is only in the table until the next checkpoint
+
+    // The table a failed open() left holding only part of the data, if any. It
+    // is never saved, so a read error cannot overwrite the files it failed on.
+    std::atomic<const EmployeeHashTable*> unloaded{nullptr};
+
+    // Serializes whole-file rewrites. It is held while a snapshot is encoded, and
+    // file_mutex only for the moments that touch the log or swap files.
+    std::mutex rewrite_mutex;
+
+    // Checkpoints and autosaves run on this thread so no writer waits for a full
+    // rewrite; it is started by open()
+    std::thread saver;
+    std::mutex saver_mutex;
+    std::condition_variable saver_wake;
+    bool saver_stopping = false;
+    bool checkpoint_requested = false;
+    bool autosave_changed = false;
+    std::chrono::seconds autosave_interval{0};
+
+    // Serializes backups. The chunk store last backed up to stays open, so its
+    // index is read once per session rather than once per backup.
+    std::mutex backup_mutex;
+    std::unique_ptr<ChunkStore> backup_store;
+
+    // Set by open_lazy() until its hydrator thread has run open() on the table;
+    // meanwhile lookup() is served from the data file
+    std::shared_ptr<LazyDataFile> lazy;
+    std::thread hydrator;
+    mutable std::mutex hydration_mutex;
+    mutable std::condition_variable hydration_done;
+
+    // The text header is only a hint; a corrupt count must not trigger a huge
+    // up-front allocation
+    static constexpr size_t MAX_TRUSTED_COUNT = size_t(1) << 24;
+
+    // Below this a text file parses faster on one thread than it takes to start more
+    static constexpr size_t MIN_TEXT_BYTES_PER_WORKER = size_t(1) << 20;
+
+    // A checkpoint is due once the log outgrows both this and half the data file,
+    // so rewrite cost stays proportional to the changes made
+    static constexpr uint64_t CHECKPOINT_MIN_BYTES = uint64_t(4) << 20;
+
+    std::string wal_file() const { return data_file + ".wal"; }
+    std::string sealed_wal_file() const { return data_file + ".wal.sealed"; }
+    std::string index_file() const { return data_file + ".idx"; }
+
+    // Tags each binary write, so a record index can tell which one it describes
+    static uint32_t new_generation() {
+        thread_local std::mt19937 generator{std::random_device{}()};
+        uint32_t generation;
+        do {
+            generation = static_cast<uint32_t>(generator());
+        } while (generation == 0);
+        return generation;
+    }
+
+    // Everything read from disk for one load. Decoding happens under file_mutex;
+    // applying it to a table happens after release, because table writers take
+    // their own locks before calling back into record_*().
+    struct LoadedData {
+        std::vector<Employee> employees;
+        std::vector<WriteAheadLog::Entry> changes;
+        bool binary = false;
+    };
+
+    void read_binary(const MappedFile& mapped, LoadedData& loaded) {
+        loaded.binary = true;
+        loaded.employees.reserve(BinaryFormat::record_count(mapped.data(), mapped.size()));
+        BinaryFormat::read(mapped.data(), mapped.size(),
+            [&](Employee&& emp) { loaded.employees.push_back(std::move(emp)); },
+            [](const EmployeeException& e) {
+                Logger::log(Logger::WARNING, "Failed to load employee record: " +
+                           std::string(e.what()));
+            });
+    }
+
+    // Parses the mapped file in place. Each worker owns the lines that start
+    // inside its byte range; records and rejected lines are merged in file order.
+    void read_text(const MappedFile& mapped, LoadedData& loaded) {
+        if (mapped.size() == 0) return;
+        const char* end = mapped.data() + mapped.size();
+        const char* body = static_cast<const char*>(std::memchr(mapped.data(), '\n', mapped.size()));
+        if (!body) return;
+        size_t count = 0;
+        std::from_chars(mapped.data(), body, count);  // Header hint; missing or bad reads as 0
+        ++body;
+
+        const size_t length = static_cast<size_t>(end - body);
+        const size_t workers = ParallelRange::workers_for(length, MIN_TEXT_BYTES_PER_WORKER);
+        std::vector<std::vector<Employee>> parsed(workers);
+        std::vector<std::vector<std::string>> failed(workers);
+
+        ParallelRange::run(length, workers, [&](size_t worker, size_t begin, size_t stop) {
+            const char* p = body + begin;
+            if (begin > 0 && p[-1] != '\n') {
+                p = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                p = p ? p + 1 : end;
+            }
+
+            auto& records = parsed[worker];
+            records.reserve(std::min(count, MAX_TRUSTED_COUNT) / workers + 1);
+            while (p < body + stop) {
+                const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+                if (!eol) eol = end;
+                std::string_view line(p, static_cast<size_t>(eol - p));
+                p = eol == end ? end : eol + 1;
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (line.empty()) continue;
+                try {
+                    records.push_back(Employee::deserialize(line));
+                } catch (const EmployeeException& e) {
+                    failed[worker].push_back(e.what());
+                }
+            }
+        });
+
+        size_t total = 0;
+        for (const auto& records : parsed) total += records.size();
+        loaded.employees.reserve(total);
+        for (size_t worker = 0; worker < workers; ++worker) {
+            std::move(parsed[worker].begin(), parsed[worker].end(), std::back_inserter(loaded.employees));
+            for (const auto& message : failed[worker]) {
+                Logger::log(Logger::WARNING, "Failed to load employee record: " + message);
+            }
+        }
+    }
+
+    void read_locked(LoadedData& loaded) {
+        std::ifstream file(data_file);
+        if (!file.is_open()) {
+            Logger::log(Logger::INFO, "Data file not found, starting with empty database");
+        } else {
+            MappedFile mapped(data_file);
+            checkpoint_bytes = mapped.size();
+            Metrics::load_bytes.add(mapped.size());
+            if (BinaryFormat::is_binary(mapped.data(), mapped.size())) {
+                read_binary(mapped, loaded);
+            } else {
+                read_text(mapped, loaded);
+            }
+        }
+
+        // A sealed log is older than the live one, so it is redone first
+        for (const auto& log : {sealed_wal_file(), wal_file()}) {
+            WriteAheadLog::replay(log, [&](WriteAheadLog::Entry& entry) {
+                loaded.changes.push_back(std::move(entry));
+            });
+        }
+    }
+
+    // Bulk-loads the data file, then redoes every logged change on top of it
+    void apply(EmployeeHashTable& table, LoadedData& loaded) {
+        size_t count = table.bulk_insert(std::move(loaded.employees)).inserted;
+        Logger::log(Logger::INFO, "Loaded " + std::to_string(count) +
+                   " employees from " + data_file + (loaded.binary ? " (binary)" : ""));
+
+        for (const auto& entry : loaded.changes) {
+            try {
+                if (entry.op == WriteAheadLog::Op::REMOVE) {
+                    table.remove(entry.id);
+                } else if (table.find(entry.id)) {
+                    table.update(entry.id, entry.record);
+                } else {
+                    table.insert(entry.record);
+                }
+            } catch (const EmployeeException& e) {
+                Logger::log(Logger::WARNING, "Skipped write-ahead log entry for ", entry.id, ": ", e.what());
+            }
+        }
+        if (!loaded.changes.empty()) {
+            Logger::log(Logger::INFO, "Recovered ", std::to_string(loaded.changes.size()),
+                        " changes from write-ahead log ", wal_file());
+        }
+    }
+
+    // Moves a freshly written file into place. The previous data file becomes the
+    // backup by hard link where possible, so it is never copied.
+    void replace_data_file(const std::string& temp_file) {
+#ifdef _WIN32
+        std::remove(backup_file.c_str());
+        std::rename(data_file.c_str(), backup_file.c_str());
+#else
+        ::unlink(backup_file.c_str());
+        if (::link(data_file.c_str(), backup_file.c_str()) != 0 && errno != ENOENT) {
+            std::ifstream src(data_file, std::ios::binary);
+            std::ofstream dst(backup_file, std::ios::binary);
+            dst << src.rdbuf();
+        }
+#endif
+        if (std::rename(temp_file.c_str(), data_file.c_str()) != 0) {
+            throw EmployeeException("Failed to replace " + data_file);
+        }
+    }
+
+    // Encodes employees into a temporary file beside the data file and returns
+    // the bytes written. Needs no lock: the view is immutable and only the holder
+    // of rewrite_mutex writes the temporary file.
+    uint64_t write_temp(const EmployeeHashTable::View& employees, const std::string& temp_file,
+                        uint32_t generation) const {
+        Metrics::Timer timer(Metrics::save_latency);
+        std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw EmployeeException("Failed to open file for writing: " + temp_file);
+        }
+
+        if (format == DataFormat::BINARY) {
+            BinaryFormat::write(file, employees, generation);
+        } else {
+            file << employees.size() << "\n";
+
+            std::string line;
+            for (const auto& emp : employees) {
+                line.clear();
+                emp.serialize_to(line);
+                line.push_back('\n');
+                file << line;
+            }
+        }
+
+        file.flush();
+        if (!file) throw EmployeeException("Failed to write " + temp_file);
+        uint64_t written = static_cast<uint64_t>(file.tellp());
+        file.close();
+        Metrics::save_bytes.add(written);
+        return written;
+    }
+
+    // Runs after the data file it describes is in place. Until it lands the old
+    // index is stale, which a lazy open detects, so a failure costs a rebuild.
+    void write_index(const EmployeeHashTable::View& employees, const RecordIndex::Stamp& stamp) const {
+        try {
+            std::vector<std::string_view> ids;
+            ids.reserve(employees.size());
+            for (const Employee& emp : employees) ids.push_back(emp.id.view());
+            RecordIndex::build(stamp, [&](uint64_t i) { return ids[i]; }).save(index_file());
+        } catch (const EmployeeException& e) {
+            Logger::log(Logger::WARNING, "Could not write record index: ", e.what());
+        }
+    }
+
+    // Writes the whole table to a temporary file and swaps it in, so a crash mid
+    // save leaves the previous data file intact. Returns the record count.
+    //
+    // For the attached table this is a checkpoint. The log is sealed before the
+    // view is taken, and writers log a change only after applying it, so every
+    // sealed entry is already in the view; the sealed log is dropped once the new
+    // data file is in place. Changes logged after the seal may be in the view as
+    // well, which recovery redoes harmlessly. Writers only wait for the seal and
+    // the swap, never for the encoding.
+    size_t write_table(const EmployeeHashTable& table) {
+        std::lock_guard<std::mutex> rewrite(rewrite_mutex);
+        std::string temp_file = data_file + ".tmp";
+        bool checkpoint = &table == attached;
+        if (checkpoint) {
+            Metrics::Timer pause(Metrics::checkpoint_pause);
+            std::lock_guard<std::mutex> lock(file_mutex);
+            wal->seal(sealed_wal_file());
+            sealed_pending = true;
+            append_failed = false;
+        }
+
+        auto employees = table.view();
+        const uint32_t generation = new_generation();
+        uint64_t written = write_temp(employees, temp_file, generation);
+
+        {
+            Metrics::Timer pause(Metrics::checkpoint_pause);
+            std::lock_guard<std::mutex> lock(file_mutex);
+            replace_data_file(temp_file);
+            if (checkpoint) {
+                std::remove(sealed_wal_file().c_str());
+                sealed_pending = false;
+                checkpoint_bytes = written;
+            }
+        }
+        if (format == DataFormat::BINARY) write_index(employees, {generation, employees.size(), written});
+        return employees.size();
+    }
+
+    size_t checkpoint() {
+        size_t count = write_table(*attached);
+        Logger::log(Logger::INFO, "Checkpointed ", std::to_string(count), " employees to ", data_file);
+        return count;
+    }
+
+    bool checkpoint_due() const {
+        return append_failed || wal->size_bytes() > std::max(CHECKPOINT_MIN_BYTES, checkpoint_bytes / 2);
+    }
+
+    // Runs one append: once the log is due the saver is woken, and the writer
+    // returns straight away. The change is already in the table, so if the log
+    // cannot take it a checkpoint is forced to make it durable instead.
+    template <typename Append>
+    void append_locked(Append&& append) {
+        try {
+            append();
+        } catch (const EmployeeException& e) {
+            Logger::log(Logger::ERROR, e.what(), "; forcing a checkpoint");
+            append_failed = true;
+            request_checkpoint();
+            return;
+        }
+        if (checkpoint_due()) request_checkpoint();
+    }
+
+    void request_checkpoint() {
+        std::lock_guard<std::mutex> lock(saver_mutex);
+        if (checkpoint_requested) return;
+        checkpoint_requested = true;
+        saver_wake.notify_one();
+    }
+
+    // Runs requested checkpoints, plus one every autosave_interval while there are
+    // logged changes. A failed checkpoint keeps its sealed log for the next one.
+    void saver_loop() {
+        using Clock = std::chrono::steady_clock;
+        std::unique_lock<std::mutex> lock(saver_mutex);
+        Clock::time_point last = Clock::now();
+        while (true) {
+            auto woken = [&] { return saver_stopping || checkpoint_requested || autosave_changed; };
+            bool requested = true;
+            if (autosave_interval.count() > 0) {
+                requested = saver_wake.wait_until(lock, last + autosave_interval, woken);
+            } else {
+                saver_wake.wait(lock, woken);
+            }
+            if (saver_stopping) return;
+            if (autosave_changed && !checkpoint_requested) {
+                autosave_changed = false;
+                last = Clock::now();
+                continue;
+            }
+            autosave_changed = false;
+            checkpoint_requested = false;
+            lock.unlock();
+
+            bool pending = requested;
+            if (!pending) {
+                std::lock_guard<std::mutex> files(file_mutex);
+                pending = !wal->empty() || sealed_pending;
+            }
+            if (pending) {
+                try {
+                    checkpoint();
+                } catch (const std::exception& e) {
+                    Logger::log(Logger::ERROR, "Checkpoint failed, keeping write-ahead log: ", e.what());
+                }
+            }
+
+            lock.lock();
+            last = Clock::now();
+        }
+    }
+
+    void stop_saver() {
+        if (!saver.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(saver_mutex);
+            saver_stopping = true;
+        }
+        saver_wake.notify_one();
+        saver.join();
+    }
+
+public:
+    // Files are always loaded in whichever format they were written; format only
+    // selects what save() writes, so text files migrate on their first save
+    explicit DataManager(const std::string& filename = "employees.dat",
+                         DataFormat format = DataFormat::BINARY)
+        : data_file(filename), backup_file(filename + ".bak"), format(format) {}
+
+    // A checkpoint already running is finished; the log covers anything newer
+    ~DataManager() override {
+        if (hydrator.joinable()) hydrator.join();
+        if (attached) attached->set_journal(nullptr);
+        stop_saver();
+    }
+
+    DataManager(const DataManager&) = delete;
+    DataManager& operator=(const DataManager&) = delete;
+
+    // Loads table and keeps it persisted from then on: every mutation is appended
+    // to the write-ahead log before the mutating call returns, and the data file is
+    // rewritten only at checkpoints
+    bool open(EmployeeHashTable& table) {
+        Metrics::Timer timer(Metrics::load_latency);
+        try {
+            LoadedData loaded;
+            {
+                std::lock_guard<std::mutex> lock(file_mutex);
+                read_locked(loaded);
+            }
+            apply(table, loaded);
+
+            std::lock_guard<std::mutex> lock(file_mutex);
+            wal = std::make_unique<WriteAheadLog>(wal_file());
+            wal->open();
+            sealed_pending = std::ifstream(sealed_wal_file()).is_open();
+            attached = &table;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error opening data: " + std::string(e.what()));
+            unloaded = &table;
+            return false;
+        }
+        table.set_journal(this);
+        saver = std::thread([this] { saver_loop(); });
+        if (sealed_pending) request_checkpoint();
+        return true;
+    }
+
+    // Like open(), but returns as soon as IDs can be looked up: the data file is
+    // mapped with its record index, rebuilt if stale, and the logs are read. A
+    // background thread then runs open() on table. Until it is done, lookup()
+    // faults records in from the data file, caching up to cache_bytes of them,
+    // and anything else should await_hydration() first. A data file that is
+    // missing or not binary is opened in full.
+    bool open_lazy(EmployeeHashTable& table, size_t cache_bytes) {
+        std::shared_ptr<LazyDataFile> source;
+        try {
+            std::lock_guard<std::mutex> lock(file_mutex);
+            source = std::make_shared<LazyDataFile>(data_file, cache_bytes);
+            bool persisted = source->open_index(index_file());
+            for (const auto& log : {sealed_wal_file(), wal_file()}) {
+                WriteAheadLog::replay(log, [&](WriteAheadLog::Entry& entry) { source->redo(entry); });
+            }
+            Logger::log(Logger::INFO, "Opened ", data_file, " lazily: ", std::to_string(source->records()),
+                        " records, ", persisted ? "persisted" : "rebuilt", " record index");
+        } catch (const std::exception& e) {
+            Logger::log(Logger::INFO, e.what(), "; loading in full");
+            return open(table);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(hydration_mutex);
+            lazy = std::move(source);
+        }
+        hydrator = std::thread([this, &table] {
+            open(table);
+            std::lock_guard<std::mutex> lock(hydration_mutex);
+            lazy.reset();
+            hydration_done.notify_all();
+        });
+        return true;
+    }
+
+    // Whether the table opened by open_lazy() has finished loading; always
+    // true after open()
+    bool hydrated() const {
+        std::lock_guard<std::mutex> lock(hydration_mutex);
+        return !lazy;
+    }
+
+    void await_hydration() const {
+        std::unique_lock<std::mutex> lock(hydration_mutex);
+        hydration_done.wait(lock, [this] { return !lazy; });
+    }
+
+    // table.snapshot(id) that already works while open_lazy() is loading table.
+    // Logged changes come first, then the table, which holds anything added
+    // before the open, then the data file, which is the order a load applies.
+    std::shared_ptr<const Employee> lookup(const EmployeeHashTable& table, const std::string& id) const {
+        std::shared_ptr<LazyDataFile> source;
+        {
+            std::lock_guard<std::mutex> lock(hydration_mutex);
+            source = lazy;
+        }
+        if (!source) return table.snapshot(id);
+        if (auto logged = source->logged_version(id)) return *logged;
+        if (auto stored = table.snapshot(id)) return stored;
+        return source->find(id);
+    }
+
+    // Checkpoints the attached table in the background every interval while it
+    // has unsaved changes; zero turns autosave off
+    void set_autosave(std::chrono::seconds interval) {
+        std::lock_guard<std::mutex> lock(saver_mutex);
+        autosave_interval = interval;
+        autosave_changed = true;
+        saver_wake.notify_one();
+    }
+
+    // Asks for a checkpoint of the attached table without waiting for it. With
+    // no saver running, because open() failed, table is saved in full instead.
+    // Returns false only when that save fails.
+    bool save_in_background(const EmployeeHashTable& table) {
+        await_hydration();
+        if (!saver.joinable()) return save(table);
+        request_checkpoint();
+        return true;
+    }
+
+    // Replaces table's contents in one move. A background checkpoint encodes a
+    // view of the store under rewrite_mutex, and a view does not keep the store
+    // alive, so the move waits for it. Nothing is logged; save() afterwards, which
+    // is allowed again for a table that failed to open.
+    void replace_table(EmployeeHashTable& table, EmployeeHashTable&& contents) {
+        await_hydration();
+        std::lock_guard<std::mutex> rewrite(rewrite_mutex);
+        table = std::move(contents);
+        const EmployeeHashTable* failed = &table;
+        unloaded.compare_exchange_strong(failed, nullptr);
+    }
+
+    // Full rewrite of the data file. For the attached table this is an immediate
+    // checkpoint and empties the write-ahead log; writers carry on meanwhile.
+    bool save(const EmployeeHashTable& table) {
+        await_hydration();
+        if (&table == unloaded.load()) {
+            Logger::log(Logger::ERROR, "Refusing to save a table that failed to load over ", data_file);
+            return false;
+        }
+        try {
+            size_t count = write_table(table);
+            Logger::log(Logger::INFO, "Saved " + std::to_string(count) +
+                       " employees to " + data_file);
+            return true;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error saving data: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    // Makes table durable as cheaply as possible. The attached table's changes are
+    // already logged, so it is only checkpointed when the log is due; any other
+    // table is saved in full.
+    bool sync(const EmployeeHashTable& table) {
+        await_hydration();
+        if (&table != attached) return save(table);
+        bool due;
+        {
+            std::lock_guard<std::mutex> lock(file_mutex);
+            due = checkpoint_due() || sealed_pending;
+        }
+        if (due) {
+            try {
+                checkpoint();
+            } catch (const std::exception& e) {
+                Logger::log(Logger::ERROR, "Checkpoint failed, keeping write-ahead log: ", e.what());
+            }
+        }
+        return true;
+    }
+
+    // Reads the data file plus any logged changes into table. The attached table
+    // is already current and cannot be reloaded in place.
+    bool load(EmployeeHashTable& table) {
+        Metrics::Timer timer(Metrics::load_latency);
+        try {
+            LoadedData loaded;
+            {
+                std::lock_guard<std::mutex> lock(file_mutex);
+                if (&table == attached) {
+                    Logger::log(Logger::ERROR, "Refusing to reload the attached table in place");
+                    return false;
+                }
+                read_locked(loaded);
+            }
+            apply(table, loaded);
+            return true;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error loading data: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    void record_insert(const Employee& emp) override {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        append_locked([&] { wal->append_insert(emp); });
+    }
+
+    void record_update(const std::string& id, const Employee& emp) override {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        append_locked([&] { wal->append_update(id, emp); });
+    }
+
+    void record_remove(const std::string& id) override {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        append_locked([&] { wal->append_remove(id); });
+    }
+
+    void record_batch(const std::vector<CommittedChange>& changes) override {
+        std::lock_guard<std::mutex> lock(file_mutex);
+        append_locked([&] { wal->append_batch(changes); });
+    }
+
+    // Writes a backup archive of one consistent view of table; writers are not
+    // blocked. Archives in one directory share a chunk store, so a backup writes
+    // only the chunks no earlier backup there stored.
+    bool backup(const EmployeeHashTable& table, const std::string& archive, BackupArchive::Stats& stats) {
+        await_hydration();
+        std::lock_guard<std::mutex> lock(backup_mutex);
+        try {
+            std::string store = BackupArchive::store_path(archive);
+            if (!backup_store || backup_store->file() != store || !backup_store->current()) {
+                backup_store.reset();
+                auto opened = std::make_unique<ChunkStore>(store);
+                opened->open();
+                backup_store = std::move(opened);
+            }
+            stats = BackupArchive::write(table.view(), archive, *backup_store);
+            Logger::log(Logger::INFO, "Backed up ", std::to_string(stats.records), " employees to ", archive, " (",
+                        std::to_string(stats.new_chunks), " of ", std::to_string(stats.chunks), " chunks new, ",
+                        std::to_string(stats.stored_bytes), " bytes stored)");
+            return true;
+        } catch (const std::exception& e) {
+            // The store's index may name chunks that never reached the file
+            backup_store.reset();
+            Logger::log(Logger::ERROR, "Error writing backup: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    // Reads a backup into table. Archives are decompressed one chunk at a time,
+    // so only the parsed records build up, as in a load, and they reach the table
+    // in one bulk insert. Any other file is loaded as a data file, which is what
+    // backups used to be.
+    bool restore(EmployeeHashTable& table, const std::string& path) {
+        await_hydration();
+        if (!BackupArchive::is_archive(path)) return DataManager(path).load(table);
+
+        Metrics::Timer timer(Metrics::load_latency);
+        try {
+            std::vector<Employee> employees;
+            size_t expected = BackupArchive::read(path,
+                [&](Employee&& emp) { employees.push_back(std::move(emp)); },
+                [](const EmployeeException& e) {
+                    Logger::log(Logger::WARNING, "Failed to restore employee record: " + std::string(e.what()));
+                });
+            size_t restored = table.bulk_insert(std::move(employees)).inserted;
+            Logger::log(Logger::INFO, "Restored ", std::to_string(restored), " of ", std::to_string(expected),
+                        " employees from backup ", path);
+            return true;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error restoring backup: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    // CSV files are not the data file, so neither direction takes file_mutex; the
+    // export reads one consistent view and the import goes through bulk_insert()
+    bool export_csv(const EmployeeHashTable& table, const std::string& filename) {
+        await_hydration();
+        try {
+            std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                Logger::log(Logger::ERROR, "Failed to open CSV file for writing: " + filename);
+                return false;
+            }
+
+            size_t count = CsvFormat::write(file, table.view());
+            file.close();
+            if (!file) throw EmployeeException("Failed to write " + filename);
+
+            Logger::log(Logger::INFO, "Exported " + std::to_string(count) +
+                       " employees to CSV: " + filename);
+            return true;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error exporting CSV: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    struct CsvImportResult {
+        size_t rows = 0;
+        size_t malformed = 0;
+        EmployeeHashTable::BulkInsertResult stored;
+    };
+
+    // Rows that do not parse are counted and skipped; parsed rows still go through
+    // the table's validation and duplicate checks
+    bool import_csv(EmployeeHashTable& table, const std::string& filename, CsvImportResult& result) {
+        await_hydration();
+        try {
+            std::vector<CsvFormat::RowError> errors;
+            std::vector<Employee> employees;
+            {
+                MappedFile mapped(filename);
+                if (!mapped.data()) {
+                    Logger::log(Logger::ERROR, "CSV file is missing or empty: " + filename);
+                    return false;
+                }
+                employees = CsvFormat::read(mapped.data(), mapped.size(), errors);
+            }
+
+            result.malformed = errors.size();
+            result.rows = employees.size() + errors.size();
+            if (!errors.empty()) {
+                Logger::log(Logger::WARNING, "Skipped ", std::to_string(errors.size()),
+                            " malformed CSV rows in ", filename, ", first at line ",
+                            std::to_string(errors.front().line), ": ", errors.front().message);
+            }
+
+            result.stored = table.bulk_insert(std::move(employees));
+            Logger::log(Logger::INFO, "Imported " + std::to_string(result.stored.inserted) +
+                       " of " + std::to_string(result.rows) + " CSV rows from " + filename);
+            return true;
+        } catch (const std::exception& e) {
+            Logger::log(Logger::ERROR, "Error importing CSV: " + std::string(e.what()));
+            return false;
+        }
+    }
+};
+
+// ==================== REPORT ENGINE ====================
+
+// Every metric the report menu shows, gathered in one pass
+struct ReportSummary {
+    static constexpr size_t DEPARTMENTS = static_cast<size_t>(Department::UNKNOWN) + 1;
+    static constexpr size_t STATUSES = static_cast<size_t>(EmployeeStatus::TERMINATED) + 1;
+    static constexpr size_t SALARY_BANDS = 6;
+
+    size_t employee_count = 0;
+    std::array<size_t, DEPARTMENTS> department_count{};
+    std::array<double, DEPARTMENTS> department_salary{};
+    std::array<size_t, STATUSES> status_count{};
+
+    double total_salary = 0;
+    double min_salary = 0;
+    double max_salary = 0;
+    double median_salary = 0;
+    std::array<size_t, SALARY_BANDS> salary_band_count{};
+
+    size_t distinct_skills = 0;
+    std::vector<std::pair<std::string, size_t>> top_skills;  // Most common first
+};
+
+// Aggregates a view with one partial ReportSummary per worker thread, merged at
+// the end. The median comes from nth_element over the collected salaries rather
+// than a full sort, and only the leading skills are ordered.
+class ReportEngine {
+public:
+    // Upper limits of all but the last salary band
+    static constexpr std::array<double, ReportSummary::SALARY_BANDS - 1> SALARY_BAND_LIMITS = {
+        30000, 50000, 75000, 100000, 150000};
+    static constexpr size_t TOP_SKILLS = 15;
+
+    static ReportSummary summarize(const EmployeeHashTable::View& employees) {
+        const size_t n = employees.size();
+        const size_t workers = ParallelRange::workers_for(n, MIN_RECORDS_PER_WORKER);
+
+        std::vector<ReportSummary> partials(workers);
+        std::vector<std::unordered_map<std::string_view, size_t>> skill_counts(workers);
+        std::vector<double> salaries(n);
+
+        ParallelRange::run(n, workers, [&](size_t worker, size_t begin, size_t end) {
+            ReportSummary& part = partials[worker];
+            auto& skills = skill_counts[worker];
+            part.min_salary = std::numeric_limits<double>::infinity();
+            part.max_salary = -std::numeric_limits<double>::infinity();
+
+            for (size_t i = begin; i < end; ++i) {
+                const Employee& emp = employees[i];
+                const size_t dept = static_cast<size_t>(emp.department);
+                ++part.department_count[dept];
+                part.department_salary[dept] += emp.salary;
+                ++part.status_count[static_cast<size_t>(emp.status)];
+
+                part.total_salary += emp.salary;
+                part.min_salary = std::min(part.min_salary, emp.salary);
+                part.max_salary = std::max(part.max_salary, emp.salary);
+                ++part.salary_band_count[salary_band(emp.salary)];
+                salaries[i] = emp.salary;
+
+                // Views pin their records, so the keys stay valid until the merge
+                for (const auto& skill : emp.skills) ++skills[skill];
+            }
+            part.employee_count = end - begin;
+        });
+
+        ReportSummary summary = std::move(partials[0]);
+        for (size_t worker = 1; worker < workers; ++worker) {
+            const ReportSummary& part = partials[worker];
+            summary.employee_count += part.employee_count;
+            for (size_t i = 0; i < ReportSummary::DEPARTMENTS; ++i) {
+                summary.department_count[i] += part.department_count[i];
+                summary.department_salary[i] += part.department_salary[i];
+            }
+            for (size_t i = 0; i < ReportSummary::STATUSES; ++i) {
+                summary.status_count[i] += part.status_count[i];
+            }
+            for (size_t i = 0; i < ReportSummary::SALARY_BANDS; ++i) {
+                summary.salary_band_count[i] += part.salary_band_count[i];
+            }
+            summary.total_salary += part.total_salary;
+            summary.min_salary = std::min(summary.min_salary, part.min_salary);
+            summary.max_salary = std::max(summary.max_salary, part.max_salary);
+            for (const auto& [skill, count] : skill_counts[worker]) skill_counts[0][skill] += count;
+        }
+
+        if (n == 0) {
+            summary.min_salary = summary.max_salary = 0;
+        } else {
+            summary.median_salary = median(salaries);
+        }
+
+        std::vector<std::pair<std::string_view, size_t>> ranked(skill_counts[0].begin(), skill_counts[0].end());
+        summary.distinct_skills = ranked.size();
+        auto top_end = ranked.begin() + std::min(TOP_SKILLS, ranked.size());
+        std::partial_sort(ranked.begin(), top_end, ranked.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        for (auto it = ranked.begin(); it != top_end; ++it) {
+            summary.top_skills.emplace_back(std::string(it->first), it->second);
+        }
+
+        return summary;
+    }
+
+private:
+    // Below this many records per thread the merge costs more than it saves
+    static constexpr size_t MIN_RECORDS_PER_WORKER = 16384;
+
+    static size_t salary_band(double salary) {
+        size_t band = 0;
+        while (band < SALARY_BAND_LIMITS.size() && salary >= SALARY_BAND_LIMITS[band]) ++band;
+        return band;
+    }
+
+    // Reorders values; expects at least one
+    static double median(std::vector<double>& values) {
+        auto middle = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), middle, values.end());
+        if (values.size() % 2) return *middle;
+        return (*std::max_element(values.begin(), middle) + *middle) / 2;
+    }
+};
+
+// ==================== ADVANCED CLI INTERFACE ====================
+
+// On first run the opened table is empty and nobody could log in
+void create_default_admin(EmployeeHashTable& employee_db) {
+    if (employee_db.size() != 0) return;
+    try {
+        Employee admin("XX0069", "System", "Admin", "Chief Executive Officer",
+                        Department::ENGINEERING, 9999999.99, "admin@example.com",
+                        "+1234567890", AccessLevel::ADMIN);
+        employee_db.insert(admin);
+        Logger::log(Logger::INFO, "Created default admin user XX0069");
+    } catch (const EmployeeException& e) {
+        Logger::log(Logger::CRITICAL, "Failed to create default admin user: " + std::string(e.what()));
+    }
+}
+
+class AdvancedCLI {
+private:
+    static constexpr size_t PAGE_SIZE = 20;
+    static constexpr size_t NAME_MATCHES_SHOWN = 15;
+
+    EmployeeHashTable& db;
+    DataManager data_manager;
+    std::unique_ptr<Employee> currentUser;
+
+    void clear_screen() {
+        #ifdef _WIN32
+            system("cls");
+        #else
+            system("clear");
+        #endif
+    }
+
+    void pause() {
+        std::cout << "\nPress Enter to continue...";
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cin.get();
+    }
+
+    std::string get_input(const std::string& prompt) {
+        std::cout << prompt;
+        std::string input;
+        std::getline(std::cin, input);
+        return input;
+    }
+
+    double get_double_input(const std::string& prompt) {
+        while (true) {
+            try {
+                std::cout << prompt;
+                std::string input;
+                std::getline(std::cin, input);
+                return std::stod(input);
+            } catch (const std::exception&) {
+                std::cout << "Invalid number. Please try again.\n";
+            }
+        }
+    }
+
+    int get_int_input(const std::string& prompt, int min_val = 0, int max_val = INT_MAX) {
+        while (true) {
+            try {
+                std::cout << prompt;
+                std::string input;
+                std::getline(std::cin, input);
+                int value = std::stoi(input);
+                if (value >= min_val && value <= max_val) {
+                    return value;
+                }
+                std::cout << "Value must be between " << min_val << " and " << max_val << ".\n";
+            } catch (const std::exception&) {
+                std::cout << "Invalid number. Please try again.\n";
+            }
+        }
+    }
+
+    Department get_department_input() {
+        std::cout << "\nDepartments:\n"
+                  << "1. Engineering\n2. HR\n3. Finance\n4. Marketing\n5. Operations\n6. Sales\n";
+        int choice = get_int_input("Select department (1-6): ", 1, 6);
+        return static_cast<Department>(choice - 1);
+    }
+
+    EmployeeStatus get_status_input() {
+        std::cout << "\nStatus options:\n"
+                  << "1. Active\n2. Inactive\n3. On Leave\n4. Terminated\n";
+        int choice = get_int_input("Select status (1-4): ", 1, 4);
+        return static_cast<EmployeeStatus>(choice - 1);
+    }
+
+    AccessLevel get_access_level_input() {
+        std::cout << "\nAccess Level:\n"
+                  << "1. Basic\n2. Admin\n";
+        int choice = get_int_input("Select access level (1-2): ", 1, 2);
+        return static_cast<AccessLevel>(choice - 1);
+    }
+
+    std::vector<std::string> get_skills_input() {
+        std::vector<std::string> skills;
+        std::string skills_str = get_input("Enter skills (comma-separated): ");
+
+        if (!skills_str.empty()) {
+            std::istringstream iss(skills_str);
+            std::string skill;
+            while (std::getline(iss, skill, ',')) {
+                // Trim whitespace
+                skill.erase(0, skill.find_first_not_of(" \t"));
+                skill.erase(skill.find_last_not_of(" \t") + 1);
+                if (!skill.empty()) {
+                    skills.push_back(skill);
+                }
+            }
+        }
+
+        return skills;
+    }
+
+    void display_employee(const Employee& emp) {
+        auto time_t = std::chrono::system_clock::to_time_t(emp.hireDate);
+
+        std::cout << "\n" << std::string(60, '=') << "\n";
+        std::cout << "Employee Details\n";
+        std::cout << std::string(60, '=') << "\n";
+        std::cout << std::left << std::setw(15) << "ID:" << emp.id << "\n";
+        std::cout << std::left << std::setw(15) << "Name:" << emp.getFullName() << "\n";
+        std::cout << std::left << std::setw(15) << "Position:" << emp.position << "\n";
+        std::cout << std::left << std::setw(15) << "Department:" << emp.getDepartmentString() << "\n";
+        std::cout << std::left << std::setw(15) << "Salary:" << "$" << std::fixed << std::setprecision(2) << emp.salary << "\n";
+        std::cout << std::left << std::setw(15) << "Email:" << (emp.email.empty() ? "N/A" : emp.email) << "\n";
+        std::cout << std::left << std::setw(15) << "Phone:" << (emp.phone.empty() ? "N/A" : emp.phone) << "\n";
+        std::cout << std::left << std::setw(15) << "Hire Date:" << std::put_time(std::localtime(&time_t), "%Y-%m-%d") << "\n";
+        std::cout << std::left << std::setw(15) << "Status:" << emp.getStatusString() << "\n";
+        std::cout << std::left << std::setw(15) << "Manager ID:" << (emp.managerId.empty() ? "N/A" : emp.managerId.str()) << "\n";
+        std::cout << std::left << std::setw(15) << "Access Level:" << emp.getAccessLevelString() << "\n";
+        std::cout << std::left << std::setw(15) << "Skills:";
+        if (emp.skills.empty()) {
+            std::cout << "None\n";
+        } else {
+            for (size_t i = 0; i < emp.skills.size(); ++i) {
+                if (i == 0) std::cout << emp.skills[i];
+                else std::cout << ", " << emp.skills[i];
+            }
+            std::cout << "\n";
+        }
+        std::cout << std::string(60, '=') << "\n";
+    }
+
+    void display_employees_table(const std::vector<Employee>& employees, const std::string& footer = "") {
+        if (employees.empty()) {
+            std::cout << "\nNo employees found.\n";
+            return;
+        }
+
+        std::cout << "\n" << std::string(140, '=') << "\n";
+        std::cout << std::left
+                  << std::setw(8) << "ID"
+                  << std::setw(20) << "Name"
+                  << std::setw(20) << "Position"
+                  << std::setw(15) << "Department"
+                  << std::setw(12) << "Salary"
+                  << std::setw(25) << "Email"
+                  << std::setw(12) << "Status"
+                  << std::setw(10) << "Manager"
+                  << std::setw(10) << "Access"
+                  << "Skills\n";
+        std::cout << std::string(140, '-') << "\n";
+
+        for (const auto& emp : employees) {
+            std::cout << std::left
+                      << std::setw(8) << emp.id
+                      << std::setw(20) << (emp.getFullName().length() > 19 ?
+                                         emp.getFullName().substr(0, 16) + "..." : emp.getFullName())
+                      << std::setw(20) << (emp.position.size() > 19 ?
+                                         emp.position.str().substr(0, 16) + "..." : emp.position.str())
+                      << std::setw(15) << emp.getDepartmentString()
+                      << std::setw(12) << ("$" + std::to_string(static_cast<int>(emp.salary)))
+                      << std::setw(25) << (emp.email.length() > 24 ?
+                                         emp.email.substr(0, 21) + "..." :
+                                         (emp.email.empty() ? "N/A" : emp.email))
+                      << std::setw(12) << emp.getStatusString()
+                      << std::setw(10) << (emp.managerId.empty() ? "N/A" : emp.managerId.str())
+                      << std::setw(10) << emp.getAccessLevelString()
+                      << (emp.skills.empty() ? "None" : emp.skills.at(0).str()) << "\n";
+        }
+        std::cout << std::string(140, '=') << "\n";
+        if (footer.empty()) {
+            std::cout << "Total employees: " << employees.size() << "\n";
+        } else {
+            std::cout << footer << "\n";
+        }
+    }
+
+public:
+    // With lazy_cache_bytes the data file is opened lazily, caching up to that
+    // many bytes of records faulted in before the table has loaded
+    explicit AdvancedCLI(EmployeeHashTable& database, std::chrono::seconds autosave = std::chrono::seconds(0),
+                         std::optional<size_t> lazy_cache_bytes = std::nullopt)
+        : db(database) {
+        Logger::init();
+        bool opened = lazy_cache_bytes ? data_manager.open_lazy(db, *lazy_cache_bytes) : data_manager.open(db);
+        if (!opened) throw EmployeeException("Cannot open the data files; see the log for details");
+        // A lazily opened table is only known to be empty once it has loaded; see login()
+        if (data_manager.hydrated()) create_default_admin(db);
+        data_manager.set_autosave(autosave);
+    }
+
+    ~AdvancedCLI() {
+        data_manager.sync(db);
+    }
+
+    void run() {
+        std::cout << "\n" << std::string(60, '=') << "\n";
+        std::cout << "      ENTERPRISE EMPLOYEE MANAGEMENT SYSTEM\n";
+        std::cout << std::string(60, '=') << "\n";
+        
+        if (!login()) {
+            std::cout << "\nInvalid login. Exiting.\n";
+            return;
+        }
+
+        while (true) {
+            try {
+                show_main_menu();
+                int choice = 0;
+                if (currentUser->accessLevel == AccessLevel::ADMIN) {
+                    choice = get_int_input("\nSelect option (1-13): ", 1, 13);
+                } else {
+                    choice = get_int_input("\nSelect option (1-7): ", 1, 7);
+                }
+
+                // A lazy open is still loading the table in the background; only
+                // Find Employee can be answered before it is done
+                if (choice != (currentUser->accessLevel == AccessLevel::ADMIN ? 4 : 1)) await_full_table();
+
+                if (currentUser->accessLevel == AccessLevel::ADMIN) {
+                    switch (choice) {
+                        case 1: add_employee(); break;
+                        case 2: remove_employee(); break;
+                        case 3: update_employee(); break;
+                        case 4: find_employee(); break;
+                        case 5: advanced_search(); break;
+                        case 6: display_all_employees(); break;
+                        case 7: generate_reports(); break;
+                        case 8: import_export_menu(); break;
+                        case 9: system_statistics(); break;
+                        case 10: data_management(); break;
+                        case 11: help_documentation(); break;
+                        case 12: edit_my_profile(); break;
+                        case 13:
+                            std::cout << "\nSaving data and exiting...\n";
+                            data_manager.sync(db);
+                            return;
+                    }
+                } else { // Basic user
+                    switch (choice) {
+                        case 1: find_employee(); break;
+                        case 2: advanced_search(); break;
+                        case 3: display_all_employees(); break;
+                        case 4: generate_reports(); break;
+                        case 5: help_documentation(); break;
+                        case 6: edit_my_profile(); break;
+                        case 7:
+                            std::cout << "\nSaving data and exiting...\n";
+                            data_manager.sync(db);
+                            return;
+                        default:
+                            std::cout << "\nInvalid option for a basic user. Please try again.\n";
+                            pause();
+                    }
+                }
+            } catch (const EmployeeException& e) {
+                std::cout << "\nError: " << e.what() << "\n";
+                pause();
+            } catch (const std::exception& e) {
+                std::cout << "\nUnexpected error: " << e.what() << "\n";
+                Logger::log(Logger::CRITICAL, "Unexpected error: " + std::string(e.what()));
+                pause();
+            }
+        }
+    }
+
+private:
+    void await_full_table() {
+        if (data_manager.hydrated()) return;
+        std::cout << "\nLoading the remaining employee records...\n" << std::flush;
+        data_manager.await_hydration();
+    }
+
+    bool login() {
+        int attempts = 3;
         while (attempts > 0) {
             std::string id = get_input("Enter your Employee ID to log in: ");
-            Employee* emp = db.find(id);
+            auto emp = data_manager.lookup(db, id);
+            if (!emp && !data_manager.hydrated()) {
+                data_manager.await_hydration();
+                create_default_admin(db);
+                emp = db.snapshot(id);
+            }
+            if (emp) {
+                currentUser = std::make_unique<Employee>(*emp);
+                std::cout << "\nLogin successful. Welcome, " << currentUser->getFullName() << " (" << currentUser->getAccessLevelString() << ").\n";
+                pause();
+                return true;
+            } else {
+                std::cout << "\nEmployee ID not found. " << --attempts << " attempts remaining.\n";
+            }
+        }
+        return false;
+    }
+
+    void show_main_menu() {
+        clear_screen();
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        std::cout << "           MAIN MENU\n";
+        std::cout << std::string(50, '=') << "\n";
+        std::cout << "Logged in as: " << currentUser->getFullName() << " (" << currentUser->getAccessLevelString() << ")\n";
+        std::cout << std::string(50, '-') << "\n";
+
+        if (currentUser->accessLevel == AccessLevel::ADMIN) {
+            std::cout << " 1.  Add Employee\n";
+            std::cout << " 2.  Remove Employee\n";
+            std::cout << " 3.  Update Employee\n";
+            std::cout << " 4.  Find Employee\n";
+            std::cout << " 5.  Advanced Search\n";
+            std::cout << " 6.  Display All Employees\n";
+            std::cout << " 7.  Generate Reports\n";
+            std::cout << " 8.  Import/Export Data\n";
+            std::cout << " 9.  System Statistics\n";
+            std::cout << "10.  Data Management\n";
+            std::cout << "11.  Help & Documentation\n";
+            std::cout << "12.  Edit My Profile\n";
+            std::cout << "13.  Exit\n";
+            std::cout << std::string(50, '=') << "\n";
+            if (!data_manager.hydrated()) {
+                std::cout << "Database: still loading in the background\n";
+                return;
+            }
+            const TableAggregates totals = db.aggregates();
+            std::cout << "Database size: " << totals.employee_count << " employees ("
+                      << totals.status_count[static_cast<size_t>(EmployeeStatus::ACTIVE)] << " active)\n";
+            std::cout << "Mean salary: $" << std::fixed << std::setprecision(2) << totals.mean_salary() << "\n";
+            std::cout << "Load factor: " << std::fixed << std::setprecision(3) << db.load_factor() << "\n";
+        } else { // Basic user menu
+            std::cout << " 1.  Find Employee (by ID)\n";
+            std::cout << " 2.  Advanced Search\n";
+            std::cout << " 3.  Display All Employees\n";
+            std::cout << " 4.  Generate Reports\n";
+            std::cout << " 5.  Help & Documentation\n";
+            std::cout << " 6.  Edit My Profile\n";
+            std::cout << " 7.  Exit\n";
+            std::cout << std::string(50, '=') << "\n";
+            if (!data_manager.hydrated()) {
+                std::cout << "Database: still loading in the background\n";
+            } else {
+                std::cout << "Database size: " << db.size() << " employees\n";
+            }
+        }
+    }
+
+    void edit_my_profile() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "       EDIT MY PROFILE\n";
+        std::cout << std::string(40, '=') << "\n";
+        display_employee(*currentUser);
+
+        std::cout << "\nUpdate fields (press Enter to keep current value):\n";
+
+        Employee updated = *currentUser;
+
+        std::string input;
+        
+        input = get_input("First Name [" + updated.firstName + "]: ");
+        if (!input.empty()) updated.firstName = input;
+
+        input = get_input("Last Name [" + updated.lastName + "]: ");
+        if (!input.empty()) updated.lastName = input;
+
+        input = get_input("Phone [" + updated.phone + "]: ");
+        if (!input.empty()) updated.phone = input;
+
+        input = get_input("Email [" + updated.email + "]: ");
+        if (!input.empty()) updated.email = input;
+        
+        std::cout << "Change skills? (y/n) - Current: ";
+        if (updated.skills.empty()) std::cout << "None\n";
+        else {
+            for (const auto& skill : updated.skills) std::cout << skill << " ";
+            std::cout << "\n";
+        }
+        input = get_input("");
+        if (input == "y" || input == "Y") {
+            updated.skills = get_skills_input();
+        }
+
+        try {
+            if (db.update(currentUser->id, updated)) {
+                *currentUser = updated; // Update the in-memory user object
+                std::cout << "\n✓ Profile updated successfully!\n";
+                display_employee(*currentUser);
+            } else {
+                std::cout << "\n✗ Failed to update profile.\n";
+            }
+        } catch (const EmployeeException& e) {
+            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
+        }
+
+        pause();
+    }
+
+    void add_employee() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "         ADD EMPLOYEE\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        try {
+            Employee emp;
+
+            emp.id = get_input("Employee ID (format: AB1234): ");
+            emp.firstName = get_input("First Name: ");
+            emp.lastName = get_input("Last Name: ");
+            emp.position = get_input("Position: ");
+            emp.department = get_department_input();
+            emp.salary = get_double_input("Salary: $");
+            emp.email = get_input("Email (optional): ");
+            emp.phone = get_input("Phone (optional): ");
+            emp.managerId = get_input("Manager ID (optional): ");
+            emp.accessLevel = get_access_level_input();
+            emp.skills = get_skills_input();
+            
+            if (db.insert(emp)) {
+                std::cout << "\n✓ Employee added successfully!\n";
+                display_employee(emp);
+            } else {
+                std::cout << "\n✗ Failed to add employee. ID may already exist.\n";
+            }
+        } catch (const EmployeeException& e) {
+            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
+        }
+
+        pause();
+    }
+
+    void remove_employee() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "       REMOVE EMPLOYEE\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        std::string id = get_input("Enter Employee ID to remove: ");
+
+        auto emp = db.snapshot(id);
+        if (emp) {
+            display_employee(*emp);
+            std::string confirm = get_input("\nAre you sure you want to remove this employee? (yes/no): ");
+
+            if (confirm == "yes" || confirm == "YES" || confirm == "y" || confirm == "Y") {
+                if (db.remove(id)) {
+                    std::cout << "\n✓ Employee removed successfully!\n";
+                } else {
+                    std::cout << "\n✗ Failed to remove employee.\n";
+                }
+            } else {
+                std::cout << "\nOperation cancelled.\n";
+            }
+        } else {
+            std::cout << "\n✗ Employee not found.\n";
+        }
+
+        pause();
+    }
+
+    void update_employee() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "       UPDATE EMPLOYEE\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        std::string id = get_input("Enter Employee ID to update: ");
+
+        auto emp = db.snapshot(id);
+        if (!emp) {
+            std::cout << "\n✗ Employee not found.\n";
+            pause();
+            return;
+        }
+
+        display_employee(*emp);
+
+        std::cout << "\nUpdate fields (press Enter to keep current value):\n";
+
+        Employee updated = *emp;
+
+        std::string input = get_input("First Name [" + emp->firstName + "]: ");
+        if (!input.empty()) updated.firstName = input;
+
+        input = get_input("Last Name [" + emp->lastName + "]: ");
+        if (!input.empty()) updated.lastName = input;
+
+        input = get_input("Position [" + emp->position.str() + "]: ");
+        if (!input.empty()) updated.position = input;
+
+        std::cout << "Department [" << emp->getDepartmentString() << "] - Change? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            updated.department = get_department_input();
+        }
+
+        input = get_input("Salary [$" + std::to_string(emp->salary) + "]: ");
+        if (!input.empty()) {
+            try {
+                updated.salary = std::stod(input);
+            } catch (const std::exception&) {
+                std::cout << "Invalid salary, keeping current value.\n";
+            }
+        }
+
+        input = get_input("Email [" + emp->email + "]: ");
+        if (!input.empty()) updated.email = input;
+
+        input = get_input("Phone [" + emp->phone + "]: ");
+        if (!input.empty()) updated.phone = input;
+
+        input = get_input("Manager ID [" + emp->managerId.str() + "]: ");
+        if (!input.empty()) updated.managerId = input;
+
+        std::cout << "Status [" << emp->getStatusString() << "] - Change? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            updated.status = get_status_input();
+        }
+        
+        std::cout << "Access Level [" << emp->getAccessLevelString() << "] - Change? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            updated.accessLevel = get_access_level_input();
+        }
+
+        try {
+            if (db.update(id, updated)) {
+                std::cout << "\n✓ Employee updated successfully!\n";
+                display_employee(updated);
+            } else {
+                std::cout << "\n✗ Failed to update employee.\n";
+            }
+        } catch (const EmployeeException& e) {
+            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
+        }
+
+        pause();
+    }
+
+    void find_employee() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "        FIND EMPLOYEE\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        std::string query = get_input("Enter Employee ID or name: ");
+
+        if (Validator::isValidID(query)) {
+            auto emp = data_manager.lookup(db, query);
             if (emp) {
-                currentUser = std::make_unique<Employee>(*emp);
-                std::cout << "\nLogin successful. Welcome, " << currentUser->getFullName() << " (" << currentUser->getAccessLevelString() << ").\n";
-                pause();
-                return true;
+                display_employee(*emp);
+                // Reporting lines walk the whole table
+                if (data_manager.hydrated()) {
+                    display_reporting_lines(query);
+                } else {
+                    std::cout << "Reporting lines are shown once all records have loaded.\n";
+                }
+            } else {
+                std::cout << "\n✗ Employee not found.\n";
+            }
+            pause();
+            return;
+        }
+
+        await_full_table();
+        auto matches = db.find_by_name(query, NAME_MATCHES_SHOWN);
+        if (matches.empty()) {
+            std::cout << "\n✗ No employee name or position resembles \"" << query << "\".\n";
+        } else if (matches.size() == 1) {
+            display_employee(matches.front().employee);
+            display_reporting_lines(matches.front().employee.id);
+        } else {
+            static const char* const fields[] = {"first name", "last name", "position"};
+            static const char* const qualities[] = {"exact", "prefix", "contains"};
+            std::cout << "\n" << std::left << std::setw(8) << "ID" << std::setw(25) << "Name"
+                      << std::setw(25) << "Position" << "Match\n";
+            std::cout << std::string(75, '-') << "\n";
+            for (const auto& match : matches) {
+                const Employee& emp = match.employee;
+                std::string quality = match.quality < 3 ? qualities[match.quality] :
+                                      std::to_string(match.quality - 2) + " edit" + (match.quality > 3 ? "s" : "");
+                std::cout << std::left << std::setw(8) << emp.id << std::setw(25) << emp.getFullName()
+                          << std::setw(25) << emp.position.str()
+                          << fields[static_cast<size_t>(match.field)] << ", " << quality << "\n";
+            }
+            std::cout << "\nEnter an ID to see the full record.\n";
+        }
+
+        pause();
+    }
+
+    void display_reporting_lines(const std::string& id) {
+        auto chain = db.chain_of_command(id);
+        if (!chain.managers.empty()) {
+            std::cout << std::left << std::setw(15) << "Reports To:";
+            bool first = true;
+            for (const auto& manager : chain.managers) {
+                std::cout << (first ? "" : " → ") << manager.getFullName() << " (" << manager.id << ")";
+                first = false;
+            }
+            if (chain.cycle) std::cout << " → ⚠ cycle";
+            std::cout << "\n";
+        }
+
+        auto span = db.span_of_control(id);
+        if (span.total > 0) {
+            std::cout << std::left << std::setw(15) << "Team Size:" << span.direct << " direct, "
+                      << span.total << " total\n";
+        }
+    }
+    void advanced_search() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "      ADVANCED SEARCH\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        SearchCriteria criteria;
+        std::string input;
+
+        input = get_input("First Name (partial match): ");
+        if (!input.empty()) criteria.firstName = input;
+
+        input = get_input("Last Name (partial match): ");
+        if (!input.empty()) criteria.lastName = input;
+
+        input = get_input("Position (partial match): ");
+        if (!input.empty()) criteria.position = input;
+
+        std::cout << "Filter by Department? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            criteria.department = get_department_input();
+        }
+
+        input = get_input("Minimum Salary (optional): ");
+        if (!input.empty()) {
+            try {
+                criteria.minSalary = std::stod(input);
+            } catch (const std::exception&) {
+                std::cout << "Invalid salary format.\n";
+            }
+        }
+
+        input = get_input("Maximum Salary (optional): ");
+        if (!input.empty()) {
+            try {
+                criteria.maxSalary = std::stod(input);
+            } catch (const std::exception&) {
+                std::cout << "Invalid salary format.\n";
+            }
+        }
+
+        std::cout << "Filter by Status? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            criteria.status = get_status_input();
+        }
+
+        input = get_input("Skill (partial match): ");
+        if (!input.empty()) criteria.skill = input;
+
+        std::cout << "Case sensitive search? (y/n): ";
+        std::getline(std::cin, input);
+        criteria.caseSensitive = (input == "y" || input == "Y");
+
+        input = get_input("Maximum results (optional): ");
+        if (!input.empty()) {
+            try {
+                criteria.limit = std::stoul(input);
+            } catch (const std::exception&) {
+                std::cout << "Invalid number, showing all results.\n";
+            }
+        }
+
+        std::cout << "Count only? (y/n): ";
+        std::getline(std::cin, input);
+        if (input == "y" || input == "Y") {
+            std::cout << "\nMatching employees: " << db.count(criteria) << "\n";
+            pause();
+            return;
+        }
+
+        auto results = db.search(criteria);
+
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "Search Results (" << results.size() << " found"
+                  << (criteria.limit && results.size() == *criteria.limit ? ", limit reached" : "") << ")\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        display_employees_table(results);
+
+        pause();
+    }
+
+    void display_all_employees() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "      ALL EMPLOYEES\n";
+        std::cout << std::string(40, '=') << "\n";
+        std::cout << "1. By ID\n";
+        std::cout << "2. By Name\n";
+        std::cout << "3. By Salary\n";
+        std::cout << "4. By Hire Date\n";
+
+        PageRequest request;
+        request.key = static_cast<SortKey>(get_int_input("Select order (1-4): ", 1, 4) - 1);
+        std::cout << "Descending? (y/n): ";
+        std::string input;
+        std::getline(std::cin, input);
+        request.descending = (input == "y" || input == "Y");
+        request.size = PAGE_SIZE;
+
+        // Each page is fetched from the sorted index, so nothing beyond the page is copied
+        size_t total = db.size();
+        size_t shown = 0;
+        while (true) {
+            EmployeePage page = db.page(request);
+            std::string footer = page.employees.empty() ? "" :
+                "Showing " + std::to_string(shown + 1) + "-" + std::to_string(shown + page.employees.size()) +
+                " of " + std::to_string(total);
+            display_employees_table(page.employees, footer);
+            shown += page.employees.size();
+            if (!page.has_more) break;
+
+            std::cout << "Press Enter for the next page, or q to stop: ";
+            std::getline(std::cin, input);
+            if (input == "q" || input == "Q") break;
+            request.after = page.employees.back();
+        }
+
+        pause();
+    }
+
+    void generate_reports() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "        REPORTS\n";
+        std::cout << std::string(40, '=') << "\n";
+        std::cout << "1. Department Summary\n";
+        std::cout << "2. Salary Statistics\n";
+        std::cout << "3. Employee Status Report\n";
+        std::cout << "4. Skill Analysis\n";
+        std::cout << "5. Management Hierarchy\n";
+
+        int choice = get_int_input("Select report (1-5): ", 1, 5);
+
+        if (choice == 5) {
+            generate_hierarchy_report();
+        } else {
+            ReportSummary summary = ReportEngine::summarize(db.view());
+            switch (choice) {
+                case 1: generate_department_report(summary); break;
+                case 2: generate_salary_report(summary); break;
+                case 3: generate_status_report(summary); break;
+                case 4: generate_skills_report(summary); break;
+            }
+        }
+
+        pause();
+    }
+
+    void generate_department_report(const ReportSummary& summary) {
+        std::cout << "\n" << std::string(60, '=') << "\n";
+        std::cout << "              DEPARTMENT SUMMARY\n";
+        std::cout << std::string(60, '=') << "\n";
+
+        const char* dept_names[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
+
+        for (size_t dept = 0; dept < ReportSummary::DEPARTMENTS; ++dept) {
+            size_t count = summary.department_count[dept];
+            if (count == 0) continue;
+
+            double total_salary = summary.department_salary[dept];
+            double avg_salary = total_salary / count;
+
+            std::cout << "\n" << dept_names[dept] << ":\n";
+            std::cout << "  Employees: " << count << "\n";
+            std::cout << "  Total Salary Budget: $" << std::fixed << std::setprecision(2) << total_salary << "\n";
+            std::cout << "  Average Salary: $" << std::fixed << std::setprecision(2) << avg_salary << "\n";
+        }
+    }
+
+    void generate_salary_report(const ReportSummary& summary) {
+        if (summary.employee_count == 0) {
+            std::cout << "\nNo employees to analyze.\n";
+            return;
+        }
+
+        double average = summary.total_salary / summary.employee_count;
+
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        std::cout << "           SALARY STATISTICS\n";
+        std::cout << std::string(50, '=') << "\n";
+        std::cout << "Total Employees: " << summary.employee_count << "\n";
+        std::cout << "Total Payroll: $" << std::fixed << std::setprecision(2) << summary.total_salary << "\n";
+        std::cout << "Average Salary: $" << std::fixed << std::setprecision(2) << average << "\n";
+        std::cout << "Median Salary: $" << std::fixed << std::setprecision(2) << summary.median_salary << "\n";
+        std::cout << "Minimum Salary: $" << std::fixed << std::setprecision(2) << summary.min_salary << "\n";
+        std::cout << "Maximum Salary: $" << std::fixed << std::setprecision(2) << summary.max_salary << "\n";
+
+        // Salary ranges, bounded by ReportEngine::SALARY_BAND_LIMITS
+        std::string range_labels[] = {"<$30K", "$30K-50K", "$50K-75K", "$75K-100K", "$100K-150K", ">$150K"};
+
+        std::cout << "\nSalary Distribution:\n";
+        for (size_t i = 0; i < ReportSummary::SALARY_BANDS; i++) {
+            size_t count = summary.salary_band_count[i];
+            std::cout << "  " << std::left << std::setw(12) << range_labels[i]
+                      << ": " << count << " ("
+                      << std::fixed << std::setprecision(1)
+                      << (100.0 * count / summary.employee_count) << "%)\n";
+        }
+    }
+
+    void generate_status_report(const ReportSummary& summary) {
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "       EMPLOYEE STATUS\n";
+        std::cout << std::string(40, '=') << "\n";
+
+        const char* status_names[] = {"Active", "Inactive", "On Leave", "Terminated"};
+
+        for (size_t i = 0; i < ReportSummary::STATUSES; i++) {
+            size_t count = summary.status_count[i];
+            double percentage = summary.employee_count == 0 ? 0 : (100.0 * count / summary.employee_count);
+
+            std::cout << std::left << std::setw(12) << status_names[i]
+                      << ": " << count << " ("
+                      << std::fixed << std::setprecision(1) << percentage << "%)\n";
+        }
+    }
+
+    void generate_skills_report(const ReportSummary& summary) {
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        std::cout << "             SKILL ANALYSIS\n";
+        std::cout << std::string(50, '=') << "\n";
+        std::cout << "Total Unique Skills: " << summary.distinct_skills << "\n\n";
+        std::cout << "Most Common Skills:\n";
+
+        for (size_t i = 0; i < summary.top_skills.size(); i++) {
+            std::cout << std::right << std::setw(2) << (i + 1) << ". "
+                      << std::left << std::setw(25) << summary.top_skills[i].first
+                      << ": " << summary.top_skills[i].second << " employees\n";
+        }
+    }
+
+    void generate_hierarchy_report() {
+        std::cout << "\n" << std::string(50, '=') << "\n";
+        std::cout << "           MANAGEMENT HIERARCHY\n";
+        std::cout << std::string(50, '=') << "\n";
+
+        auto roots = db.org_roots();
+
+        // Display hierarchy from each top-level manager (one with no manager)
+        for (const auto& mgr : roots.top_managers) {
+            auto tree = db.subtree(mgr.id);
+            for (size_t i = 0; i < tree.members.size(); ++i) {
+                const Employee& emp = tree.members[i];
+                if (tree.depth[i] == 0) {
+                    std::cout << emp.getFullName() << " (" << emp.id << ") - " << emp.position << "\n";
+                } else {
+                    std::cout << std::string(tree.depth[i] * 2, ' ') << "├─ " << emp.getFullName()
+                              << " (" << emp.id << ") - " << emp.position << "\n";
+                }
+            }
+            if (tree.cycle) {
+                std::cout << "  ⚠ Reporting cycle detected under " << mgr.id << "\n";
+            }
+            std::cout << "\n";
+        }
+
+        // Show orphaned managers (managers not in employee database)
+        std::cout << "External/Missing Managers:\n";
+        for (const auto& [manager_id, reports] : roots.missing_managers) {
+            std::cout << "  " << manager_id << " (manages " << reports << " employees)\n";
+        }
+    }
+
+    void import_export_menu() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "      IMPORT/EXPORT\n";
+        std::cout << std::string(40, '=') << "\n";
+        std::cout << "1. Export to CSV\n";
+        std::cout << "2. Manual Backup\n";
+        std::cout << "3. Load from Backup\n";
+        std::cout << "4. View Data Files\n";
+        std::cout << "5. Import from CSV\n";
+
+        int choice = get_int_input("Select option (1-5): ", 1, 5);
+
+        switch (choice) {
+            case 1: export_csv(); break;
+            case 2: manual_backup(); break;
+            case 3: load_backup(); break;
+            case 4: view_data_files(); break;
+            case 5: import_csv(); break;
+        }
+
+        pause();
+    }
+
+    void export_csv() {
+        std::string filename = get_input("Enter CSV filename (e.g., employees.csv): ");
+        if (filename.empty()) filename = "employees.csv";
+
+        if (data_manager.export_csv(db, filename)) {
+            std::cout << "\n✓ Data exported successfully to " << filename << "\n";
+        } else {
+            std::cout << "\n✗ Export failed.\n";
+        }
+    }
+
+    void import_csv() {
+        std::string filename = get_input("Enter CSV filename to import: ");
+        if (filename.empty()) filename = "employees.csv";
+
+        DataManager::CsvImportResult result;
+        if (!data_manager.import_csv(db, filename, result)) {
+            std::cout << "\n✗ Import failed. See the log for details.\n";
+            return;
+        }
+
+        std::cout << "\n✓ Imported " << result.stored.inserted << " of " << result.rows << " rows\n";
+        if (result.malformed) std::cout << "  Malformed rows skipped: " << result.malformed << "\n";
+        if (result.stored.invalid) std::cout << "  Invalid records skipped: " << result.stored.invalid << "\n";
+        if (result.stored.duplicates) std::cout << "  Duplicate IDs skipped: " << result.stored.duplicates << "\n";
+        data_manager.sync(db);
+    }
+
+    void manual_backup() {
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+
+        std::ostringstream oss;
+        oss << "backup_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S") << ".dat";
+
+        BackupArchive::Stats stats;
+        if (data_manager.backup(db, oss.str(), stats)) {
+            std::cout << "\n✓ Manual backup created: " << oss.str() << "\n";
+            std::cout << "  " << stats.records << " employees, " << stats.new_chunks << " of " << stats.chunks
+                      << " chunks new, " << stats.stored_bytes + stats.archive_bytes << " bytes written ("
+                      << stats.raw_bytes << " uncompressed)\n";
+        } else {
+            std::cout << "\n✗ Backup failed.\n";
+        }
+    }
+
+    void load_backup() {
+        std::string filename = get_input("Enter backup filename: ");
+        std::string confirm = get_input("This will replace current data. Continue? (yes/no): ");
+
+        if (confirm == "yes" || confirm == "YES") {
+            // Create temporary database
+            EmployeeHashTable temp_db(17, db.backend());
+            if (data_manager.restore(temp_db, filename)) {
+                // Clear current database and load backup
+                data_manager.replace_table(db, std::move(temp_db));
+                data_manager.save(db);
+                std::cout << "\n✓ Backup loaded successfully.\n";
             } else {
-                std::cout << "\nEmployee ID not found. " << --attempts << " attempts remaining.\n";
+                std::cout << "\n✗ Failed to load backup.\n";
             }
+        } else {
+            std::cout << "\nOperation cancelled.\n";
         }
-        return false;
     }
 
-    void show_main_menu() {
+    void view_data_files() {
+        std::cout << "\nData Files Information:\n";
+        std::cout << "Primary data file: employees.dat\n";
+        std::cout << "Automatic backup: employees.dat.bak\n";
+        std::cout << "Write-ahead log: employees.dat.wal\n";
+        std::cout << "Record index: employees.dat.idx\n";
+        std::cout << "Log file: employee_system.log\n";
+
+        // Check file sizes
+        std::ifstream primary("employees.dat", std::ios::ate | std::ios::binary);
+        if (primary.good()) {
+            std::cout << "Primary file size: " << primary.tellg() << " bytes\n";
+        } else {
+            std::cout << "Primary file: Not found\n";
+        }
+
+        std::ifstream record_index("employees.dat.idx", std::ios::ate | std::ios::binary);
+        if (record_index.good()) {
+            std::cout << "Record index size: " << record_index.tellg() << " bytes\n";
+        } else {
+            std::cout << "Record index: Not written yet\n";
+        }
+
+        std::ifstream backup("employees.dat.bak", std::ios::ate | std::ios::binary);
+        if (backup.good()) {
+            std::cout << "Backup file size: " << backup.tellg() << " bytes\n";
+        } else {
+            std::cout << "Backup file: Not found\n";
+        }
+
+        // Every manual backup in this directory shares one chunk store
+        std::ifstream chunks(BackupArchive::STORE_NAME, std::ios::ate | std::ios::binary);
+        if (chunks.good()) {
+            std::cout << "Backup chunk store (" << BackupArchive::STORE_NAME << ") size: " << chunks.tellg()
+                      << " bytes\n";
+        } else {
+            std::cout << "Backup chunk store: Not created yet\n";
+        }
+    }
+
+    void system_statistics() {
         clear_screen();
         std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "           MAIN MENU\n";
+        std::cout << "           SYSTEM STATISTICS\n";
         std::cout << std::string(50, '=') << "\n";
-        std::cout << "Logged in as: " << currentUser->getFullName() << " (" << currentUser->getAccessLevelString() << ")\n";
-        std::cout << std::string(50, '-') << "\n";
 
-        if (currentUser->accessLevel == AccessLevel::ADMIN) {
-            std::cout << " 1.  Add Employee\n";
-            std::cout << " 2.  Remove Employee\n";
-            std::cout << " 3.  Update Employee\n";
-            std::cout << " 4.  Find Employee\n";
-            std::cout << " 5.  Advanced Search\n";
-            std::cout << " 6.  Display All Employees\n";
-            std::cout << " 7.  Generate Reports\n";
-            std::cout << " 8.  Import/Export Data\n";
-            std::cout << " 9.  System Statistics\n";
-            std::cout << "10.  Data Management\n";
-            std::cout << "11.  Help & Documentation\n";
-            std::cout << "12.  Edit My Profile\n";
-            std::cout << "13.  Exit\n";
-            std::cout << std::string(50, '=') << "\n";
-            std::cout << "Database size: " << db.size() << " employees\n";
-            std::cout << "Load factor: " << std::fixed << std::setprecision(3) << db.load_factor() << "\n";
-        } else { // Basic user menu
-            std::cout << " 1.  Find Employee (by ID)\n";
-            std::cout << " 2.  Advanced Search\n";
-            std::cout << " 3.  Display All Employees\n";
-            std::cout << " 4.  Generate Reports\n";
-            std::cout << " 5.  Help & Documentation\n";
-            std::cout << " 6.  Edit My Profile\n";
-            std::cout << " 7.  Exit\n";
-            std::cout << std::string(50, '=') << "\n";
-            std::cout << "Database size: " << db.size() << " employees\n";
+        const TableAggregates totals = db.aggregates();
+
+        std::cout << "Database Overview:\n";
+        std::cout << "  Total Employees: " << totals.employee_count << "\n";
+
+        // Hash table performance
+        db.get_statistics(std::cout);
+
+        const MemoryUsage memory = db.memory_usage();
+        std::cout << "\nMemory Usage:\n";
+        std::cout << "  Record Storage: " << (memory.store_bytes / 1024) << " KB ("
+                  << sizeof(Employee) << " bytes per record inline)\n";
+        std::cout << "  Record Strings: " << (memory.record_heap_bytes / 1024) << " KB\n";
+        std::cout << "  Shared Strings: " << (memory.shared_strings.bytes / 1024) << " KB ("
+                  << memory.shared_strings.strings << " distinct positions and skills)\n";
+        std::cout << "  Indexes (estimated): " << (memory.index_bytes / 1024) << " KB\n";
+        std::cout << "  Total: " << (memory.total() / 1024) << " KB, "
+                  << std::fixed << std::setprecision(1) << memory.bytes_per_record() << " bytes per employee\n";
+
+        std::cout << "\nSalary Overview:\n";
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  Total Payroll: $" << totals.total_salary << "\n";
+        std::cout << "  Mean Salary: $" << totals.mean_salary() << "\n";
+        std::cout << "  Std Deviation: $" << totals.salary_stddev << "\n";
+        std::cout << "  Range: $" << totals.min_salary << " - $" << totals.max_salary << "\n";
+
+        std::cout << "\nDepartment Distribution:\n";
+        const char* dept_names[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
+        for (size_t i = 0; i < TableAggregates::DEPARTMENTS; i++) {
+            std::cout << "  " << std::left << std::setw(12) << dept_names[i]
+                      << ": " << totals.department_count[i] << "\n";
+        }
+
+        std::cout << "\nStatus Distribution:\n";
+        const char* status_names[] = {"Active", "Inactive", "On Leave", "Terminated"};
+        for (size_t i = 0; i < TableAggregates::STATUSES; i++) {
+            std::cout << "  " << std::left << std::setw(12) << status_names[i]
+                      << ": " << totals.status_count[i] << "\n";
+        }
+
+        std::cout << "\nHot-Path Metrics:\n";
+        Metrics::write_text(std::cout);
+
+        pause();
+    }
+
+    void data_management() {
+        clear_screen();
+        std::cout << "\n" << std::string(40, '=') << "\n";
+        std::cout << "     DATA MANAGEMENT\n";
+        std::cout << std::string(40, '=') << "\n";
+        std::cout << "1. Save Data Now\n";
+        std::cout << "2. Reload Data\n";
+        std::cout << "3. Clear All Data\n";
+        std::cout << "4. Data Validation\n";
+        std::cout << "5. Optimize Database\n";
+
+        int choice = get_int_input("Select option (1-5): ", 1, 5);
+
+        switch (choice) {
+            case 1:
+                // Every change is already in the write-ahead log, so the menu need
+                // not wait for the rewrite
+                if (data_manager.save_in_background(db)) {
+                    std::cout << "\n✓ Checkpoint requested.\n";
+                } else {
+                    std::cout << "\n✗ Save failed.\n";
+                }
+                break;
+
+            case 2: {
+                std::string confirm = get_input("Reload will lose unsaved changes. Continue? (yes/no): ");
+                if (confirm == "yes" || confirm == "YES") {
+                    EmployeeHashTable temp_db(17, db.backend());
+                    if (data_manager.load(temp_db)) {
+                        data_manager.replace_table(db, std::move(temp_db));
+                        std::cout << "\n✓ Data reloaded successfully.\n";
+                    } else {
+                        std::cout << "\n✗ Reload failed.\n";
+                    }
+                } else {
+                    std::cout << "\nOperation cancelled.\n";
+                }
+                break;
+            }
+
+            case 3: {
+                std::string confirm = get_input("This will delete ALL employee data. Type 'DELETE ALL' to confirm: ");
+                if (confirm == "DELETE ALL") {
+                    data_manager.replace_table(db, EmployeeHashTable(17, db.backend()));
+                    data_manager.save(db);  // The log cannot express a wholesale replacement
+                    std::cout << "\n✓ All data cleared.\n";
+                } else {
+                    std::cout << "\nOperation cancelled.\n";
+                }
+                break;
+            }
+
+            case 4:
+                validate_all_data();
+                break;
+
+            case 5:
+                std::cout << "\nOptimizing database...\n";
+                // Force rehash if needed
+                if (db.load_factor() > 0.5) {
+                    std::cout << "Triggering rehash for optimal performance...\n";
+                    // The hash table will rehash automatically on next insert if needed
+                }
+                std::cout << "✓ Database optimization completed.\n";
+                break;
+        }
+
+        pause();
+    }
+
+    void validate_all_data() {
+        std::cout << "\nValidating all employee records...\n";
+
+        auto employees = db.view();
+        int valid_count = 0;
+        int invalid_count = 0;
+
+        for (const auto& emp : employees) {
+            try {
+                emp.validate();
+                valid_count++;
+            } catch (const EmployeeException& e) {
+                invalid_count++;
+                std::cout << "Invalid record - ID: " << emp.id << ", Error: " << e.what() << "\n";
+            }
+        }
+
+        std::cout << "\nValidation Results:\n";
+        std::cout << "  Valid records: " << valid_count << "\n";
+        std::cout << "  Invalid records: " << invalid_count << "\n";
+
+        if (invalid_count == 0) {
+            std::cout << "✓ All records are valid!\n";
+        } else {
+            std::cout << "⚠ Found invalid records. Consider updating or removing them.\n";
         }
     }
 
-    void edit_my_profile() {
+    void help_documentation() {
         clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "       EDIT MY PROFILE\n";
-        std::cout << std::string(40, '=') << "\n";
-        display_employee(*currentUser);
+        std::cout << "\n" << std::string(60, '=') << "\n";
+        std::cout << "              HELP & DOCUMENTATION\n";
+        std::cout << std::string(60, '=') << "\n";
 
-        std::cout << "\nUpdate fields (press Enter to keep current value):\n";
+        std::cout << "EMPLOYEE ID FORMAT:\n";
+        std::cout << "  Must follow pattern: AB1234 (2 letters + 4 digits)\n";
+        std::cout << "  Examples: EM0001, HR0123, IT9999\n\n";
 
-        Employee updated = *currentUser;
+        std::cout << "VALIDATION RULES:\n";
+        std::cout << "  • Names: 2-50 characters, letters, spaces, hyphens, apostrophes\n";
+        std::cout << "  • Position: 2-30 characters, letters, spaces, hyphens\n";
+        std::cout << "  • Salary: Must be between 0 and 10,000,000\n";
+        std::cout << "  • Email: Standard email format (optional)\n";
+        std::cout << "  • Phone: 10-15 digits, optional + prefix\n\n";
 
-        std::string input;
-        
-        input = get_input("First Name [" + updated.firstName + "]: ");
-        if (!input.empty()) updated.firstName = input;
+        std::cout << "SEARCH FEATURES:\n";
+        std::cout << "  • Basic search by exact Employee ID\n";
+        std::cout << "  • Advanced search with multiple criteria\n";
+        std::cout << "  • Partial matching for names and positions\n";
+        std::cout << "  • Salary range filtering\n";
+        std::cout << "  • Department and status filtering\n";
+        std::cout << "  • Skill-based search\n";
+        std::cout << "  • Case-sensitive/insensitive options\n\n";
 
-        input = get_input("Last Name [" + updated.lastName + "]: ");
-        if (!input.empty()) updated.lastName = input;
+        std::cout << "REPORTS AVAILABLE:\n";
+        std::cout << "  • Department Summary: Employee count and salary analysis\n";
+        std::cout << "  • Salary Statistics: Statistical analysis of compensation\n";
+        std::cout << "  • Status Report: Active/inactive employee breakdown\n";
+        std::cout << "  • Skill Analysis: Most common skills across organization\n";
+        std::cout << "  • Management Hierarchy: Organizational structure\n\n";
 
-        input = get_input("Phone [" + updated.phone + "]: ");
-        if (!input.empty()) updated.phone = input;
+        std::cout << "DATA MANAGEMENT:\n";
+        std::cout << "  • Automatic saving on exit\n";
+        std::cout << "  • Manual backup creation with timestamps\n";
+        std::cout << "  • CSV export functionality\n";
+        std::cout << "  • Data validation tools\n";
+        std::cout << "  • System performance optimization\n";
+        std::cout << "  • Added move constructor and move assignment operator for thread-safety and efficiency\n\n";
 
-        input = get_input("Email [" + updated.email + "]: ");
-        if (!input.empty()) updated.email = input;
-        
-        std::cout << "Change skills? (y/n) - Current: ";
-        if (updated.skills.empty()) std::cout << "None\n";
-        else {
-            for (const auto& skill : updated.skills) std::cout << skill << " ";
-            std::cout << "\n";
-        }
-        input = get_input("");
-        if (input == "y" || input == "Y") {
-            updated.skills = get_skills_input();
-        }
+        std::cout << "SYSTEM FEATURES:\n";
+        std::cout << "  • High-performance hash table with automatic resizing\n";
+        std::cout << "  • Thread-safe operations\n";
+        std::cout << "  • Comprehensive error handling and logging\n";
+        std::cout << "  • Input validation and sanitization\n";
+        std::cout << "  • Memory-efficient design\n";
+        std::cout << "  • Production-ready reliability\n\n";
 
-        try {
-            if (db.update(currentUser->id, updated)) {
-                *currentUser = updated; // Update the in-memory user object
-                std::cout << "\n✓ Profile updated successfully!\n";
-                display_employee(*currentUser);
-            } else {
-                std::cout << "\n✗ Failed to update profile.\n";
-            }
-        } catch (const EmployeeException& e) {
-            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
-        }
+        std::cout << "KEYBOARD SHORTCUTS:\n";
+        std::cout << "  • Enter: Continue/Confirm\n";
+        std::cout << "  • Type 'y' or 'yes': Confirm actions\n";
+        std::cout << "  • Type 'n' or 'no': Cancel actions\n";
+        std::cout << "  • Empty input: Keep current value (during updates)\n\n";
+
+        std::cout << "TROUBLESHOOTING:\n";
+        std::cout << "  • Check employee_system.log for detailed error messages\n";
+        std::cout << "  • Use Data Validation to find problematic records\n";
+        std::cout << "  • Create backups before major operations\n";
+        std::cout << "  • Contact system administrator for persistent issues\n";
 
         pause();
     }
+};
 
-    void add_employee() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "         ADD EMPLOYEE\n";
-        std::cout << std::string(40, '=') << "\n";
+// ==================== HEADLESS SERVER ====================
 
-        try {
-            Employee emp;
+// Fixed set of worker threads fed from one queue
+class WorkerPool {
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex queue_mutex;
+    std::condition_variable queue_ready;
+    bool stopping = false;
 
-            emp.id = get_input("Employee ID (format: AB1234): ");
-            emp.firstName = get_input("First Name: ");
-            emp.lastName = get_input("Last Name: ");
-            emp.position = get_input("Position: ");
-            emp.department = get_department_input();
-            emp.salary = get_double_input("Salary: $");
-            emp.email = get_input("Email (optional): ");
-            emp.phone = get_input("Phone (optional): ");
-            emp.managerId = get_input("Manager ID (optional): ");
-            emp.accessLevel = get_access_level_input();
-            emp.skills = get_skills_input();
-            
-            if (db.insert(emp)) {
-                std::cout << "\n✓ Employee added successfully!\n";
-                display_employee(emp);
-            } else {
-                std::cout << "\n✗ Failed to add employee. ID may already exist.\n";
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                queue_ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
             }
-        } catch (const EmployeeException& e) {
-            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
+            task();
         }
-
-        pause();
     }
 
-    void remove_employee() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "       REMOVE EMPLOYEE\n";
-        std::cout << std::string(40, '=') << "\n";
-
-        std::string id = get_input("Enter Employee ID to remove: ");
-
-        Employee* emp = db.find(id);
-        if (emp) {
-            display_employee(*emp);
-            std::string confirm = get_input("\nAre you sure you want to remove this employee? (yes/no): ");
+public:
+    // 0 threads means one per hardware thread
+    explicit WorkerPool(size_t count = 0) {
+        if (count == 0) count = std::max(1u, std::thread::hardware_concurrency());
+        threads.reserve(count);
+        for (size_t i = 0; i < count; ++i) threads.emplace_back([this] { work(); });
+    }
 
-            if (confirm == "yes" || confirm == "YES" || confirm == "y" || confirm == "Y") {
-                if (db.remove(id)) {
-                    std::cout << "\n✓ Employee removed successfully!\n";
-                } else {
-                    std::cout << "\n✗ Failed to remove employee.\n";
-                }
-            } else {
-                std::cout << "\nOperation cancelled.\n";
-            }
-        } else {
-            std::cout << "\n✗ Employee not found.\n";
+    // Tasks already queued still run before the workers exit
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            stopping = true;
         }
-
-        pause();
+        queue_ready.notify_all();
+        for (auto& thread : threads) thread.join();
     }
 
-    void update_employee() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "       UPDATE EMPLOYEE\n";
-        std::cout << std::string(40, '=') << "\n";
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
 
-        std::string id = get_input("Enter Employee ID to update: ");
+    size_t size() const { return threads.size(); }
 
-        Employee* emp = db.find(id);
-        if (!emp) {
-            std::cout << "\n✗ Employee not found.\n";
-            pause();
-            return;
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            tasks.push_back(std::move(task));
         }
+        queue_ready.notify_one();
+    }
 
-        display_employee(*emp);
-
-        std::cout << "\nUpdate fields (press Enter to keep current value):\n";
+    // Calls body(i) for every i in [0, count) on the workers and the calling
+    // thread and returns once every call has finished. The caller claims items
+    // as well, so a task that fans out completes even when every worker is
+    // busy. body must not throw.
+    template <typename Body>
+    void parallel_for(size_t count, Body&& body) {
+        if (count == 0) return;
+        struct Progress {
+            std::atomic<size_t> next{0};
+            size_t finished = 0;
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+
+        // A helper that starts after the last item was claimed touches only
+        // progress, which it keeps alive
+        auto progress = std::make_shared<Progress>();
+        auto drain = [progress, count, &body] {
+            size_t ran = 0;
+            while (true) {
+                size_t i = progress->next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count) break;
+                body(i);
+                ++ran;
+            }
+            if (ran == 0) return;
+            std::lock_guard<std::mutex> lock(progress->mutex);
+            progress->finished += ran;
+            if (progress->finished == count) progress->done.notify_all();
+        };
+
+        size_t helpers = std::min(count, threads.size() + 1) - 1;
+        for (size_t i = 0; i < helpers; ++i) submit(drain);
+        drain();
+        std::unique_lock<std::mutex> lock(progress->mutex);
+        progress->done.wait(lock, [&] { return progress->finished == count; });
+    }
+};
 
-        Employee updated = *emp;
+// One client's end of the headless line protocol, shared by the stdin and
+// socket servers. A request is a command and its arguments on one line, split
+// on spaces; double quotes group words and a backslash escapes the next
+// character. A reply is "OK <n>" followed by n data lines, or one "ERR <message>"
+// line, so a client can send many requests before reading any reply and still
+// split the replies apart. Records travel as Employee::serialize() lines.
+//
+//   LOGIN <id>                    required first; admins may also write
+//   PING | SIZE | REPORT | QUIT
+//   FIND <id>
+//   NAME <query> [limit]          ranked, typo-tolerant, as Find Employee
+//   SEARCH|COUNT [key=value ...]  id first last position department status
+//                                 min max skill case limit
+//   INSERT|UPDATE <record>        admin only
+//   REMOVE <id>                   admin only
+//   BEGIN | COMMIT | ABORT        admin only; writes in between are queued and
+//                                 COMMIT applies them all or none
+//   SET key=value ... WHERE [key=value ...]
+//                                 admin only; manager department position
+//                                 status, for every record SEARCH would match
+class ProtocolSession {
+private:
+    // Read-only runs shorter than this are not worth a hand-off to the pool
+    static constexpr size_t PARALLEL_MIN_REQUESTS = 64;
+    static constexpr size_t REQUESTS_PER_TASK = 32;
+    static constexpr size_t DEFAULT_NAME_MATCHES = 20;
+
+    EmployeeHashTable& table;
+    WorkerPool& pool;
+    std::optional<AccessLevel> access;  // Set by LOGIN
+    std::optional<MutationBatch> pending;  // Open between BEGIN and COMMIT or ABORT
+    bool quit = false;
+
+    static constexpr const char* DEPARTMENTS[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales",
+                                                  "Unknown"};
+    static constexpr const char* STATUSES[] = {"Active", "Inactive", "On Leave", "Terminated"};
+
+    static std::string command_of(std::string_view request) {
+        std::string command(request.substr(0, request.find(' ')));
+        for (char& c : command) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return command;
+    }
 
-        std::string input = get_input("First Name [" + emp->firstName + "]: ");
-        if (!input.empty()) updated.firstName = input;
+    // Requests that write the table or change the session run alone, after
+    // every request before them
+    static bool is_barrier(std::string_view request) {
+        std::string command = command_of(request);
+        return command == "LOGIN" || command == "INSERT" || command == "UPDATE" || command == "REMOVE" ||
+               command == "BEGIN" || command == "COMMIT" || command == "ABORT" || command == "SET" ||
+               command == "QUIT";
+    }
 
-        input = get_input("Last Name [" + emp->lastName + "]: ");
-        if (!input.empty()) updated.lastName = input;
+    static std::vector<std::string> arguments(std::string_view text) {
+        std::vector<std::string> args;
+        std::string current;
+        bool in_token = false;
+        bool quoted = false;
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if (c == '\\' && i + 1 < text.size()) {
+                current.push_back(text[++i]);
+                in_token = true;
+            } else if (c == '"') {
+                quoted = !quoted;
+                in_token = true;
+            } else if ((c == ' ' || c == '\t') && !quoted) {
+                if (in_token) args.push_back(std::move(current));
+                current.clear();
+                in_token = false;
+            } else {
+                current.push_back(c);
+                in_token = true;
+            }
+        }
+        if (quoted) throw EmployeeException("Unterminated quote");
+        if (in_token) args.push_back(std::move(current));
+        return args;
+    }
 
-        input = get_input("Position [" + emp->position + "]: ");
-        if (!input.empty()) updated.position = input;
+    static bool equals_folded(std::string_view a, std::string_view b) {
+        return a.size() == b.size() && TextMatcher::fold_copy(a) == TextMatcher::fold_copy(b);
+    }
 
-        std::cout << "Department [" << emp->getDepartmentString() << "] - Change? (y/n): ";
-        std::getline(std::cin, input);
-        if (input == "y" || input == "Y") {
-            updated.department = get_department_input();
+    // A choice by its number in the record format or by its display name
+    template <size_t N>
+    static size_t parse_choice(const std::string& value, const char* const (&names)[N], const std::string& key) {
+        size_t index = 0;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), index);
+        if (error == std::errc() && end == value.data() + value.size() && index < N) return index;
+        for (size_t i = 0; i < N; ++i) {
+            if (equals_folded(value, names[i])) return i;
         }
+        throw EmployeeException("Unknown " + key + ": " + value);
+    }
 
-        input = get_input("Salary [$" + std::to_string(emp->salary) + "]: ");
-        if (!input.empty()) {
-            try {
-                updated.salary = std::stod(input);
-            } catch (const std::exception&) {
-                std::cout << "Invalid salary, keeping current value.\n";
-            }
+    static size_t parse_count(const std::string& value, const std::string& key) {
+        size_t count = 0;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+        if (error != std::errc() || end != value.data() + value.size()) {
+            throw EmployeeException("Invalid " + key + ": " + value);
         }
+        return count;
+    }
 
-        input = get_input("Email [" + emp->email + "]: ");
-        if (!input.empty()) updated.email = input;
-
-        input = get_input("Phone [" + emp->phone + "]: ");
-        if (!input.empty()) updated.phone = input;
+    static double parse_amount(const std::string& value, const std::string& key) {
+        char* end = nullptr;
+        errno = 0;
+        double amount = std::strtod(value.c_str(), &end);
+        if (value.empty() || *end != '\0' || errno == ERANGE) throw EmployeeException("Invalid " + key + ": " + value);
+        return amount;
+    }
 
-        input = get_input("Manager ID [" + emp->managerId + "]: ");
-        if (!input.empty()) updated.managerId = input;
+    static std::pair<std::string, std::string> split_pair(const std::string& arg) {
+        size_t equals = arg.find('=');
+        if (equals == std::string::npos) throw EmployeeException("Expected key=value, got " + arg);
+        return {arg.substr(0, equals), arg.substr(equals + 1)};
+    }
 
-        std::cout << "Status [" << emp->getStatusString() << "] - Change? (y/n): ";
-        std::getline(std::cin, input);
-        if (input == "y" || input == "Y") {
-            updated.status = get_status_input();
-        }
-        
-        std::cout << "Access Level [" << emp->getAccessLevelString() << "] - Change? (y/n): ";
-        std::getline(std::cin, input);
-        if (input == "y" || input == "Y") {
-            updated.accessLevel = get_access_level_input();
+    static SearchCriteria parse_criteria(std::vector<std::string>::const_iterator first,
+                                         std::vector<std::string>::const_iterator last) {
+        SearchCriteria criteria;
+        for (; first != last; ++first) {
+            auto [key, value] = split_pair(*first);
+            if (key == "id") {
+                criteria.id = value;
+            } else if (key == "first") {
+                criteria.firstName = value;
+            } else if (key == "last") {
+                criteria.lastName = value;
+            } else if (key == "position") {
+                criteria.position = value;
+            } else if (key == "department") {
+                criteria.department = static_cast<Department>(parse_choice(value, DEPARTMENTS, key));
+            } else if (key == "status") {
+                criteria.status = static_cast<EmployeeStatus>(parse_choice(value, STATUSES, key));
+            } else if (key == "min") {
+                criteria.minSalary = parse_amount(value, key);
+            } else if (key == "max") {
+                criteria.maxSalary = parse_amount(value, key);
+            } else if (key == "skill") {
+                criteria.skill = value;
+            } else if (key == "case") {
+                criteria.caseSensitive = value == "1" || equals_folded(value, "yes") || equals_folded(value, "true");
+            } else if (key == "limit") {
+                criteria.limit = parse_count(value, key);
+            } else {
+                throw EmployeeException("Unknown search key: " + key);
+            }
         }
+        return criteria;
+    }
 
-        try {
-            if (db.update(id, updated)) {
-                std::cout << "\n✓ Employee updated successfully!\n";
-                display_employee(updated);
+    static SearchCriteria parse_criteria(const std::vector<std::string>& args) {
+        return parse_criteria(args.begin(), args.end());
+    }
+
+    static FieldChanges parse_changes(std::vector<std::string>::const_iterator first,
+                                      std::vector<std::string>::const_iterator last) {
+        FieldChanges changes;
+        for (; first != last; ++first) {
+            auto [key, value] = split_pair(*first);
+            if (key == "manager") {
+                changes.managerId = value;
+            } else if (key == "department") {
+                changes.department = static_cast<Department>(parse_choice(value, DEPARTMENTS, key));
+            } else if (key == "position") {
+                changes.position = value;
+            } else if (key == "status") {
+                changes.status = static_cast<EmployeeStatus>(parse_choice(value, STATUSES, key));
             } else {
-                std::cout << "\n✗ Failed to update employee.\n";
+                throw EmployeeException("Unknown field to set: " + key);
             }
-        } catch (const EmployeeException& e) {
-            std::cout << "\n✗ Validation Error: " << e.what() << "\n";
         }
-
-        pause();
+        if (changes.empty()) throw EmployeeException("Usage: SET key=value ... WHERE [key=value ...]");
+        return changes;
     }
 
-    void find_employee() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "        FIND EMPLOYEE\n";
-        std::cout << std::string(40, '=') << "\n";
+    static void begin_reply(std::string& out, size_t lines) {
+        out.append("OK ").append(std::to_string(lines)).push_back('\n');
+    }
 
-        std::string id = get_input("Enter Employee ID: ");
+    static void append_line(std::string& out, std::string_view line) { out.append(line).push_back('\n'); }
 
-        Employee* emp = db.find(id);
-        if (emp) {
-            display_employee(*emp);
-        } else {
-            std::cout << "\n✗ Employee not found.\n";
-        }
+    static void append_error(std::string& out, std::string_view message) {
+        out.append("ERR ");
+        for (char c : message) out.push_back(c == '\n' || c == '\r' ? ' ' : c);
+        out.push_back('\n');
+    }
 
-        pause();
+    static void append_records(std::string& out, const std::vector<Employee>& employees) {
+        begin_reply(out, employees.size());
+        for (const auto& emp : employees) append_line(out, emp.serialize());
     }
-    void advanced_search() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "      ADVANCED SEARCH\n";
-        std::cout << std::string(40, '=') << "\n";
 
-        SearchCriteria criteria;
-        std::string input;
+    static void append_report(std::string& out, const ReportSummary& summary) {
+        std::vector<std::string> lines;
+        auto add = [&](const std::string& key, const auto& value) {
+            std::ostringstream line;
+            line << std::fixed << std::setprecision(2) << key << " " << value;
+            lines.push_back(line.str());
+        };
+        add("employees", summary.employee_count);
+        add("total_salary", summary.total_salary);
+        add("min_salary", summary.min_salary);
+        add("max_salary", summary.max_salary);
+        add("median_salary", summary.median_salary);
+        for (size_t i = 0; i < ReportSummary::DEPARTMENTS; ++i) {
+            add(std::string("department \"") + DEPARTMENTS[i] + "\"", summary.department_count[i]);
+        }
+        for (size_t i = 0; i < ReportSummary::STATUSES; ++i) {
+            add(std::string("status \"") + STATUSES[i] + "\"", summary.status_count[i]);
+        }
+        add("distinct_skills", summary.distinct_skills);
+        for (const auto& [skill, count] : summary.top_skills) add("skill \"" + skill + "\"", count);
 
-        input = get_input("First Name (partial match): ");
-        if (!input.empty()) criteria.firstName = input;
+        begin_reply(out, lines.size());
+        for (const auto& line : lines) append_line(out, line);
+    }
 
-        input = get_input("Last Name (partial match): ");
-        if (!input.empty()) criteria.lastName = input;
+    void require_admin() const {
+        if (access != AccessLevel::ADMIN) throw EmployeeException("Admin access required");
+    }
 
-        input = get_input("Position (partial match): ");
-        if (!input.empty()) criteria.position = input;
+    void dispatch(const std::string& command, std::string_view rest, std::string& out) {
+        if (command == "PING") {
+            begin_reply(out, 0);
+        } else if (command == "QUIT") {
+            quit = true;
+            begin_reply(out, 0);
+        } else if (command == "LOGIN") {
+            auto args = arguments(rest);
+            auto emp = args.size() == 1 ? table.snapshot(args[0]) : nullptr;
+            if (!emp) throw EmployeeException("Employee ID not found");
+            access = emp->accessLevel;
+            begin_reply(out, 1);
+            append_line(out, emp->getFullName() + " (" + emp->getAccessLevelString() + ")");
+        } else if (!access) {
+            throw EmployeeException("LOGIN required");
+        } else if (command == "FIND") {
+            auto args = arguments(rest);
+            auto emp = args.size() == 1 ? table.snapshot(args[0]) : nullptr;
+            if (!emp) throw EmployeeException("Employee not found");
+            begin_reply(out, 1);
+            append_line(out, emp->serialize());
+        } else if (command == "NAME") {
+            auto args = arguments(rest);
+            if (args.empty() || args.size() > 2) throw EmployeeException("Usage: NAME <query> [limit]");
+            size_t limit = args.size() == 2 ? parse_count(args[1], "limit") : DEFAULT_NAME_MATCHES;
+            auto matches = table.find_by_name(args[0], limit);
+            begin_reply(out, matches.size());
+            for (const auto& match : matches) append_line(out, match.employee.serialize());
+        } else if (command == "SEARCH") {
+            append_records(out, table.search(parse_criteria(arguments(rest))));
+        } else if (command == "COUNT") {
+            size_t matched = table.count(parse_criteria(arguments(rest)));
+            begin_reply(out, 1);
+            append_line(out, std::to_string(matched));
+        } else if (command == "SIZE") {
+            begin_reply(out, 1);
+            append_line(out, std::to_string(table.size()));
+        } else if (command == "REPORT") {
+            append_report(out, ReportEngine::summarize(table.view()));
+        } else if (command == "INSERT") {
+            require_admin();
+            Employee emp = Employee::deserialize(rest);
+            if (pending) {
+                pending->insert(std::move(emp));
+            } else if (!table.insert(std::move(emp))) {
+                throw EmployeeException("Employee ID already exists");
+            }
+            begin_reply(out, 0);
+        } else if (command == "UPDATE") {
+            require_admin();
+            Employee emp = Employee::deserialize(rest);
+            if (pending) {
+                std::string id = emp.id;
+                pending->update(id, std::move(emp));
+            } else if (!table.update(emp.id, emp)) {
+                throw EmployeeException("Employee not found");
+            }
+            begin_reply(out, 0);
+        } else if (command == "REMOVE") {
+            require_admin();
+            auto args = arguments(rest);
+            if (args.size() != 1) throw EmployeeException("Usage: REMOVE <id>");
+            if (pending) {
+                pending->remove(args[0]);
+            } else if (!table.remove(args[0])) {
+                throw EmployeeException("Employee not found");
+            }
+            begin_reply(out, 0);
+        } else if (command == "BEGIN") {
+            require_admin();
+            if (pending) throw EmployeeException("Transaction already open");
+            pending.emplace();
+            begin_reply(out, 0);
+        } else if (command == "COMMIT") {
+            require_admin();
+            if (!pending) throw EmployeeException("No open transaction");
+            MutationBatch batch = std::move(*pending);
+            pending.reset();
+            auto result = table.apply(std::move(batch));
+            begin_reply(out, 3);
+            append_line(out, "inserted " + std::to_string(result.inserted));
+            append_line(out, "updated " + std::to_string(result.updated));
+            append_line(out, "removed " + std::to_string(result.removed));
+        } else if (command == "ABORT") {
+            require_admin();
+            if (!pending) throw EmployeeException("No open transaction");
+            pending.reset();
+            begin_reply(out, 0);
+        } else if (command == "SET") {
+            require_admin();
+            auto args = arguments(rest);
+            auto where = std::find_if(args.begin(), args.end(), [](const std::string& arg) {
+                return equals_folded(arg, "WHERE");
+            });
+            if (where == args.end()) throw EmployeeException("Usage: SET key=value ... WHERE [key=value ...]");
+            FieldChanges changes = parse_changes(args.begin(), where);
+            size_t changed = table.update_where(parse_criteria(where + 1, args.end()), changes);
+            begin_reply(out, 1);
+            append_line(out, std::to_string(changed));
+        } else {
+            throw EmployeeException("Unknown command: " + command);
+        }
+    }
 
-        std::cout << "Filter by Department? (y/n): ";
-        std::getline(std::cin, input);
-        if (input == "y" || input == "Y") {
-            criteria.department = get_department_input();
+    void execute(std::string_view request, std::string& out) {
+        Metrics::Timer timer(Metrics::server_request_latency);
+        Metrics::server_requests.add();
+        size_t space = request.find(' ');
+        std::string_view rest = space == std::string_view::npos ? std::string_view() : request.substr(space + 1);
+        try {
+            dispatch(command_of(request), rest, out);
+        } catch (const std::exception& e) {
+            append_error(out, e.what());
         }
+    }
 
-        input = get_input("Minimum Salary (optional): ");
-        if (!input.empty()) {
-            try {
-                criteria.minSalary = std::stod(input);
-            } catch (const std::exception&) {
-                std::cout << "Invalid salary format.\n";
-            }
+public:
+    ProtocolSession(EmployeeHashTable& database, WorkerPool& workers) : table(database), pool(workers) {}
+
+    // True once QUIT was read; later requests in the same batch are dropped
+    bool closed() const { return quit; }
+
+    // Runs every request in batch, one per line (blank lines are skipped and
+    // the last line may lack its newline), and appends the replies to out in
+    // request order. Consecutive read-only requests are spread over the pool;
+    // a request that writes the table or changes the session runs only after
+    // every request before it.
+    void execute_batch(std::string_view batch, std::string& out) {
+        Metrics::server_batches.add();
+        std::vector<std::string_view> requests;
+        for (size_t start = 0; start < batch.size();) {
+            size_t end = std::min(batch.find('\n', start), batch.size());
+            std::string_view line = batch.substr(start, end - start);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) requests.push_back(line);
+            start = end + 1;
         }
 
-        input = get_input("Maximum Salary (optional): ");
-        if (!input.empty()) {
-            try {
-                criteria.maxSalary = std::stod(input);
-            } catch (const std::exception&) {
-                std::cout << "Invalid salary format.\n";
+        for (size_t first = 0; first < requests.size() && !quit;) {
+            if (is_barrier(requests[first])) {
+                execute(requests[first++], out);
+                continue;
             }
-        }
+            size_t last = first;
+            while (last < requests.size() && !is_barrier(requests[last])) ++last;
 
-        std::cout << "Filter by Status? (y/n): ";
-        std::getline(std::cin, input);
-        if (input == "y" || input == "Y") {
-            criteria.status = get_status_input();
+            size_t run = last - first;
+            if (run < PARALLEL_MIN_REQUESTS || pool.size() < 2) {
+                for (size_t i = first; i < last; ++i) execute(requests[i], out);
+            } else {
+                size_t tasks = (run + REQUESTS_PER_TASK - 1) / REQUESTS_PER_TASK;
+                std::vector<std::string> replies(tasks);
+                pool.parallel_for(tasks, [&](size_t task) {
+                    size_t begin = first + task * REQUESTS_PER_TASK;
+                    size_t end = std::min(last, begin + REQUESTS_PER_TASK);
+                    for (size_t i = begin; i < end; ++i) execute(requests[i], replies[task]);
+                });
+                for (const auto& reply : replies) out += reply;
+            }
+            first = last;
         }
+    }
+};
 
-        input = get_input("Skill (partial match): ");
-        if (!input.empty()) criteria.skill = input;
+#ifndef _WIN32
+// Serves the protocol on a pair of descriptors (stdin/stdout) or on a TCP
+// socket. For sockets one poll() loop owns every connection: it reads whatever
+// each client has sent and hands the complete lines to the pool as one batch,
+// whose replies go back in one write. A connection has at most one batch in
+// flight, so its replies stay in order, and is not polled meanwhile, so further
+// requests wait in the kernel buffer. Different connections run concurrently.
+class ProtocolServer {
+private:
+    static constexpr size_t READ_CHUNK = 64 * 1024;
+    // An unterminated line longer than this ends the connection
+    static constexpr size_t MAX_PENDING_BYTES = 1 << 20;
+    static constexpr int POLL_INTERVAL_MS = 250;
+    // A reply write that makes no progress for this long ends the connection, so
+    // a client that stops reading cannot pin a worker or hold up shutdown
+    static constexpr int SEND_TIMEOUT_SECONDS = 5;
+
+    struct Connection {
+        int fd;
+        ProtocolSession session;
+        std::string pending;
+        bool busy = false;
+        bool eof = false;
+
+        Connection(int socket, EmployeeHashTable& table, WorkerPool& pool) : fd(socket), session(table, pool) {}
+    };
 
-        std::cout << "Case sensitive search? (y/n): ";
-        std::getline(std::cin, input);
-        criteria.caseSensitive = (input == "y" || input == "Y");
+    EmployeeHashTable& table;
 
-        auto results = db.search(criteria);
+    // Batches that finished since the loop last looked, and whether each one
+    // ended its connection
+    std::mutex finished_mutex;
+    std::vector<std::pair<Connection*, bool>> finished;
+    int wake_pipe[2] = {-1, -1};
 
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "Search Results (" << results.size() << " found)\n";
-        std::cout << std::string(40, '=') << "\n";
+    // Last, so the workers are joined before anything they touch goes away
+    WorkerPool pool;
 
-        display_employees_table(results);
+    static volatile std::sig_atomic_t stop_signal;
 
-        pause();
-    }
+    static void on_stop_signal(int) { stop_signal = 1; }
 
-    void display_all_employees() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "      ALL EMPLOYEES\n";
-        std::cout << std::string(40, '=') << "\n";
+    // Without SA_RESTART a blocked read() or poll() returns EINTR, so the
+    // loops notice the signal promptly
+    static void install_signal_handlers() {
+        struct sigaction action {};
+        action.sa_handler = on_stop_signal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::signal(SIGPIPE, SIG_IGN);
+    }
 
-        auto employees = db.get_all();
+    // Fails on a send timeout as on any other error
+    static bool write_all(int fd, std::string_view data) {
+        while (!data.empty()) {
+            ssize_t written = ::write(fd, data.data(), data.size());
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            data.remove_prefix(static_cast<size_t>(written));
+        }
+        return true;
+    }
 
-        // Sort by ID for consistent display
-        std::sort(employees.begin(), employees.end(),
-                 [](const Employee& a, const Employee& b) {
-                     return a.id < b.id;
-                 });
+    // LOGIN only checks the ID and the default admin's is well known, so other
+    // hosts can only be served when allow_remote is set
+    static int open_listener(const std::string& address, bool allow_remote) {
+        std::string host = "127.0.0.1";
+        std::string port = address;
+        size_t colon = address.rfind(':');
+        if (colon != std::string::npos) {
+            host = address.substr(0, colon);
+            port = address.substr(colon + 1);
+        }
 
-        display_employees_table(employees);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        unsigned port_number = 0;
+        auto [end, error] = std::from_chars(port.data(), port.data() + port.size(), port_number);
+        if (error != std::errc() || end != port.data() + port.size() || port_number > 65535 ||
+            inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+            throw EmployeeException("Invalid listen address: " + address + " (expected [IPv4:]port)");
+        }
+        addr.sin_port = htons(static_cast<uint16_t>(port_number));
+        if ((ntohl(addr.sin_addr.s_addr) >> 24) != 127) {
+            if (!allow_remote) {
+                throw EmployeeException("Refusing to listen on non-loopback address " + address +
+                                        ": anyone who can connect may log in as the default admin"
+                                        " (pass --allow-remote to listen anyway)");
+            }
+            Logger::log(Logger::WARNING, "Listening on non-loopback address ", address,
+                        "; LOGIN does not authenticate clients");
+        }
 
-        pause();
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int enable = 1;
+        if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+            ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, SOMAXCONN) != 0 ||
+            fcntl(fd, F_SETFL, O_NONBLOCK) != 0) {
+            std::string reason = std::strerror(errno);
+            if (fd >= 0) ::close(fd);
+            throw EmployeeException("Cannot listen on " + address + ": " + reason);
+        }
+        return fd;
     }
 
-    void generate_reports() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "        REPORTS\n";
-        std::cout << std::string(40, '=') << "\n";
-        std::cout << "1. Department Summary\n";
-        std::cout << "2. Salary Statistics\n";
-        std::cout << "3. Employee Status Report\n";
-        std::cout << "4. Skill Analysis\n";
-        std::cout << "5. Management Hierarchy\n";
+    static uint16_t bound_port(int fd) {
+        sockaddr_in addr{};
+        socklen_t length = sizeof(addr);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+        return ntohs(addr.sin_port);
+    }
 
-        int choice = get_int_input("Select report (1-5): ", 1, 5);
+    // Takes the complete lines off pending (everything at end of input) and
+    // queues them. Returns false when the connection should close instead.
+    bool dispatch(Connection& conn) {
+        size_t end = conn.eof ? conn.pending.size() : conn.pending.rfind('\n');
+        if (end == std::string::npos || end == 0) {
+            if (conn.eof) return false;
+            if (conn.pending.size() <= MAX_PENDING_BYTES) return true;
+            write_all(conn.fd, "ERR Request line too long\n");
+            return false;
+        }
+        if (!conn.eof) ++end;
+
+        std::string batch = conn.pending.substr(0, end);
+        conn.pending.erase(0, end);
+        conn.busy = true;
+        pool.submit([this, &conn, batch = std::move(batch)] {
+            std::string out;
+            conn.session.execute_batch(batch, out);
+            bool done = !write_all(conn.fd, out) || conn.session.closed() || conn.eof;
+            {
+                std::lock_guard<std::mutex> lock(finished_mutex);
+                finished.emplace_back(&conn, done);
+            }
+            char wake = 1;
+            while (::write(wake_pipe[1], &wake, 1) < 0 && errno == EINTR) {}
+        });
+        return true;
+    }
 
-        auto employees = db.get_all();
+    // Hands back connections whose batch finished; returns those that are done
+    std::vector<Connection*> collect_finished() {
+        char drain[256];
+        while (::read(wake_pipe[0], drain, sizeof(drain)) > 0) {}
 
-        switch (choice) {
-            case 1: generate_department_report(employees); break;
-            case 2: generate_salary_report(employees); break;
-            case 3: generate_status_report(employees); break;
-            case 4: generate_skills_report(employees); break;
-            case 5: generate_hierarchy_report(employees); break;
+        std::vector<std::pair<Connection*, bool>> batch;
+        {
+            std::lock_guard<std::mutex> lock(finished_mutex);
+            batch.swap(finished);
         }
-
-        pause();
+        std::vector<Connection*> done;
+        for (auto [conn, closing] : batch) {
+            conn->busy = false;
+            if (closing) done.push_back(conn);
+        }
+        return done;
     }
 
-    void generate_department_report(const std::vector<Employee>& employees) {
-        std::unordered_map<Department, std::vector<Employee>> dept_map;
-
-        for (const auto& emp : employees) {
-            dept_map[emp.department].push_back(emp);
+public:
+    // 0 threads means one per hardware thread
+    ProtocolServer(EmployeeHashTable& database, size_t threads) : table(database), pool(threads) {}
+
+    // Serves one client until end of input or QUIT, one batch per read
+    void serve_stream(int in_fd, int out_fd) {
+        install_signal_handlers();
+        ProtocolSession session(table, pool);
+        std::string pending;
+        std::string out;
+        std::vector<char> buffer(READ_CHUNK);
+        while (!session.closed() && !stop_signal) {
+            ssize_t n = ::read(in_fd, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            pending.append(buffer.data(), static_cast<size_t>(n));
+
+            size_t end = pending.rfind('\n');
+            if (end == std::string::npos) continue;
+            out.clear();
+            session.execute_batch(std::string_view(pending).substr(0, end + 1), out);
+            pending.erase(0, end + 1);
+            if (!write_all(out_fd, out)) return;
         }
+        if (!pending.empty() && !session.closed() && !stop_signal) {
+            out.clear();
+            session.execute_batch(pending, out);
+            write_all(out_fd, out);
+        }
+    }
 
-        std::cout << "\n" << std::string(60, '=') << "\n";
-        std::cout << "              DEPARTMENT SUMMARY\n";
-        std::cout << std::string(60, '=') << "\n";
+    // Accepts clients on address ("port" or "IPv4:port", loopback when no host
+    // is given) until SIGINT or SIGTERM, then finishes the batches in flight.
+    // Hosts outside 127.0.0.0/8 need allow_remote.
+    void listen(const std::string& address, bool allow_remote = false) {
+        install_signal_handlers();
+        int listener = open_listener(address, allow_remote);
+        if (::pipe(wake_pipe) != 0) {
+            ::close(listener);
+            throw EmployeeException("Cannot create wake pipe: " + std::string(std::strerror(errno)));
+        }
+        fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(wake_pipe[1], F_SETFL, O_NONBLOCK);
+        size_t colon = address.rfind(':');
+        std::string host = colon == std::string::npos ? "127.0.0.1" : address.substr(0, colon);
+        std::cout << "Listening on " << host << ":" << bound_port(listener) << std::endl;
+        Logger::log(Logger::INFO, "Protocol server listening on ", address, " with ",
+                    std::to_string(pool.size()), " workers");
+
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        auto close_connection = [&](Connection* conn) {
+            int fd = conn->fd;
+            ::close(fd);
+            connections.erase(fd);
+        };
+
+        std::vector<pollfd> polled;
+        while (!stop_signal) {
+            polled.clear();
+            polled.push_back({listener, POLLIN, 0});
+            polled.push_back({wake_pipe[0], POLLIN, 0});
+            for (const auto& [fd, conn] : connections) {
+                if (!conn->busy) polled.push_back({fd, POLLIN, 0});
+            }
+            if (::poll(polled.data(), polled.size(), POLL_INTERVAL_MS) < 0) {
+                if (errno == EINTR) continue;
+                throw EmployeeException("poll failed: " + std::string(std::strerror(errno)));
+            }
 
-        for (const auto& [dept, dept_employees] : dept_map) {
-            double total_salary = 0;
-            double avg_salary = 0;
+            // Reads come first, so a descriptor that accept() reuses below never
+            // sees revents meant for the connection it replaced
+            std::vector<char> buffer(READ_CHUNK);
+            for (size_t i = 2; i < polled.size(); ++i) {
+                if (!polled[i].revents) continue;
+                auto it = connections.find(polled[i].fd);
+                if (it == connections.end()) continue;
+                Connection& conn = *it->second;
+
+                ssize_t n = ::recv(conn.fd, buffer.data(), buffer.size(), 0);
+                if (n < 0 && errno == EINTR) continue;
+                if (n > 0) {
+                    conn.pending.append(buffer.data(), static_cast<size_t>(n));
+                } else {
+                    conn.eof = true;
+                }
+                if (!dispatch(conn)) close_connection(&conn);
+            }
 
-            for (const auto& emp : dept_employees) {
-                total_salary += emp.salary;
+            for (Connection* conn : collect_finished()) close_connection(conn);
+
+            if (polled[0].revents & POLLIN) {
+                while (true) {
+                    int fd = ::accept(listener, nullptr, nullptr);
+                    if (fd < 0) break;
+                    int enable = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                    timeval send_timeout{SEND_TIMEOUT_SECONDS, 0};
+                    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+                    connections.emplace(fd, std::make_unique<Connection>(fd, table, pool));
+                }
             }
+        }
 
-            if (!dept_employees.empty()) {
-                avg_salary = total_salary / dept_employees.size();
+        ::close(listener);
+        Logger::log(Logger::INFO, "Protocol server stopping, ", std::to_string(connections.size()),
+                    " connections open");
+        // Workers still hold references to busy connections
+        auto any_busy = [&] {
+            for (const auto& entry : connections) {
+                if (entry.second->busy) return true;
             }
+            return false;
+        };
+        while (any_busy()) {
+            pollfd wake{wake_pipe[0], POLLIN, 0};
+            ::poll(&wake, 1, POLL_INTERVAL_MS);
+            collect_finished();
+        }
+        for (const auto& entry : connections) ::close(entry.first);
+        ::close(wake_pipe[0]);
+        ::close(wake_pipe[1]);
+    }
+};
 
-            const char* dept_names[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
+volatile std::sig_atomic_t ProtocolServer::stop_signal = 0;
+#endif
 
-            std::cout << "\n" << dept_names[static_cast<int>(dept)] << ":\n";
-            std::cout << "  Employees: " << dept_employees.size() << "\n";
-            std::cout << "  Total Salary Budget: $" << std::fixed << std::setprecision(2) << total_salary << "\n";
-            std::cout << "  Average Salary: $" << std::fixed << std::setprecision(2) << avg_salary << "\n";
+// ==================== SHARDING ====================
+
+// Consistent-hash ring over shard numbers. IDs are placed by their FNV-1a hash
+// and each shard owns VIRTUAL_NODES points, so shards hold within about ten
+// percent of an equal share. A shard's points do not depend on how many shards there
+// are, so going from N to M shards only moves the IDs that belong to the shards
+// added or removed. The mapping is deterministic, so separate processes that
+// build the same ring route every ID to the same shard.
+class ShardRing {
+public:
+    static constexpr size_t VIRTUAL_NODES = 128;
+
+    explicit ShardRing(size_t shards) : shard_count(shards) {
+        if (shards == 0) throw EmployeeException("A table needs at least one shard");
+        points.reserve(shards * VIRTUAL_NODES);
+        for (uint32_t shard = 0; shard < shards; ++shard) {
+            for (size_t node = 0; node < VIRTUAL_NODES; ++node) {
+                points.push_back({position("shard-" + std::to_string(shard) + "-" + std::to_string(node)), shard});
+            }
         }
+        std::sort(points.begin(), points.end());
     }
 
-    void generate_salary_report(const std::vector<Employee>& employees) {
-        if (employees.empty()) {
-            std::cout << "\nNo employees to analyze.\n";
-            return;
-        }
+    size_t shards() const { return shard_count; }
 
-        std::vector<double> salaries;
-        double total = 0;
+    // The first point clockwise from the ID's position
+    size_t owner(std::string_view id) const {
+        uint64_t at = position(id);
+        auto it = std::upper_bound(points.begin(), points.end(), Point{at, UINT32_MAX});
+        return (it == points.end() ? points.front() : *it).shard;
+    }
 
-        for (const auto& emp : employees) {
-            salaries.push_back(emp.salary);
-            total += emp.salary;
-        }
+private:
+    struct Point {
+        uint64_t position;
+        uint32_t shard;
 
-        std::sort(salaries.begin(), salaries.end());
+        bool operator<(const Point& other) const {
+            return std::tie(position, shard) < std::tie(other.position, other.shard);
+        }
+    };
 
-        double average = total / employees.size();
-        double median = salaries.size() % 2 == 0 ?
-            (salaries[salaries.size()/2 - 1] + salaries[salaries.size()/2]) / 2 :
-            salaries[salaries.size()/2];
+    size_t shard_count;
+    std::vector<Point> points;
 
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "           SALARY STATISTICS\n";
-        std::cout << std::string(50, '=') << "\n";
-        std::cout << "Total Employees: " << employees.size() << "\n";
-        std::cout << "Total Payroll: $" << std::fixed << std::setprecision(2) << total << "\n";
-        std::cout << "Average Salary: $" << std::fixed << std::setprecision(2) << average << "\n";
-        std::cout << "Median Salary: $" << std::fixed << std::setprecision(2) << median << "\n";
-        std::cout << "Minimum Salary: $" << std::fixed << std::setprecision(2) << salaries.front() << "\n";
-        std::cout << "Maximum Salary: $" << std::fixed << std::setprecision(2) << salaries.back() << "\n";
+    // FNV-1a leaves keys that differ only in their last characters close
+    // together; the splitmix64 finalizer spreads them around the ring
+    static uint64_t position(std::string_view key) {
+        uint64_t h = static_cast<uint64_t>(fnv1a_hash(key));
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+};
 
-        // Salary ranges
-        int ranges[] = {30000, 50000, 75000, 100000, 150000};
-        std::string range_labels[] = {"<$30K", "$30K-50K", "$50K-75K", "$75K-100K", "$100K-150K", ">$150K"};
-        int counts[6] = {0};
+// Employees partitioned over several EmployeeHashTables by ShardRing. Point
+// operations go straight to the owning shard; searches, counts, pages, name
+// lookups and aggregates run on every shard at once through the pool and are
+// merged. Each shard answers from its own consistent state, so a fan-out sees
+// every shard at a slightly different moment. resize() blocks all operations
+// while it moves records.
+class ShardedTable {
+public:
+    ShardedTable(size_t shard_count, WorkerPool& pool, StorageBackend backend = StorageBackend::CHAINED)
+        : ring(shard_count), pool(pool), storage(backend) {
+        for (size_t i = 0; i < shard_count; ++i) shards.push_back(std::make_unique<EmployeeHashTable>(17, backend));
+    }
 
-        for (double salary : salaries) {
-            if (salary < ranges[0]) counts[0]++;
-            else if (salary < ranges[1]) counts[1]++;
-            else if (salary < ranges[2]) counts[2]++;
-            else if (salary < ranges[3]) counts[3]++;
-            else if (salary < ranges[4]) counts[4]++;
-            else counts[5]++;
-        }
+    ShardedTable(const ShardedTable&) = delete;
+    ShardedTable& operator=(const ShardedTable&) = delete;
 
-        std::cout << "\nSalary Distribution:\n";
-        for (int i = 0; i < 6; i++) {
-            std::cout << "  " << std::left << std::setw(12) << range_labels[i]
-                      << ": " << counts[i] << " ("
-                      << std::fixed << std::setprecision(1)
-                      << (100.0 * counts[i] / employees.size()) << "%)\n";
-        }
+    size_t shard_count() const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return shards.size();
     }
 
-    void generate_status_report(const std::vector<Employee>& employees) {
-        std::unordered_map<EmployeeStatus, int> status_count;
+    size_t shard_of(const std::string& id) const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return ring.owner(id);
+    }
 
-        for (const auto& emp : employees) {
-            status_count[emp.status]++;
-        }
+    bool insert(const Employee& emp) {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return owner(emp.id).insert(emp);
+    }
 
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "       EMPLOYEE STATUS\n";
-        std::cout << std::string(40, '=') << "\n";
+    // The ID cannot change, since that could move the record to another shard
+    bool update(const std::string& id, const Employee& updated_emp) {
+        if (updated_emp.id != id) throw EmployeeException("A sharded update cannot change the employee ID");
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return owner(id).update(id, updated_emp);
+    }
 
-        const char* status_names[] = {"Active", "Inactive", "On Leave", "Terminated"};
+    bool remove(const std::string& id) {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return owner(id).remove(id);
+    }
 
-        for (int i = 0; i < 4; i++) {
-            EmployeeStatus status = static_cast<EmployeeStatus>(i);
-            int count = status_count[status];
-            double percentage = employees.empty() ? 0 : (100.0 * count / employees.size());
+    std::shared_ptr<const Employee> snapshot(const std::string& id) const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        return owner(id).snapshot(id);
+    }
 
-            std::cout << std::left << std::setw(12) << status_names[i]
-                      << ": " << count << " ("
-                      << std::fixed << std::setprecision(1) << percentage << "%)\n";
+    // Splits the batch by owner and bulk-loads every shard at once
+    EmployeeHashTable::BulkInsertResult bulk_insert(std::vector<Employee>&& employees) {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<std::vector<Employee>> parts(shards.size());
+        for (auto& emp : employees) parts[ring.owner(emp.id)].push_back(std::move(emp));
+
+        std::vector<EmployeeHashTable::BulkInsertResult> results(shards.size());
+        scatter([&](size_t shard) { results[shard] = shards[shard]->bulk_insert(std::move(parts[shard])); });
+        EmployeeHashTable::BulkInsertResult total;
+        for (const auto& result : results) {
+            total.inserted += result.inserted;
+            total.duplicates += result.duplicates;
+            total.invalid += result.invalid;
         }
+        return total;
     }
 
-    void generate_skills_report(const std::vector<Employee>& employees) {
-        std::unordered_map<std::string, int> skill_count;
+    // Matches in shard order; criteria.limit caps the total
+    std::vector<Employee> search(const SearchCriteria& criteria) const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<std::vector<Employee>> parts(shards.size());
+        scatter([&](size_t shard) { parts[shard] = shards[shard]->search(criteria); });
 
-        for (const auto& emp : employees) {
-            for (const auto& skill : emp.skills) {
-                skill_count[skill]++;
-            }
+        std::vector<Employee> results = std::move(parts[0]);
+        for (size_t shard = 1; shard < parts.size(); ++shard) {
+            std::move(parts[shard].begin(), parts[shard].end(), std::back_inserter(results));
         }
+        if (criteria.limit && results.size() > *criteria.limit) results.resize(*criteria.limit);
+        return results;
+    }
 
-        std::vector<std::pair<std::string, int>> sorted_skills(skill_count.begin(), skill_count.end());
-        std::sort(sorted_skills.begin(), sorted_skills.end(),
-                 [](const auto& a, const auto& b) { return a.second > b.second; });
-
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "             SKILL ANALYSIS\n";
-        std::cout << std::string(50, '=') << "\n";
-        std::cout << "Total Unique Skills: " << sorted_skills.size() << "\n\n";
-        std::cout << "Most Common Skills:\n";
+    size_t count(const SearchCriteria& criteria) const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<size_t> counts(shards.size());
+        scatter([&](size_t shard) { counts[shard] = shards[shard]->count(criteria); });
+        size_t total = std::accumulate(counts.begin(), counts.end(), size_t(0));
+        return criteria.limit ? std::min(total, *criteria.limit) : total;
+    }
 
-        int display_count = std::min(15, static_cast<int>(sorted_skills.size()));
-        for (int i = 0; i < display_count; i++) {
-            std::cout << std::right << std::setw(2) << (i + 1) << ". "
-                      << std::left << std::setw(25) << sorted_skills[i].first
-                      << ": " << sorted_skills[i].second << " employees\n";
+    // The next page overall is among the next page of each shard, so every shard
+    // pages from the same cursor and the heads of the results are merged
+    EmployeePage page(const PageRequest& request) {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<EmployeePage> parts(shards.size());
+        scatter([&](size_t shard) { parts[shard] = shards[shard]->page(request); });
+
+        EmployeePage merged;
+        for (auto& part : parts) {
+            merged.has_more |= part.has_more;
+            std::move(part.employees.begin(), part.employees.end(), std::back_inserter(merged.employees));
+        }
+        std::sort(merged.employees.begin(), merged.employees.end(), [&](const Employee& a, const Employee& b) {
+            return request.descending ? precedes(request.key, b, a) : precedes(request.key, a, b);
+        });
+        if (merged.employees.size() > request.size) {
+            merged.employees.resize(request.size);
+            merged.has_more = true;
         }
+        return merged;
     }
 
-    void generate_hierarchy_report(const std::vector<Employee>& employees) {
-        std::unordered_map<std::string, std::vector<std::string>> hierarchy;
-        std::unordered_set<std::string> managers;
-        std::unordered_set<std::string> all_employees;
+    // Up to limit matches from every shard, re-ranked as one table ranks them:
+    // by quality, then field, then how much of the value the query covers
+    std::vector<NameMatch> find_by_name(std::string_view query, size_t limit = 20,
+                                        std::optional<size_t> max_edits = std::nullopt) {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<std::vector<NameMatch>> parts(shards.size());
+        scatter([&](size_t shard) { parts[shard] = shards[shard]->find_by_name(query, limit, max_edits); });
+
+        std::vector<NameMatch> merged;
+        for (auto& part : parts) std::move(part.begin(), part.end(), std::back_inserter(merged));
+        auto rank = [](const NameMatch& match) {
+            return std::make_tuple(match.quality, match.field, field_value(match).size());
+        };
+        std::stable_sort(merged.begin(), merged.end(),
+                         [&](const NameMatch& a, const NameMatch& b) { return rank(a) < rank(b); });
+        if (merged.size() > limit) merged.resize(limit);
+        return merged;
+    }
 
-        for (const auto& emp : employees) {
-            all_employees.insert(emp.id);
-            if (!emp.managerId.empty()) {
-                hierarchy[emp.managerId].push_back(emp.id);
-                managers.insert(emp.managerId);
+    // Counts and sums add up; the standard deviation is pooled from each
+    // shard's mean and spread, and distinct skills are a union
+    TableAggregates aggregates() const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<TableAggregates> parts(shards.size());
+        std::vector<std::vector<InternedString>> skills(shards.size());
+        scatter([&](size_t shard) {
+            parts[shard] = shards[shard]->aggregates();
+            skills[shard] = shards[shard]->skills();
+        });
+
+        TableAggregates totals;
+        long double squares = 0.0L;
+        std::unordered_set<InternedString, InternedString::Hash> distinct;
+        for (size_t shard = 0; shard < parts.size(); ++shard) {
+            const TableAggregates& part = parts[shard];
+            distinct.insert(skills[shard].begin(), skills[shard].end());
+            if (part.employee_count == 0) continue;
+            totals.min_salary = totals.employee_count ? std::min(totals.min_salary, part.min_salary) : part.min_salary;
+            totals.max_salary = totals.employee_count ? std::max(totals.max_salary, part.max_salary) : part.max_salary;
+            totals.employee_count += part.employee_count;
+            totals.total_salary += part.total_salary;
+            for (size_t i = 0; i < TableAggregates::DEPARTMENTS; ++i) {
+                totals.department_count[i] += part.department_count[i];
+                totals.department_salary[i] += part.department_salary[i];
             }
+            for (size_t i = 0; i < TableAggregates::STATUSES; ++i) totals.status_count[i] += part.status_count[i];
+            long double mean = part.mean_salary();
+            squares += part.employee_count * (static_cast<long double>(part.salary_stddev) * part.salary_stddev +
+                                              mean * mean);
         }
+        totals.distinct_skills = distinct.size();
+        if (totals.employee_count) {
+            long double mean = totals.mean_salary();
+            totals.salary_stddev = static_cast<double>(
+                std::sqrt(std::max(0.0L, squares / totals.employee_count - mean * mean)));
+        }
+        return totals;
+    }
 
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "           MANAGEMENT HIERARCHY\n";
-        std::cout << std::string(50, '=') << "\n";
+    // Every shard's view, concatenated; ReportEngine::summarize() takes it as is
+    EmployeeHashTable::View view() const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        std::vector<EmployeeHashTable::View> parts(shards.size());
+        scatter([&](size_t shard) { parts[shard] = shards[shard]->view(); });
+        return EmployeeHashTable::View::concat(std::move(parts));
+    }
 
-        // Find top-level managers (managers who are also employees but have no manager)
-        std::vector<std::string> top_managers;
-        for (const auto& manager_id : managers) {
-            if (all_employees.count(manager_id)) {
-                Employee* mgr = db.find(manager_id);
-                if (mgr && mgr->managerId.empty()) {
-                    top_managers.push_back(manager_id);
-                }
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(layout_mutex);
+        size_t total = 0;
+        for (const auto& shard : shards) total += shard->size();
+        return total;
+    }
+
+    struct ResizeResult {
+        size_t moved = 0;
+        size_t examined = 0;
+    };
+
+    // Rebuilds the ring for shard_count shards and moves exactly the records whose
+    // owner changed: those of removed shards, or those the new shards take over.
+    // Every shard is scanned in parallel; records are inserted into their new
+    // shard before they are removed from the old one.
+    ResizeResult resize(size_t shard_count) {
+        ShardRing next(shard_count);
+        std::unique_lock<std::shared_mutex> lock(layout_mutex);
+        size_t old_count = shards.size();
+        for (size_t i = old_count; i < shard_count; ++i) {
+            if (spare_shards.empty()) {
+                shards.push_back(std::make_unique<EmployeeHashTable>(17, storage));
+            } else {
+                shards.push_back(std::move(spare_shards.back()));
+                spare_shards.pop_back();
             }
         }
 
-        // Display hierarchy
-        for (const auto& top_mgr : top_managers) {
-            Employee* mgr = db.find(top_mgr);
-            if (mgr) {
-                std::cout << mgr->getFullName() << " (" << top_mgr << ") - " << mgr->position << "\n";
-                display_subordinates(hierarchy, top_mgr, 1);
-                std::cout << "\n";
+        // moving[from][to] holds the records leaving shard from for shard to
+        std::vector<std::vector<std::vector<Employee>>> moving(old_count,
+                                                               std::vector<std::vector<Employee>>(shard_count));
+        std::vector<size_t> examined(old_count);
+        scatter_over(old_count, [&](size_t from) {
+            auto records = shards[from]->view();
+            examined[from] = records.size();
+            for (const auto& emp : records) {
+                size_t to = next.owner(emp.id);
+                if (to != from) moving[from][to].push_back(emp);
+            }
+        });
+
+        ResizeResult result;
+        result.examined = std::accumulate(examined.begin(), examined.end(), size_t(0));
+        scatter_over(shard_count, [&](size_t to) {
+            std::vector<Employee> incoming;
+            for (size_t from = 0; from < old_count; ++from) {
+                std::move(moving[from][to].begin(), moving[from][to].end(), std::back_inserter(incoming));
             }
+            if (!incoming.empty()) shards[to]->bulk_insert(std::move(incoming));
+        });
+        scatter_over(old_count, [&](size_t from) {
+            for (const auto& targets : moving[from]) {
+                for (const auto& emp : targets) shards[from]->remove(emp.id);
+            }
+        });
+        for (size_t from = 0; from < old_count; ++from) {
+            for (const auto& targets : moving[from]) result.moved += targets.size();
         }
 
-        // Show orphaned managers (managers not in employee database)
-        std::cout << "External/Missing Managers:\n";
-        for (const auto& manager_id : managers) {
-            if (!all_employees.count(manager_id)) {
-                std::cout << "  " << manager_id << " (manages " << hierarchy[manager_id].size() << " employees)\n";
+        for (size_t i = shard_count; i < old_count; ++i) spare_shards.push_back(std::move(shards[i]));
+        shards.resize(shard_count);
+        ring = std::move(next);
+        Logger::log(Logger::INFO, "Resharded from ", std::to_string(old_count), " to ", std::to_string(shard_count),
+                    " shards, moving ", std::to_string(result.moved), " of ", std::to_string(result.examined),
+                    " employees");
+        return result;
+    }
+
+private:
+    // Guards the shard list and ring: shared by every operation, exclusive only
+    // for resize()
+    mutable std::shared_mutex layout_mutex;
+    std::vector<std::unique_ptr<EmployeeHashTable>> shards;
+    ShardRing ring;
+    WorkerPool& pool;
+
+    // Shards emptied by shrinking. Snapshots and views taken from them must stay
+    // valid, so they live as long as this table and are reused when it grows.
+    std::vector<std::unique_ptr<EmployeeHashTable>> spare_shards;
+    StorageBackend storage;
+
+    // Caller holds layout_mutex
+    EmployeeHashTable& owner(const std::string& id) const { return *shards[ring.owner(id)]; }
+
+    template <typename Body>
+    void scatter(Body&& body) const { scatter_over(shards.size(), body); }
+
+    // Runs body(i) for every i in [0, count) on the pool. The first exception
+    // thrown is rethrown here once every call has finished.
+    template <typename Body>
+    void scatter_over(size_t count, Body&& body) const {
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+        pool.parallel_for(count, [&](size_t i) {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(failure_mutex);
+                if (!failure) failure = std::current_exception();
             }
-        }
+        });
+        if (failure) std::rethrow_exception(failure);
     }
 
-    void display_subordinates(const std::unordered_map<std::string, std::vector<std::string>>& hierarchy,
-                             const std::string& manager_id, int level) {
-        if (hierarchy.find(manager_id) == hierarchy.end()) return;
+    template <SortKey Key>
+    static bool precedes_by(const Employee& a, const Employee& b) {
+        return RecordOrder<Key>()(RecordOrder<Key>::entry(a), RecordOrder<Key>::entry(b));
+    }
 
-        std::string indent(level * 2, ' ');
-        for (const auto& subordinate_id : hierarchy.at(manager_id)) {
-            Employee* emp = db.find(subordinate_id);
-            if (emp) {
-                std::cout << indent << "├─ " << emp->getFullName() << " (" << subordinate_id
-                          << ") - " << emp->position << "\n";
-                display_subordinates(hierarchy, subordinate_id, level + 1);
-            }
+    static bool precedes(SortKey key, const Employee& a, const Employee& b) {
+        switch (key) {
+            case SortKey::ID: return precedes_by<SortKey::ID>(a, b);
+            case SortKey::NAME: return precedes_by<SortKey::NAME>(a, b);
+            case SortKey::SALARY: return precedes_by<SortKey::SALARY>(a, b);
+            case SortKey::HIRE_DATE: return precedes_by<SortKey::HIRE_DATE>(a, b);
         }
+        return false;
     }
 
-    void import_export_menu() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "      IMPORT/EXPORT\n";
-        std::cout << std::string(40, '=') << "\n";
-        std::cout << "1. Export to CSV\n";
-        std::cout << "2. Manual Backup\n";
-        std::cout << "3. Load from Backup\n";
-        std::cout << "4. View Data Files\n";
+    static std::string_view field_value(const NameMatch& match) {
+        switch (match.field) {
+            case NameField::FIRST_NAME: return match.employee.firstName;
+            case NameField::LAST_NAME: return match.employee.lastName;
+            default: return match.employee.position;
+        }
+    }
+};
 
-        int choice = get_int_input("Select option (1-4): ", 1, 4);
+// ==================== BENCHMARKS ====================
 
-        switch (choice) {
-            case 1: export_csv(); break;
-            case 2: manual_backup(); break;
-            case 3: load_backup(); break;
-            case 4: view_data_files(); break;
+// Deterministic synthetic employees with roughly the shape of a real HR extract:
+// weighted departments, log-normal salaries per department, mostly active staff,
+// Zipf-distributed skills and a reporting tree with a fan-out of about eight.
+// Records are generated in fixed-size chunks, each with its own seed, so the
+// output does not depend on how many threads produce it.
+class WorkloadGenerator {
+public:
+    // The AB1234 ID format has 26 * 26 * 10000 values; the tail is left unused
+    // so benchmarks always have IDs that are guaranteed misses
+    static constexpr size_t ID_SPACE = 26 * 26 * 10000;
+    static constexpr size_t MAX_RECORDS = 6000000;
+
+    static std::string synthetic_id(size_t i) {
+        // Two letters + four digits covers 6.76M unique IDs
+        size_t prefix = i / 10000;
+        size_t number = i % 10000;
+        char id[6] = {static_cast<char>('A' + (prefix / 26) % 26), static_cast<char>('A' + prefix % 26),
+                      static_cast<char>('0' + number / 1000), static_cast<char>('0' + number / 100 % 10),
+                      static_cast<char>('0' + number / 10 % 10), static_cast<char>('0' + number % 10)};
+        return std::string(id, sizeof(id));
+    }
+
+    // An ID no generated record uses
+    static std::string missing_id(size_t i) {
+        return synthetic_id(MAX_RECORDS + i % (ID_SPACE - MAX_RECORDS));
+    }
+
+    // The manager of record i, or "" for the root
+    static std::string manager_of(size_t i) {
+        return i == 0 ? std::string() : synthetic_id((i - 1) / FAN_OUT);
+    }
+
+    static std::vector<Employee> generate(size_t count, uint64_t seed = 42) {
+        count = std::min(count, MAX_RECORDS);
+        WorkloadGenerator generator;
+        std::vector<Employee> employees(count);
+        size_t chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        ParallelRange::run(chunks, ParallelRange::workers_for(chunks, 1), [&](size_t, size_t begin, size_t end) {
+            Draws draws;
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                std::mt19937_64 rng(seed ^ (0x9E3779B97F4A7C15ULL * (chunk + 1)));
+                draws.reset();
+                for (size_t i = chunk * CHUNK_SIZE; i < std::min(count, (chunk + 1) * CHUNK_SIZE); ++i) {
+                    employees[i] = generator.make(i, rng, draws);
+                }
+            }
+        });
+        return employees;
+    }
+
+    // Skill names from most to least common, for building queries
+    static const std::vector<std::string>& skill_pool() {
+        static const std::vector<std::string> pool = [] {
+            std::vector<std::string> skills = {
+                "SQL", "Excel", "Python", "Communication", "Project Management", "Java", "C++",
+                "Leadership", "Negotiation", "Data Analysis", "JavaScript", "Accounting", "Recruiting",
+                "Cloud", "Linux", "Marketing Strategy", "Customer Service", "Go", "Rust", "Kubernetes",
+                "Budgeting", "Public Speaking", "Payroll", "Machine Learning", "SEO", "Logistics"};
+            for (size_t i = skills.size(); i < SKILL_POOL_SIZE; ++i) skills.push_back("Tool-" + std::to_string(i));
+            return skills;
+        }();
+        return pool;
+    }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 65536;
+    static constexpr size_t FAN_OUT = 8;
+    static constexpr size_t SKILL_POOL_SIZE = 400;
+    static constexpr size_t MAX_SKILLS = 6;
+
+    // Engineering, HR, Finance, Marketing, Operations, Sales, Unknown
+    static constexpr double DEPARTMENT_WEIGHTS[] = {30, 8, 10, 10, 15, 25, 2};
+    static constexpr double MEDIAN_SALARY[] = {115000, 68000, 88000, 78000, 62000, 72000, 55000};
+    // Active, Inactive, On Leave, Terminated
+    static constexpr double STATUS_WEIGHTS[] = {86, 4, 4, 6};
+
+    // Distributions carry state, so each worker owns a set
+    struct Draws {
+        std::discrete_distribution<int> department{std::begin(DEPARTMENT_WEIGHTS), std::end(DEPARTMENT_WEIGHTS)};
+        std::discrete_distribution<int> status{std::begin(STATUS_WEIGHTS), std::end(STATUS_WEIGHTS)};
+        std::normal_distribution<double> salary_noise{0.0, 0.35};
+        std::uniform_real_distribution<double> unit{0.0, 1.0};
+
+        // Chunks must not depend on what the previous chunk left cached
+        void reset() {
+            department.reset();
+            status.reset();
+            salary_noise.reset();
+            unit.reset();
         }
+    };
 
-        pause();
+    std::vector<double> skill_cdf;
+
+    WorkloadGenerator() {
+        // Zipf with s = 1.1 over the pool
+        double total = 0;
+        for (size_t rank = 1; rank <= SKILL_POOL_SIZE; ++rank) {
+            total += 1.0 / std::pow(static_cast<double>(rank), 1.1);
+            skill_cdf.push_back(total);
+        }
+        for (double& p : skill_cdf) p /= total;
     }
 
-    void export_csv() {
-        std::string filename = get_input("Enter CSV filename (e.g., employees.csv): ");
-        if (filename.empty()) filename = "employees.csv";
+    Employee make(size_t i, std::mt19937_64& rng, Draws& draws) const {
+        static const char* const first_names[] = {"James", "Mary", "Robert", "Patricia", "Michael", "Jennifer",
+            "Wei", "Aisha", "Carlos", "Sofia", "Anh", "Olga", "Kwame", "Priya", "Liam", "Mei-Ling"};
+        static const char* const last_names[] = {"Smith", "Johnson", "Garcia", "Nguyen", "Kim", "Patel",
+            "O'Connor", "Okafor", "Rossi", "Schmidt", "Tanaka", "Lopez", "Ivanova", "Anderson-Lee"};
+        static const char* const positions[][3] = {
+            {"Software Engineer", "Senior Engineer", "Engineering Manager"},
+            {"HR Generalist", "Recruiter", "HR Manager"},
+            {"Accountant", "Financial Analyst", "Controller"},
+            {"Marketing Specialist", "Content Writer", "Brand Manager"},
+            {"Operations Analyst", "Logistics Coordinator", "Plant Manager"},
+            {"Account Executive", "Sales Representative", "Sales Manager"},
+            {"Contractor", "Consultant", "Intern"}};
 
-        if (data_manager.export_csv(db, filename)) {
-            std::cout << "\n✓ Data exported successfully to " << filename << "\n";
-        } else {
-            std::cout << "\n✗ Export failed.\n";
+        Employee emp;
+        emp.id = synthetic_id(i);
+        const char* first = first_names[rng() % std::size(first_names)];
+        const char* last = last_names[rng() % std::size(last_names)];
+        emp.firstName = first;
+        emp.lastName = last;
+
+        int department = draws.department(rng);
+        emp.department = static_cast<Department>(department);
+        emp.position = positions[department][rng() % 3];
+        double salary = MEDIAN_SALARY[department] * std::exp(draws.salary_noise(rng));
+        emp.salary = std::round(std::clamp(salary, 20000.0, 2000000.0) * 100) / 100;
+        emp.status = static_cast<EmployeeStatus>(draws.status(rng));
+        emp.accessLevel = rng() % 100 == 0 ? AccessLevel::ADMIN : AccessLevel::BASIC;
+        emp.managerId = manager_of(i);
+
+        std::string local = std::string(first) + "." + last + std::to_string(i);
+        local.erase(std::remove_if(local.begin(), local.end(),
+                    [](char c) { return c == '\'' || c == ' '; }), local.end());
+        emp.email = local + "@example.com";
+        if (rng() % 4 != 0) emp.phone = "+1" + std::to_string(2000000000 + rng() % 8000000000ULL);
+
+        // Up to 25 years back, at whole days
+        auto days = static_cast<long>(rng() % (25 * 365));
+        emp.hireDate = std::chrono::system_clock::now() - std::chrono::hours(24 * days);
+
+        const auto& pool = skill_pool();
+        size_t skill_count = rng() % (MAX_SKILLS + 1);
+        for (size_t s = 0; s < skill_count; ++s) {
+            size_t rank = static_cast<size_t>(std::lower_bound(skill_cdf.begin(), skill_cdf.end(), draws.unit(rng)) -
+                                              skill_cdf.begin());
+            const std::string& skill = pool[std::min(rank, pool.size() - 1)];
+            if (std::find(emp.skills.begin(), emp.skills.end(), skill) == emp.skills.end()) emp.skills.push_back(skill);
         }
+        return emp;
+    }
+};
+
+// Per-operation latencies for one benchmark row. Timing each call adds one clock
+// read (a few tens of ns), which is noise for everything but the tightest loops.
+class LatencySamples {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    template <typename Operation>
+    void time(Operation&& operation) {
+        auto start = Clock::now();
+        operation();
+        samples.push_back(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
     }
 
-    void manual_backup() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
+    void merge(const LatencySamples& other) {
+        samples.insert(samples.end(), other.samples.begin(), other.samples.end());
+    }
+
+    void reserve(size_t count) { samples.reserve(count); }
+    size_t size() const { return samples.size(); }
 
-        std::ostringstream oss;
-        oss << "backup_" << std::put_time(std::localtime(&time_t), "%Y%m%d_%H%M%S") << ".dat";
+    static void write_header(std::ostream& os) {
+        os << std::left << std::setw(36) << "Operation" << std::right << std::setw(10) << "ops"
+           << std::setw(13) << "ops/s" << std::setw(11) << "p50 us" << std::setw(11) << "p90 us"
+           << std::setw(11) << "p99 us" << std::setw(11) << "p99.9 us" << std::setw(12) << "max us" << "\n"
+           << std::string(115, '-') << "\n";
+    }
 
-        DataManager backup_manager(oss.str());
-        if (backup_manager.save(db)) {
-            std::cout << "\n✓ Manual backup created: " << oss.str() << "\n";
-        } else {
-            std::cout << "\n✗ Backup failed.\n";
-        }
+    // Throughput is over wall_seconds, so concurrent runs report their aggregate
+    void write_row(std::ostream& os, const std::string& name, double wall_seconds) {
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p) {
+            if (samples.empty()) return 0.0;
+            size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+            return samples[std::min(samples.size(), std::max<size_t>(rank, 1)) - 1] / 1000.0;
+        };
+        double throughput = wall_seconds > 0 ? samples.size() / wall_seconds : 0.0;
+
+        os << std::left << std::setw(36) << name << std::right << std::setw(10) << samples.size()
+           << std::fixed << std::setprecision(0) << std::setw(13) << throughput << std::setprecision(2)
+           << std::setw(11) << percentile(50) << std::setw(11) << percentile(90)
+           << std::setw(11) << percentile(99) << std::setw(11) << percentile(99.9)
+           << std::setw(12) << percentile(100) << "\n";
     }
 
-    void load_backup() {
-        std::string filename = get_input("Enter backup filename: ");
-        std::string confirm = get_input("This will replace current data. Continue? (yes/no): ");
+private:
+    std::vector<uint64_t> samples;
+};
 
-        if (confirm == "yes" || confirm == "YES") {
-            DataManager backup_manager(filename);
+class StorageBenchmark {
+private:
+    using Clock = std::chrono::steady_clock;
 
-            // Create temporary database
-            EmployeeHashTable temp_db;
-            if (backup_manager.load(temp_db)) {
-                // Clear current database and load backup
-                db = std::move(temp_db);
-                std::cout << "\n✓ Backup loaded successfully.\n";
-            } else {
-                std::cout << "\n✗ Failed to load backup.\n";
-            }
-        } else {
-            std::cout << "\nOperation cancelled.\n";
-        }
+    static std::string synthetic_id(size_t i) { return WorkloadGenerator::synthetic_id(i); }
+
+    static double ns_per_op(Clock::time_point start, size_t ops) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        return ops ? static_cast<double>(elapsed.count()) / ops : 0.0;
     }
 
-    void view_data_files() {
-        std::cout << "\nData Files Information:\n";
-        std::cout << "Primary data file: employees.dat\n";
-        std::cout << "Automatic backup: employees.dat.bak\n";
-        std::cout << "Log file: employee_system.log\n";
+    static void run_backend(StorageBackend backend, const std::vector<Employee>& employees,
+                            const std::vector<std::string>& hit_order,
+                            const std::vector<std::string>& misses, std::ostream& os) {
+        auto store = EmployeeStore::create(backend, 17);
 
-        // Check file sizes
-        std::ifstream primary("employees.dat", std::ios::ate | std::ios::binary);
-        if (primary.good()) {
-            std::cout << "Primary file size: " << primary.tellg() << " bytes\n";
-        } else {
-            std::cout << "Primary file: Not found\n";
+        auto start = Clock::now();
+        for (const auto& emp : employees) {
+            store->insert(Employee(emp));
+            if (store->load_factor() > store->max_load_factor()) store->grow();
         }
+        double insert_ns = ns_per_op(start, employees.size());
 
-        std::ifstream backup("employees.dat.bak", std::ios::ate | std::ios::binary);
-        if (backup.good()) {
-            std::cout << "Backup file size: " << backup.tellg() << " bytes\n";
-        } else {
-            std::cout << "Backup file: Not found\n";
+        size_t found = 0;
+        start = Clock::now();
+        for (const auto& id : hit_order) {
+            if (store->find(id)) ++found;
         }
-    }
+        double hit_ns = ns_per_op(start, hit_order.size());
 
-    void system_statistics() {
-        clear_screen();
-        std::cout << "\n" << std::string(50, '=') << "\n";
-        std::cout << "           SYSTEM STATISTICS\n";
-        std::cout << std::string(50, '=') << "\n";
+        start = Clock::now();
+        for (const auto& id : misses) {
+            if (store->find(id)) ++found;
+        }
+        double miss_ns = ns_per_op(start, misses.size());
 
-        auto employees = db.get_all();
+        double payroll = 0;
+        start = Clock::now();
+        store->for_each([&](const Employee& emp) { payroll += emp.salary; });
+        double scan_ns = ns_per_op(start, store->size());
 
-        std::cout << "Database Overview:\n";
-        std::cout << "  Total Employees: " << employees.size() << "\n";
+        start = Clock::now();
+        for (const auto& id : hit_order) {
+            store->erase(id);
+        }
+        double erase_ns = ns_per_op(start, hit_order.size());
 
-        // Hash table performance
-        db.get_statistics(std::cout);
+        os << std::left << std::setw(30) << store->backend_name() << std::right << std::fixed << std::setprecision(1)
+           << std::setw(10) << insert_ns << std::setw(10) << hit_ns << std::setw(10) << miss_ns
+           << std::setw(10) << scan_ns << std::setw(10) << erase_ns << "\n";
 
-        // Memory usage estimation
-        size_t estimated_memory = sizeof(Employee) * employees.size();
-        estimated_memory += db.size() * 100; // Rough hash table overhead
+        if (found != hit_order.size() || payroll <= 0) {
+            os << "  (unexpected result: " << found << " of " << hit_order.size() << " found)\n";
+        }
+    }
 
-        std::cout << "\nMemory Usage (estimated):\n";
-        std::cout << "  Employee data: ~" << (estimated_memory / 1024) << " KB\n";
+public:
+    // Compares the storage backends directly, without locking or logging, in ns/op
+    static void run(size_t record_count, std::ostream& os) {
+        record_count = std::min<size_t>(record_count, 26 * 26 * 10000 / 2);
 
-        // Department distribution
-        std::unordered_map<Department, int> dept_count;
-        for (const auto& emp : employees) {
-            dept_count[emp.department]++;
+        std::mt19937_64 rng(42);
+        std::vector<Employee> employees;
+        employees.reserve(record_count);
+        const char* positions[] = {"Software Engineer", "Accountant", "Recruiter", "Sales Manager", "Analyst"};
+
+        for (size_t i = 0; i < record_count; ++i) {
+            Employee emp;
+            emp.id = synthetic_id(i * 2);
+            emp.firstName = "First";
+            emp.lastName = "Last";
+            emp.position = positions[i % 5];
+            emp.department = static_cast<Department>(i % 6);
+            emp.salary = 30000 + static_cast<double>(rng() % 170000);
+            emp.skills = {"C++", "SQL"};
+            employees.push_back(std::move(emp));
         }
 
-        std::cout << "\nDepartment Distribution:\n";
-        const char* dept_names[] = {"Engineering", "HR", "Finance", "Marketing", "Operations", "Sales", "Unknown"};
-        for (int i = 0; i < 7; i++) {
-            Department dept = static_cast<Department>(i);
-            std::cout << "  " << std::left << std::setw(12) << dept_names[i]
-                      << ": " << dept_count[dept] << "\n";
+        std::vector<std::string> hit_order;
+        std::vector<std::string> misses;
+        hit_order.reserve(record_count);
+        misses.reserve(record_count);
+        for (size_t i = 0; i < record_count; ++i) {
+            hit_order.push_back(employees[i].id);
+            misses.push_back(synthetic_id(i * 2 + 1));
         }
+        std::shuffle(hit_order.begin(), hit_order.end(), rng);
 
-        pause();
-    }
+        os << "Storage backend benchmark, " << record_count << " records (ns/op)\n"
+           << std::left << std::setw(30) << "Backend" << std::right
+           << std::setw(10) << "insert" << std::setw(10) << "find-hit" << std::setw(10) << "find-miss"
+           << std::setw(10) << "scan" << std::setw(10) << "erase" << "\n"
+           << std::string(80, '-') << "\n";
 
-    void data_management() {
-        clear_screen();
-        std::cout << "\n" << std::string(40, '=') << "\n";
-        std::cout << "     DATA MANAGEMENT\n";
-        std::cout << std::string(40, '=') << "\n";
-        std::cout << "1. Save Data Now\n";
-        std::cout << "2. Reload Data\n";
-        std::cout << "3. Clear All Data\n";
-        std::cout << "4. Data Validation\n";
-        std::cout << "5. Optimize Database\n";
+        run_backend(StorageBackend::CHAINED, employees, hit_order, misses, os);
+        run_backend(StorageBackend::OPEN_ADDRESSING, employees, hit_order, misses, os);
+    }
+};
 
-        int choice = get_int_input("Select option (1-5): ", 1, 5);
+class SearchBenchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // What search() did per record and criterion before TextMatcher
+    static bool legacy_contains(const std::string& field, const std::string& term) {
+        std::string lowerField = field;
+        std::string lowerTerm = term;
+        std::transform(lowerField.begin(), lowerField.end(), lowerField.begin(), ::tolower);
+        std::transform(lowerTerm.begin(), lowerTerm.end(), lowerTerm.begin(), ::tolower);
+        return lowerField.find(lowerTerm) != std::string::npos;
+    }
 
-        switch (choice) {
-            case 1:
-                if (data_manager.save(db)) {
-                    std::cout << "\n✓ Data saved successfully.\n";
-                } else {
-                    std::cout << "\n✗ Save failed.\n";
-                }
-                break;
+public:
+    // Case-insensitive substring matching over name, position and skill fields
+    static void run(size_t record_count, std::ostream& os) {
+        const char* first_names[] = {"James", "Mary", "Robert", "Patricia", "Michael", "Jennifer", "Anderson-Lee"};
+        const char* last_names[] = {"Smith", "Johnson", "Williams", "Brown", "Garcia", "Martinez", "O'Sullivan"};
+        const char* positions[] = {"Software Engineer", "Senior Accountant", "HR Generalist", "Sales Manager"};
+        const char* skill_names[] = {"Python", "SQL", "Project Management", "C++", "Negotiation"};
+        const char* terms[] = {"SON", "mar", "engineer", "sql", "xyz"};
+
+        std::vector<Employee> employees(record_count);
+        for (size_t i = 0; i < record_count; ++i) {
+            employees[i].firstName = first_names[i % 7];
+            employees[i].lastName = last_names[(i / 7) % 7];
+            employees[i].position = positions[i % 4];
+            employees[i].skills = {skill_names[i % 5], skill_names[(i + 2) % 5]};
+        }
 
-            case 2: {
-                std::string confirm = get_input("Reload will lose unsaved changes. Continue? (yes/no): ");
-                if (confirm == "yes" || confirm == "YES") {
-                    EmployeeHashTable temp_db;
-                    if (data_manager.load(temp_db)) {
-                        db = std::move(temp_db);
-                        std::cout << "\n✓ Data reloaded successfully.\n";
-                    } else {
-                        std::cout << "\n✗ Reload failed.\n";
+        std::vector<std::string> raw_terms(std::begin(terms), std::end(terms));
+        std::vector<std::string> folded_terms;
+        for (const auto& term : raw_terms) folded_terms.push_back(TextMatcher::fold_copy(term));
+
+        auto time_matcher = [&](auto&& match) {
+            size_t hits = 0;
+            auto start = Clock::now();
+            for (size_t t = 0; t < raw_terms.size(); ++t) {
+                for (const auto& emp : employees) {
+                    if (match(emp.firstName, t)) ++hits;
+                    if (match(emp.lastName, t)) ++hits;
+                    if (match(emp.position, t)) ++hits;
+                    for (const auto& skill : emp.skills) {
+                        if (match(skill, t)) ++hits;
                     }
-                } else {
-                    std::cout << "\nOperation cancelled.\n";
-                }
-                break;
-            }
-
-            case 3: {
-                std::string confirm = get_input("This will delete ALL employee data. Type 'DELETE ALL' to confirm: ");
-                if (confirm == "DELETE ALL") {
-                    db = EmployeeHashTable();  // Create new empty database
-                    std::cout << "\n✓ All data cleared.\n";
-                } else {
-                    std::cout << "\nOperation cancelled.\n";
                 }
-                break;
             }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            return std::make_pair(static_cast<double>(elapsed.count()) / (record_count * raw_terms.size()), hits);
+        };
+
+        auto legacy = time_matcher([&](const std::string& field, size_t t) {
+            return legacy_contains(field, raw_terms[t]);
+        });
+        auto folded = time_matcher([&](const std::string& field, size_t t) {
+            return TextMatcher::contains_folded(field, folded_terms[t]);
+        });
+
+        os << "\nCase-insensitive match benchmark, " << record_count << " records x 5 terms (ns/record)\n"
+           << std::left << std::setw(30) << "Lowercase copies" << std::right << std::fixed << std::setprecision(1)
+           << std::setw(10) << legacy.first << "\n"
+           << std::left << std::setw(30) << "Folded in place" << std::right
+           << std::setw(10) << folded.first << "\n";
+
+        if (legacy.second != folded.second) {
+            os << "  (unexpected result: " << legacy.second << " vs " << folded.second << " matches)\n";
+        }
+    }
+};
 
-            case 4:
-                validate_all_data();
-                break;
+// End-to-end measurements of EmployeeHashTable and DataManager on generated
+// records, with all locking, indexing and logging in place
+class TableBenchmark {
+public:
+    struct Options {
+        size_t records = 200000;
+        StorageBackend backend = StorageBackend::CHAINED;
+        size_t threads = 0;  // Mixed-run threads; 0 means one per hardware thread, at least 2
+        double mixed_seconds = 2.0;
+    };
 
-            case 5:
-                std::cout << "\nOptimizing database...\n";
-                // Force rehash if needed
-                if (db.load_factor() > 0.5) {
-                    std::cout << "Triggering rehash for optimal performance...\n";
-                    // The hash table will rehash automatically on next insert if needed
-                }
-                std::cout << "✓ Database optimization completed.\n";
-                break;
+    static void run(const Options& options, std::ostream& os) {
+        auto start = Clock::now();
+        std::vector<Employee> employees = WorkloadGenerator::generate(options.records);
+        const size_t n = employees.size();
+        os << "\nTable benchmark, " << n << " records (" << EmployeeStore::create(options.backend, 17)->backend_name()
+           << "), generated in " << std::fixed << std::setprecision(0) << seconds_since(start) * 1000 << " ms\n";
+        LatencySamples::write_header(os);
+        if (n == 0) return;
+
+        std::mt19937_64 rng(7);
+        auto random_id = [&] { return WorkloadGenerator::synthetic_id(rng() % n); };
+
+        EmployeeHashTable table(17, options.backend);
+        {
+            auto records = employees;
+            measure(os, "bulk_insert (all records)", 1, [&](size_t) { table.bulk_insert(std::move(records)); });
+        }
+        {
+            EmployeeHashTable fresh(17, options.backend);
+            size_t count = std::min<size_t>(n, 100000);
+            measure(os, "insert (empty table)", count, [&](size_t i) { fresh.insert(employees[i]); });
         }
 
-        pause();
+        size_t lookups = std::min<size_t>(std::max<size_t>(n, 100000), 1000000);
+        std::vector<std::string> hits(lookups);
+        for (auto& id : hits) id = random_id();
+        size_t found = 0;
+        measure(os, "find (hit)", lookups, [&](size_t i) { found += table.find(hits[i]) != nullptr; });
+        measure(os, "find (miss)", lookups, [&](size_t i) {
+            found += table.find(WorkloadGenerator::missing_id(i)) != nullptr;
+        });
+        measure(os, "snapshot (hit)", lookups, [&](size_t i) { found += table.snapshot(hits[i]) != nullptr; });
+
+        // The first lookup builds the term indexes, which the text searches
+        // below then drive from and every later write maintains
+        measure(os, "name lookup (first, builds index)", 1, [&](size_t) {
+            found += table.find_by_name("smith").size();
+        });
+        measure_for(os, "name lookup (prefix)", SEARCH_BUDGET_SECONDS, [&](size_t run) {
+            static const char* const queries[] = {"gar", "Engin", "pri"};
+            found += table.find_by_name(queries[run % 3]).size();
+        });
+        measure_for(os, "name lookup (typo)", SEARCH_BUDGET_SECONDS, [&](size_t run) {
+            static const char* const queries[] = {"jonhson", "Schmitd", "acountant"};
+            found += table.find_by_name(queries[run % 3]).size();
+        });
+        for (const auto& shape : search_shapes()) {
+            measure_for(os, "search " + shape.name, SEARCH_BUDGET_SECONDS, [&](size_t run) {
+                found += table.search(shape.criteria(run, rng)).size();
+            });
+        }
+        measure_for(os, "count status + name + skill", SEARCH_BUDGET_SECONDS, [&](size_t run) {
+            SearchCriteria c;
+            c.status = EmployeeStatus::ACTIVE;
+            c.lastName = "smith";
+            c.skill = WorkloadGenerator::skill_pool()[run % 10];
+            found += table.count(c);
+        });
+
+        size_t writes = std::min<size_t>(n, 100000);
+        measure(os, "update (copy-on-write)", writes, [&](size_t i) {
+            auto current = table.snapshot(hits[i]);
+            if (!current) return;
+            Employee changed = *current;
+            changed.salary = current->salary + 1;
+            table.update(changed.id, changed);
+        });
+        size_t churn = std::min<size_t>(n / 10 + 1, 50000);
+        std::vector<Employee> removed;
+        for (size_t i = 0; i < churn; ++i) {
+            if (auto emp = table.snapshot(WorkloadGenerator::synthetic_id(i * n / churn))) removed.push_back(*emp);
+        }
+        measure(os, "remove", removed.size(), [&](size_t i) { table.remove(removed[i].id); });
+        measure(os, "insert (loaded table)", removed.size(), [&](size_t i) { table.insert(removed[i]); });
+        measure(os, "reserve (rehash to 2x records)", 1, [&](size_t) { table.reserve(table.size() * 2); });
+
+        {
+            // One pipelined batch as a protocol client would send it, run on a
+            // single worker and then fanned out over the pool
+            std::string batch = "LOGIN " + hits[0] + "\n";
+            for (size_t i = 0; i < 1000; ++i) batch += "FIND " + hits[i % hits.size()] + "\n";
+            std::vector<size_t> pool_sizes = {1};
+            size_t hardware = std::thread::hardware_concurrency();
+            if (hardware > 1) pool_sizes.push_back(hardware);
+            for (size_t workers : pool_sizes) {
+                WorkerPool pool(workers);
+                ProtocolSession session(table, pool);
+                std::string out;
+                measure(os, "protocol batch, 1000 FINDs (pool of " + std::to_string(workers) + ")", 1000,
+                        [&](size_t) {
+                            out.clear();
+                            session.execute_batch(batch, out);
+                            found += out.size();
+                        });
+            }
+        }
+        measure(os, "aggregates", 10000, [&](size_t) { found += table.aggregates().employee_count; });
+        measure_for(os, "view", REPORT_BUDGET_SECONDS, [&](size_t) { found += table.view().size(); });
+        {
+            PageRequest request;
+            request.key = SortKey::NAME;
+            measure(os, "page (by name, next 20)", 10000, [&](size_t) {
+                EmployeePage page = table.page(request);
+                request.after.reset();
+                if (page.has_more) request.after = page.employees.back();
+                found += page.employees.size();
+            });
+        }
+        {
+            PageRequest request;
+            request.key = SortKey::SALARY;
+            request.descending = true;
+            request.size = 100;
+            measure(os, "top 100 by salary", 10000, [&](size_t) { found += table.page(request).employees.size(); });
+        }
+        measure_for(os, "report summary", REPORT_BUDGET_SECONDS, [&](size_t) {
+            found += ReportEngine::summarize(table.view()).employee_count;
+        });
+        measure_for(os, "org roots", REPORT_BUDGET_SECONDS, [&](size_t) {
+            found += table.org_roots().top_managers.size();
+        });
+        measure_for(os, "subtree (whole company)", REPORT_BUDGET_SECONDS, [&](size_t) {
+            found += table.subtree(WorkloadGenerator::synthetic_id(0)).members.size();
+        });
+        measure(os, "span of control (random)", std::min<size_t>(n, 10000), [&](size_t i) {
+            found += table.span_of_control(hits[i]).total;
+        });
+        measure(os, "chain of command (random)", std::min<size_t>(n, 100000), [&](size_t i) {
+            found += table.chain_of_command(hits[i]).managers.size();
+        });
+
+        run_persistence(os, table, DataFormat::BINARY, "binary");
+        run_persistence(os, table, DataFormat::TEXT, "text");
+        found += run_lazy_open(os, table, hits);
+        run_csv(os, table);
+        run_backup(os, table);
+        run_checkpoint(os, table, n);
+        run_sharded(os, employees, options.backend, hits);
+
+        size_t threads = options.threads ? options.threads :
+            std::max<size_t>(2, std::thread::hardware_concurrency());
+        run_mixed(os, table, n, 1, options.mixed_seconds);
+        run_mixed(os, table, n, threads, options.mixed_seconds);
+
+        if (found == 0) os << "  (unexpected result: nothing found)\n";
     }
 
-    void validate_all_data() {
-        std::cout << "\nValidating all employee records...\n";
+private:
+    using Clock = LatencySamples::Clock;
+
+    static constexpr double SEARCH_BUDGET_SECONDS = 1.0;
+    static constexpr size_t UPDATES_PER_BATCH = 100;
+    static constexpr size_t LAZY_CACHE_BYTES = size_t(64) << 20;
+    static constexpr double REPORT_BUDGET_SECONDS = 1.0;
+    static constexpr size_t MAX_REPEATS = 200;
+    static constexpr const char* BENCH_FILE = "benchmark_employees.dat";
+    static constexpr const char* BENCH_CSV = "benchmark_employees.csv";
+    // Archives keep their chunk store beside them, so benchmark backups get their
+    // own directory and never touch a real one
+    static constexpr const char* BENCH_BACKUP_DIR = "benchmark_backups";
+
+    static double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
 
-        auto employees = db.get_all();
-        int valid_count = 0;
-        int invalid_count = 0;
+    // Runs operation(i) for i in [0, count) and reports one row
+    template <typename Operation>
+    static void measure(std::ostream& os, const std::string& name, size_t count, Operation&& operation) {
+        LatencySamples samples;
+        samples.reserve(count);
+        auto start = Clock::now();
+        for (size_t i = 0; i < count; ++i) samples.time([&] { operation(i); });
+        samples.write_row(os, name, seconds_since(start));
+    }
 
-        for (const auto& emp : employees) {
-            try {
-                emp.validate();
-                valid_count++;
-            } catch (const EmployeeException& e) {
-                invalid_count++;
-                std::cout << "Invalid record - ID: " << emp.id << ", Error: " << e.what() << "\n";
-            }
+    // Repeats a slow operation until the time budget is spent, at least 3 times
+    template <typename Operation>
+    static void measure_for(std::ostream& os, const std::string& name, double budget, Operation&& operation) {
+        LatencySamples samples;
+        auto start = Clock::now();
+        for (size_t run = 0; run < MAX_REPEATS && (run < 3 || seconds_since(start) < budget); ++run) {
+            samples.time([&] { operation(run); });
         }
+        samples.write_row(os, name, seconds_since(start));
+    }
 
-        std::cout << "\nValidation Results:\n";
-        std::cout << "  Valid records: " << valid_count << "\n";
-        std::cout << "  Invalid records: " << invalid_count << "\n";
+    struct SearchShape {
+        std::string name;
+        std::function<SearchCriteria(size_t run, std::mt19937_64& rng)> criteria;
+    };
 
-        if (invalid_count == 0) {
-            std::cout << "✓ All records are valid!\n";
-        } else {
-            std::cout << "⚠ Found invalid records. Consider updating or removing them.\n";
+    // One entry per kind of SearchCriteria the CLI can build, indexed or not
+    static std::vector<SearchShape> search_shapes() {
+        static const char* const first_names[] = {"mary", "Wei", "carl"};
+        static const char* const last_names[] = {"smith", "Ngu", "ross"};
+        static const char* const positions[] = {"engineer", "Manager", "analyst"};
+        const auto& skills = WorkloadGenerator::skill_pool();
+
+        auto criteria = [](auto&& fill) {
+            return [fill](size_t run, std::mt19937_64& rng) {
+                SearchCriteria c;
+                fill(c, run, rng);
+                return c;
+            };
+        };
+        return {
+            {"by id", criteria([](SearchCriteria& c, size_t, std::mt19937_64& rng) {
+                c.id = WorkloadGenerator::synthetic_id(rng() % 1000);
+            })},
+            {"first name (substring)", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.firstName = first_names[run % 3];
+            })},
+            {"last name (case-sensitive)", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.lastName = last_names[run % 3];
+                c.caseSensitive = true;
+            })},
+            {"position", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.position = positions[run % 3];
+            })},
+            {"department", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.department = static_cast<Department>(run % TableAggregates::DEPARTMENTS);
+            })},
+            {"status", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.status = static_cast<EmployeeStatus>(run % TableAggregates::STATUSES);
+            })},
+            {"salary (narrow range)", criteria([](SearchCriteria& c, size_t, std::mt19937_64& rng) {
+                double low = 40000 + static_cast<double>(rng() % 100000);
+                c.minSalary = low;
+                c.maxSalary = low + 500;
+            })},
+            {"salary (wide range)", criteria([](SearchCriteria& c, size_t, std::mt19937_64&) {
+                c.minSalary = 50000;
+                c.maxSalary = 150000;
+            })},
+            {"skill (common)", criteria([&skills](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.skill = skills[run % 3];
+            })},
+            {"skill (rare)", criteria([&skills](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.skill = skills[skills.size() - 1 - run % 50];
+            })},
+            {"department + salary", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.department = static_cast<Department>(run % TableAggregates::DEPARTMENTS);
+                c.minSalary = 100000;
+                c.maxSalary = 120000;
+            })},
+            {"status + name + skill", criteria([&skills](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.status = EmployeeStatus::ACTIVE;
+                c.lastName = last_names[run % 3];
+                c.skill = skills[run % 10];
+            })},
+            {"first name (first page of 20)", criteria([](SearchCriteria& c, size_t run, std::mt19937_64&) {
+                c.firstName = first_names[run % 3];
+                c.limit = 20;
+            })},
+        };
+    }
+
+    static void remove_bench_files() {
+        for (const char* suffix : {"", ".bak", ".wal", ".wal.sealed", ".tmp", ".idx", ".idx.tmp"}) {
+            std::remove((std::string(BENCH_FILE) + suffix).c_str());
         }
+        std::remove(BENCH_CSV);
+        std::error_code ignored;
+        std::filesystem::remove_all(BENCH_BACKUP_DIR, ignored);
     }
 
-    void help_documentation() {
-        clear_screen();
-        std::cout << "\n" << std::string(60, '=') << "\n";
-        std::cout << "              HELP & DOCUMENTATION\n";
-        std::cout << std::string(60, '=') << "\n";
+    static void run_persistence(std::ostream& os, const EmployeeHashTable& table, DataFormat format,
+                                const std::string& label) {
+        DataManager manager(BENCH_FILE, format);
+        measure_for(os, "save (" + label + ")", REPORT_BUDGET_SECONDS, [&](size_t) { manager.save(table); });
+        measure_for(os, "load (" + label + ")", REPORT_BUDGET_SECONDS, [&](size_t) {
+            EmployeeHashTable loaded(17, table.backend());
+            manager.load(loaded);
+        });
+        remove_bench_files();
+    }
 
-        std::cout << "EMPLOYEE ID FORMAT:\n";
-        std::cout << "  Must follow pattern: AB1234 (2 letters + 4 digits)\n";
-        std::cout << "  Examples: EM0001, HR0123, IT9999\n\n";
+    // Updates of a table attached to a DataManager, first alone, then committed
+    // in batches, then while another thread checkpoints it back to back, to show
+    // what a checkpoint costs the writers
+    static void run_checkpoint(std::ostream& os, const EmployeeHashTable& table, size_t n) {
+        remove_bench_files();
+        EmployeeHashTable logged(17, table.backend());
+        {
+            DataManager manager(BENCH_FILE);
+            manager.save(table);
+            manager.open(logged);
+
+            size_t writes = std::min<size_t>(n, 20000);
+            std::mt19937_64 rng(11);
+            auto run_updates = [&](const std::string& name) {
+                LatencySamples samples;
+                samples.reserve(writes);
+                auto start = Clock::now();
+                for (size_t i = 0; i < writes; ++i) {
+                    std::string id = WorkloadGenerator::synthetic_id(rng() % n);
+                    samples.time([&] {
+                        if (auto current = logged.snapshot(id)) {
+                            Employee changed = *current;
+                            changed.salary = current->salary + 1;
+                            logged.update(id, changed);
+                        }
+                    });
+                }
+                samples.write_row(os, name, seconds_since(start));
+            };
+
+            run_updates("logged update");
+            {
+                LatencySamples samples;
+                samples.reserve(writes / UPDATES_PER_BATCH);
+                auto start = Clock::now();
+                for (size_t done = 0; done + UPDATES_PER_BATCH <= writes; done += UPDATES_PER_BATCH) {
+                    MutationBatch batch;
+                    for (size_t i = 0; i < UPDATES_PER_BATCH; ++i) {
+                        std::string id = WorkloadGenerator::synthetic_id(rng() % n);
+                        if (auto current = logged.snapshot(id)) {
+                            Employee changed = *current;
+                            changed.salary = current->salary + 1;
+                            batch.update(id, std::move(changed));
+                        }
+                    }
+                    samples.time([&] { logged.apply(std::move(batch)); });
+                }
+                samples.write_row(os, "logged batch of " + std::to_string(UPDATES_PER_BATCH) + " updates",
+                                  seconds_since(start));
+            }
+            SearchCriteria department;
+            department.department = Department::SALES;
+            measure(os, "logged update_where (one department)", 4, [&](size_t i) {
+                FieldChanges changes;
+                changes.status = i % 2 ? EmployeeStatus::ACTIVE : EmployeeStatus::ON_LEAVE;
+                logged.update_where(department, changes);
+            });
+            std::atomic<bool> stop{false};
+            std::thread checkpointer([&] {
+                while (!stop.load(std::memory_order_relaxed)) manager.save(logged);
+            });
+            run_updates("logged update (while checkpointing)");
+            stop.store(true);
+            checkpointer.join();
+        }
+        remove_bench_files();
+    }
 
-        std::cout << "VALIDATION RULES:\n";
-        std::cout << "  • Names: 2-50 characters, letters, spaces, hyphens, apostrophes\n";
-        std::cout << "  • Position: 2-30 characters, letters, spaces, hyphens\n";
-        std::cout << "  • Salary: Must be between 0 and 10,000,000\n";
-        std::cout << "  • Email: Standard email format (optional)\n";
-        std::cout << "  • Phone: 10-15 digits, optional + prefix\n\n";
+    // The same records over four shards, fanned out on a pool of hardware threads
+    static void run_sharded(std::ostream& os, const std::vector<Employee>& employees, StorageBackend backend,
+                            const std::vector<std::string>& hits) {
+        constexpr size_t SHARDS = 4;
+        WorkerPool pool(0);
+        ShardedTable sharded(SHARDS, pool, backend);
+        const std::string suffix = " (" + std::to_string(SHARDS) + " shards)";
+        size_t found = 0;
+        {
+            auto records = employees;
+            measure(os, "bulk_insert" + suffix, 1, [&](size_t) { sharded.bulk_insert(std::move(records)); });
+        }
+        measure(os, "snapshot (hit)" + suffix, hits.size(), [&](size_t i) {
+            found += sharded.snapshot(hits[i]) != nullptr;
+        });
+        measure_for(os, "search dept + salary" + suffix, SEARCH_BUDGET_SECONDS, [&](size_t run) {
+            SearchCriteria c;
+            c.department = static_cast<Department>(run % 6);
+            c.minSalary = 60000;
+            c.maxSalary = 90000;
+            found += sharded.search(c).size();
+        });
+        {
+            PageRequest request;
+            request.key = SortKey::SALARY;
+            request.descending = true;
+            request.size = 100;
+            measure(os, "top 100 by salary" + suffix, 1000, [&](size_t) {
+                found += sharded.page(request).employees.size();
+            });
+        }
+        measure(os, "aggregates" + suffix, 10000, [&](size_t) { found += sharded.aggregates().employee_count; });
+        measure(os, "resize to " + std::to_string(SHARDS + 1) + " shards", 1, [&](size_t) {
+            found += sharded.resize(SHARDS + 1).moved;
+        });
+        if (found == 0) os << "  (unexpected result: nothing found in shards)\n";
+    }
 
-        std::cout << "SEARCH FEATURES:\n";
-        std::cout << "  • Basic search by exact Employee ID\n";
-        std::cout << "  • Advanced search with multiple criteria\n";
-        std::cout << "  • Partial matching for names and positions\n";
-        std::cout << "  • Salary range filtering\n";
-        std::cout << "  • Department and status filtering\n";
-        std::cout << "  • Skill-based search\n";
-        std::cout << "  • Case-sensitive/insensitive options\n\n";
+    // From opening the data file to answering one ID lookup, after a full load
+    // and after a lazy open. Lazily opened tables finish loading untimed, so the
+    // throughput column is over the timed part only. Returns the lookups found.
+    static size_t run_lazy_open(std::ostream& os, const EmployeeHashTable& table, const std::vector<std::string>& ids) {
+        remove_bench_files();
+        DataManager(BENCH_FILE).save(table);
+        size_t found = 0;
+        for (bool lazy : {false, true}) {
+            LatencySamples samples;
+            double timed = 0;
+            auto start = Clock::now();
+            for (size_t run = 0; run < MAX_REPEATS && (run < 3 || seconds_since(start) < REPORT_BUDGET_SECONDS); ++run) {
+                EmployeeHashTable opened(17, table.backend());
+                DataManager manager(BENCH_FILE);
+                auto began = Clock::now();
+                samples.time([&] {
+                    if (lazy) {
+                        manager.open_lazy(opened, LAZY_CACHE_BYTES);
+                    } else {
+                        manager.open(opened);
+                    }
+                    found += manager.lookup(opened, ids[run % ids.size()]) != nullptr;
+                });
+                timed += seconds_since(began);
+                manager.await_hydration();
+            }
+            samples.write_row(os, lazy ? "open + first lookup (lazy)" : "open + first lookup (full load)", timed);
+        }
+        remove_bench_files();
+        return found;
+    }
 
-        std::cout << "REPORTS AVAILABLE:\n";
-        std::cout << "  • Department Summary: Employee count and salary analysis\n";
-        std::cout << "  • Salary Statistics: Statistical analysis of compensation\n";
-        std::cout << "  • Status Report: Active/inactive employee breakdown\n";
-        std::cout << "  • Skill Analysis: Most common skills across organization\n";
-        std::cout << "  • Management Hierarchy: Organizational structure\n\n";
+    static void run_csv(std::ostream& os, const EmployeeHashTable& table) {
+        DataManager manager(BENCH_FILE);
+        measure_for(os, "export_csv", REPORT_BUDGET_SECONDS, [&](size_t) { manager.export_csv(table, BENCH_CSV); });
+        measure_for(os, "import_csv", REPORT_BUDGET_SECONDS, [&](size_t) {
+            EmployeeHashTable imported(17, table.backend());
+            DataManager::CsvImportResult result;
+            manager.import_csv(imported, BENCH_CSV, result);
+        });
+        remove_bench_files();
+    }
 
-        std::cout << "DATA MANAGEMENT:\n";
-        std::cout << "  • Automatic saving on exit\n";
-        std::cout << "  • Manual backup creation with timestamps\n";
-        std::cout << "  • CSV export functionality\n";
-        std::cout << "  • Data validation tools\n";
-        std::cout << "  • System performance optimization\n";
-        std::cout << "  • Added move constructor and move assignment operator for thread-safety and efficiency\n\n";
+    // A first backup into an empty chunk store, then repeats that find every chunk
+    // already stored, then restores
+    static void run_backup(std::ostream& os, const EmployeeHashTable& table) {
+        remove_bench_files();
+        std::filesystem::create_directory(BENCH_BACKUP_DIR);
+        std::string archive = std::string(BENCH_BACKUP_DIR) + "/backup.dat";
+        DataManager manager(BENCH_FILE);
+        BackupArchive::Stats first, repeat;
+        measure(os, "backup (empty chunk store)", 1, [&](size_t) { manager.backup(table, archive, first); });
+        measure_for(os, "backup (unchanged)", REPORT_BUDGET_SECONDS, [&](size_t) {
+            manager.backup(table, archive, repeat);
+        });
+        measure_for(os, "restore backup", REPORT_BUDGET_SECONDS, [&](size_t) {
+            EmployeeHashTable restored(17, table.backend());
+            manager.restore(restored, archive);
+        });
+        os << "  backup bytes: " << first.raw_bytes << " serialized, " << first.stored_bytes + first.archive_bytes
+           << " written first, " << repeat.stored_bytes + repeat.archive_bytes << " written unchanged\n";
+        remove_bench_files();
+    }
 
-        std::cout << "SYSTEM FEATURES:\n";
-        std::cout << "  • High-performance hash table with automatic resizing\n";
-        std::cout << "  • Thread-safe operations\n";
-        std::cout << "  • Comprehensive error handling and logging\n";
-        std::cout << "  • Input validation and sanitization\n";
-        std::cout << "  • Memory-efficient design\n";
-        std::cout << "  • Production-ready reliability\n\n";
+    // Each thread does 90% snapshot lookups, 8% updates and 2% inserts of new IDs
+    // for the given time; inserted records are removed again afterwards
+    static void run_mixed(std::ostream& os, EmployeeHashTable& table, size_t n, size_t threads, double seconds) {
+        constexpr size_t INSERT_SLICE = (WorkloadGenerator::ID_SPACE - WorkloadGenerator::MAX_RECORDS) / 64;
+        threads = std::min<size_t>(threads, 64);
+        std::vector<LatencySamples> reads(threads);
+        std::vector<LatencySamples> writes(threads);
+        std::vector<std::vector<std::string>> inserted(threads);
+        std::atomic<bool> stop{false};
+
+        auto worker = [&](size_t t) {
+            std::mt19937_64 rng(1000 + t);
+            size_t next_insert = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                unsigned roll = static_cast<unsigned>(rng() % 100);
+                std::string id = WorkloadGenerator::synthetic_id(rng() % n);
+                if (roll < 90) {
+                    reads[t].time([&] { (void)table.snapshot(id); });
+                } else if (roll < 98) {
+                    writes[t].time([&] {
+                        if (auto current = table.snapshot(id)) {
+                            Employee changed = *current;
+                            changed.salary = current->salary + 1;
+                            table.update(id, changed);
+                        }
+                    });
+                } else if (auto source = table.snapshot(id)) {
+                    Employee emp = *source;
+                    emp.id = WorkloadGenerator::missing_id(t * INSERT_SLICE + next_insert++ % INSERT_SLICE);
+                    emp.managerId = "";
+                    writes[t].time([&] { table.insert(emp); });
+                    inserted[t].push_back(emp.id);
+                }
+            }
+        };
+
+        auto start = Clock::now();
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        stop.store(true);
+        for (auto& thread : pool) thread.join();
+        double wall = seconds_since(start);
+
+        for (size_t t = 1; t < threads; ++t) {
+            reads[0].merge(reads[t]);
+            writes[0].merge(writes[t]);
+        }
+        std::string label = "mixed " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+        reads[0].write_row(os, label + ": reads", wall);
+        writes[0].write_row(os, label + ": writes", wall);
 
-        std::cout << "KEYBOARD SHORTCUTS:\n";
-        std::cout << "  • Enter: Continue/Confirm\n";
-        std::cout << "  • Type 'y' or 'yes': Confirm actions\n";
-        std::cout << "  • Type 'n' or 'no': Cancel actions\n";
-        std::cout << "  • Empty input: Keep current value (during updates)\n\n";
+        for (const auto& ids : inserted) {
+            for (const auto& id : ids) table.remove(id);
+        }
+    }
+};
 
-        std::cout << "TROUBLESHOOTING:\n";
-        std::cout << "  • Check employee_system.log for detailed error messages\n";
-        std::cout << "  • Use Data Validation to find problematic records\n";
-        std::cout << "  • Create backups before major operations\n";
-        std::cout << "  • Contact system administrator for persistent issues\n";
+// ==================== MAIN APPLICATION ====================
 
-        pause();
+struct CommandLineOptions {
+    StorageBackend backend = StorageBackend::CHAINED;
+    bool run_benchmark = false;
+    size_t benchmark_records = 200000;
+    size_t benchmark_threads = 0;
+    double benchmark_seconds = 2.0;
+    std::string metrics_file;
+    bool serve_stdin = false;
+    std::string listen_address;  // "port" or "IPv4:port"
+    bool allow_remote = false;   // Required to listen on a non-loopback host
+    size_t server_threads = 0;   // 0 means one per hardware thread
+    std::chrono::seconds autosave{0};  // Background checkpoint period; 0 is off
+    bool lazy_load = false;            // Interactive CLI only; headless modes load in full
+    size_t lazy_cache_mb = 64;
+    Logger::Mode log_mode = Logger::ASYNCHRONOUS;
+    Logger::Level log_level = Logger::DEBUG;
+
+    bool headless() const { return serve_stdin || !listen_address.empty(); }
+
+    static Logger::Level parse_level(const std::string& name) {
+        const char* names[] = {"debug", "info", "warn", "error", "critical"};
+        for (int i = 0; i < 5; ++i) {
+            if (name == names[i]) return static_cast<Logger::Level>(i);
+        }
+        throw EmployeeException("Unknown log level: " + name);
+    }
+
+    static CommandLineOptions parse(int argc, char* argv[]) {
+        CommandLineOptions options;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--backend=chained") {
+                options.backend = StorageBackend::CHAINED;
+            } else if (arg == "--backend=flat") {
+                options.backend = StorageBackend::OPEN_ADDRESSING;
+            } else if (arg == "--sync-log") {
+                options.log_mode = Logger::SYNCHRONOUS;
+            } else if (arg.rfind("--log-level=", 0) == 0) {
+                options.log_level = parse_level(arg.substr(12));
+            } else if (arg == "--benchmark") {
+                options.run_benchmark = true;
+                if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    options.benchmark_records = std::stoul(argv[++i]);
+                }
+            } else if (arg.rfind("--bench-threads=", 0) == 0) {
+                options.benchmark_threads = std::stoul(arg.substr(16));
+            } else if (arg.rfind("--bench-seconds=", 0) == 0) {
+                options.benchmark_seconds = std::stod(arg.substr(16));
+            } else if (arg.rfind("--metrics-file=", 0) == 0) {
+                options.metrics_file = arg.substr(15);
+            } else if (arg == "--serve") {
+                options.serve_stdin = true;
+            } else if (arg.rfind("--listen=", 0) == 0) {
+                options.listen_address = arg.substr(9);
+            } else if (arg == "--allow-remote") {
+                options.allow_remote = true;
+            } else if (arg.rfind("--server-threads=", 0) == 0) {
+                options.server_threads = std::stoul(arg.substr(17));
+            } else if (arg.rfind("--autosave=", 0) == 0) {
+                options.autosave = std::chrono::seconds(std::stoul(arg.substr(11)));
+            } else if (arg == "--lazy-load") {
+                options.lazy_load = true;
+            } else if (arg.rfind("--lazy-cache-mb=", 0) == 0) {
+                options.lazy_cache_mb = std::stoul(arg.substr(16));
+            } else {
+                throw EmployeeException("Unknown option: " + arg +
+                    " (expected --backend=chained|flat, --sync-log, --log-level=LEVEL,"
+                    " --benchmark [records], --bench-threads=N, --bench-seconds=S,"
+                    " --metrics-file=PATH, --serve, --listen=[HOST:]PORT, --allow-remote, --server-threads=N,"
+                    " --autosave=SECONDS, --lazy-load or --lazy-cache-mb=N)");
+            }
+        }
+#ifdef _WIN32
+        if (options.headless()) throw EmployeeException("--serve and --listen need a POSIX system");
+#endif
+        return options;
     }
 };
 
-// ==================== MAIN APPLICATION ====================
+// Dumps the process metrics on exit: JSON for *.json paths, otherwise the
+// Prometheus text format so the file can feed a node_exporter textfile collector
+void write_metrics_file(const std::string& path) {
+    if (path.empty()) return;
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write metrics to " << path << std::endl;
+        return;
+    }
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    if (json) {
+        Metrics::write_json(file);
+    } else {
+        Metrics::write_prometheus(file);
+    }
+}
+
+#ifndef _WIN32
+// No menu: the data file is opened as the CLI would, then served over the line
+// protocol until input ends (--serve) or a stop signal (--listen)
+void run_headless(const CommandLineOptions& options, EmployeeHashTable& employee_db) {
+    DataManager data_manager;
+    if (!data_manager.open(employee_db)) throw EmployeeException("Cannot open the data files; see the log for details");
+    data_manager.set_autosave(options.autosave);
+    create_default_admin(employee_db);
+    {
+        ProtocolServer server(employee_db, options.server_threads);
+        if (options.serve_stdin) {
+            server.serve_stream(STDIN_FILENO, STDOUT_FILENO);
+        } else {
+            server.listen(options.listen_address, options.allow_remote);
+        }
+    }
+    data_manager.sync(employee_db);
+}
+#endif
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        CommandLineOptions options = CommandLineOptions::parse(argc, argv);
+
+        if (options.run_benchmark) {
+            // No log file is opened, but messages above the level are still built
+            Logger::set_level(options.log_level);
+            StorageBenchmark::run(options.benchmark_records, std::cout);
+            SearchBenchmark::run(options.benchmark_records, std::cout);
+
+            TableBenchmark::Options table_options;
+            table_options.records = options.benchmark_records;
+            table_options.backend = options.backend;
+            table_options.threads = options.benchmark_threads;
+            table_options.mixed_seconds = options.benchmark_seconds;
+            TableBenchmark::run(table_options, std::cout);
+            write_metrics_file(options.metrics_file);
+            return 0;
+        }
+
         // Initialize logger
-        Logger::init();
+        Logger::set_level(options.log_level);
+        Logger::init("employee_system.log", options.log_mode);
         Logger::log(Logger::INFO, "Employee Management System starting");
 
         // Create database with optimal initial size
-        EmployeeHashTable employee_db(101);  // Prime number for better distribution
-
-        // On first run, create a default admin user if the database is empty
-        if (employee_db.size() == 0) {
-            try {
-                Employee admin("XX0069", "System", "Admin", "Chief Executive Officer",
-                                Department::ENGINEERING, 9999999.99, "admin@example.com",
-                                "+1234567890", AccessLevel::ADMIN);
-                employee_db.insert(admin);
-                Logger::log(Logger::INFO, "Created default admin user XX0069");
-            } catch (const EmployeeException& e) {
-                Logger::log(Logger::CRITICAL, "Failed to create default admin user: " + std::string(e.what()));
-            }
+        EmployeeHashTable employee_db(128, options.backend);
+
+#ifndef _WIN32
+        if (options.headless()) {
+            run_headless(options, employee_db);
+            write_metrics_file(options.metrics_file);
+            Logger::log(Logger::INFO, "Employee Management System shutting down normally");
+            Logger::shutdown();
+            return 0;
         }
+#endif
 
         // Launch CLI interface
-        AdvancedCLI cli(employee_db);
+        std::optional<size_t> lazy_cache_bytes;
+        if (options.lazy_load) lazy_cache_bytes = options.lazy_cache_mb << 20;
+        AdvancedCLI cli(employee_db, options.autosave, lazy_cache_bytes);
         cli.run();
+        write_metrics_file(options.metrics_file);
 
         Logger::log(Logger::INFO, "Employee Management System shutting down normally");
 
@@ -1877,5 +10368,6 @@ int main() {
         return 1;
     }
 
+    Logger::shutdown();
     return 0;
 }
\ No newline at end of file